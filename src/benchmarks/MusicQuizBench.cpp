@@ -0,0 +1,310 @@
+#include <new>
+#include <atomic>
+#include <chrono>
+#include <string>
+#include <vector>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <stdexcept>
+#include <functional>
+
+#include <QApplication>
+
+#include <boost/filesystem.hpp>
+
+#if defined(_WIN32) || defined(WIN32)
+#include <windows.h>
+#include <psapi.h>
+#else
+#include <sys/resource.h>
+#endif
+
+#include "util/QuizLoader.hpp"
+#include "util/QuizCatalog.hpp"
+#include "util/QuizSettings.hpp"
+#include "media/AudioPlayer.hpp"
+#include "media/VideoPlayer.hpp"
+#include "gui_tools/widgets/QuizBoard.hpp"
+#include "gui_tools/widgets/QuizFactory.hpp"
+#include "gui_tools/widgets/QuizCategory.hpp"
+#include "benchmarks/QuizGenerator.hpp"
+
+
+/** Number of allocations made through operator new */
+static std::atomic<size_t> allocationCount(0);
+
+void* operator new(std::size_t size)
+{
+	++allocationCount;
+	void* ptr = std::malloc(size == 0 ? 1 : size);
+	if ( ptr == nullptr ) {
+		throw std::bad_alloc();
+	}
+	return ptr;
+}
+
+void* operator new[](std::size_t size)
+{
+	return operator new(size);
+}
+
+void operator delete(void* ptr) noexcept
+{
+	std::free(ptr);
+}
+
+void operator delete[](void* ptr) noexcept
+{
+	std::free(ptr);
+}
+
+void operator delete(void* ptr, std::size_t) noexcept
+{
+	std::free(ptr);
+}
+
+void operator delete[](void* ptr, std::size_t) noexcept
+{
+	std::free(ptr);
+}
+
+
+namespace {
+	struct Result
+	{
+		std::string name = "";
+		size_t parameter = 0;
+		size_t iterations = 0;
+		double timeUs = 0.0;
+		double allocations = 0.0;
+		size_t peakRssKb = 0;
+	};
+
+	/**
+	 * @brief Returns the peak resident set size of the process.
+	 *
+	 * @return The peak RSS in KB.
+	 */
+	size_t getPeakRssKb()
+	{
+#if defined(_WIN32) || defined(WIN32)
+		PROCESS_MEMORY_COUNTERS counters;
+		if ( GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters)) ) {
+			return static_cast<size_t>(counters.PeakWorkingSetSize / 1024);
+		}
+		return 0;
+#else
+		struct rusage usage;
+		if ( getrusage(RUSAGE_SELF, &usage) != 0 ) {
+			return 0;
+		}
+#if defined(__APPLE__)
+		return static_cast<size_t>(usage.ru_maxrss / 1024);
+#else
+		return static_cast<size_t>(usage.ru_maxrss);
+#endif
+#endif
+	}
+
+	/**
+	 * @brief Runs a benchmark and prints the result.
+	 *
+	 * @param[in] name The name of the benchmark.
+	 * @param[in] parameter The library or board size.
+	 * @param[in] iterations The number of times the function is run.
+	 * @param[in] function The function to measure.
+	 *
+	 * @return The result, with the time and allocations per iteration.
+	 */
+	Result measure(const std::string& name, const size_t parameter, const size_t iterations, const std::function<void()>& function)
+	{
+		const size_t allocationsBefore = allocationCount;
+		const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+		for ( size_t i = 0; i < iterations; ++i ) {
+			function();
+		}
+		const std::chrono::steady_clock::time_point end = std::chrono::steady_clock::now();
+
+		Result result;
+		result.name = name;
+		result.parameter = parameter;
+		result.iterations = iterations;
+		result.timeUs = std::chrono::duration<double, std::micro>(end - start).count() / static_cast<double>(iterations);
+		result.allocations = static_cast<double>(allocationCount - allocationsBefore) / static_cast<double>(iterations);
+		result.peakRssKb = getPeakRssKb();
+
+		std::cerr << name << " [" << parameter << "]: " << result.timeUs << " us, " << result.allocations << " allocations, " << result.peakRssKb << " KB peak RSS" << std::endl;
+		return result;
+	}
+
+	/**
+	 * @brief Writes the results as JSON.
+	 *
+	 * @param[in] out The stream to write to.
+	 * @param[in] results The results.
+	 */
+	void writeJson(std::ostream& out, const std::vector<Result>& results)
+	{
+		out << "{\n\t\"benchmark\": \"MusicQuizBench\",\n\t\"results\": [";
+		for ( size_t i = 0; i < results.size(); ++i ) {
+			const Result& result = results[i];
+			out << (i == 0 ? "\n" : ",\n");
+			out << "\t\t{ \"name\": \"" << result.name << "\", \"parameter\": " << result.parameter << ", \"iterations\": " << result.iterations
+				<< ", \"timeUs\": " << result.timeUs << ", \"allocations\": " << result.allocations << ", \"peakRssKb\": " << result.peakRssKb << " }";
+		}
+		out << "\n\t]\n}\n";
+	}
+
+	/**
+	 * @brief Benchmarks listing a quiz library and reading the quiz previews.
+	 *
+	 * @param[in] numberOfQuizzes The number of quizzes in the library.
+	 * @param[out] results The results.
+	 */
+	void benchmarkLibrary(const size_t numberOfQuizzes, std::vector<Result>& results)
+	{
+		const std::string dataFolder = "library_" + std::to_string(numberOfQuizzes) + "/data";
+		MusicQuiz::benchmarks::QuizGenerator::Options options;
+		options.mediaFiles = MusicQuiz::benchmarks::QuizGenerator::MediaFiles::SHARED;
+		MusicQuiz::benchmarks::QuizGenerator::writeLibrary(dataFolder, numberOfQuizzes, options);
+
+		/** Scan the library without an index */
+		const MusicQuiz::util::QuizCatalog::Ptr catalog = std::make_shared<MusicQuiz::util::QuizCatalog>(dataFolder + "/", dataFolder + "/.quizcatalog");
+		results.push_back(measure("refreshCatalog", numberOfQuizzes, 1, [&catalog]() {
+			catalog->refresh();
+		}));
+		MusicQuiz::util::QuizLoader::setCatalog(catalog);
+
+		/** List Quizzes */
+		std::vector<std::string> quizList;
+		results.push_back(measure("getListOfQuizzes", numberOfQuizzes, 10, [&quizList]() {
+			quizList = MusicQuiz::util::QuizLoader::getListOfQuizzes();
+		}));
+
+		/** Previews, first read from the files and then from the catalog */
+		const std::function<void()> readPreviews = [&quizList]() {
+			for ( size_t i = 0; i < quizList.size(); ++i ) {
+				MusicQuiz::util::QuizLoader::getQuizPreview(MusicQuiz::util::QuizCatalog::getQuizId(quizList[i]));
+			}
+		};
+		results.push_back(measure("getQuizPreview/cold", numberOfQuizzes, 1, readPreviews));
+		results.push_back(measure("getQuizPreview/warm", numberOfQuizzes, 10, readPreviews));
+
+		MusicQuiz::util::QuizLoader::setCatalog(nullptr);
+	}
+
+	/**
+	 * @brief Benchmarks loading a quiz board.
+	 *
+	 * @param[in] numberOfEntries The number of entries on the board.
+	 * @param[in] iterations The number of iterations.
+	 * @param[out] results The results.
+	 */
+	void benchmarkBoard(const size_t numberOfEntries, const size_t iterations, std::vector<Result>& results)
+	{
+		const std::string dataFolder = "board_" + std::to_string(numberOfEntries) + "/data";
+		MusicQuiz::benchmarks::QuizGenerator::Options options;
+		options.numberOfEntries = numberOfEntries / options.numberOfCategories;
+		MusicQuiz::benchmarks::QuizGenerator::writeLibrary(dataFolder, 1, options);
+
+		const MusicQuiz::util::QuizCatalog::Ptr catalog = std::make_shared<MusicQuiz::util::QuizCatalog>(dataFolder + "/", dataFolder + "/.quizcatalog");
+		catalog->refresh();
+		MusicQuiz::util::QuizLoader::setCatalog(catalog);
+		const MusicQuiz::util::QuizId quizId = MusicQuiz::util::QuizCatalog::getQuizId(catalog->getQuizList().front());
+
+		const media::AudioPlayer::Ptr audioPlayer = std::make_shared<media::AudioPlayer>();
+		const media::VideoPlayer::Ptr videoPlayer = std::make_shared<media::VideoPlayer>();
+
+		/** Model */
+		results.push_back(measure("loadQuizDocument/cold", numberOfEntries, 1, [quizId]() {
+			MusicQuiz::util::QuizLoader::loadQuizDocument(quizId);
+		}));
+
+		MusicQuiz::util::QuizModel::CPtr model = nullptr;
+		results.push_back(measure("loadQuizModel", numberOfEntries, iterations, [quizId, &model]() {
+			model = MusicQuiz::util::QuizLoader::loadQuizModel(quizId);
+		}));
+
+		/** Widgets */
+		results.push_back(measure("loadQuizCategories", numberOfEntries, iterations, [&model, &audioPlayer, &videoPlayer]() {
+			const std::vector<MusicQuiz::QuizCategory*> categories = MusicQuiz::util::QuizLoader::loadQuizCategories(model, audioPlayer, videoPlayer);
+			for ( size_t i = 0; i < categories.size(); ++i ) {
+				delete categories[i];
+			}
+		}));
+
+		results.push_back(measure("loadQuizRowCategories", numberOfEntries, iterations, [&model]() {
+			MusicQuiz::util::QuizLoader::loadQuizRowCategories(model);
+		}));
+
+		results.push_back(measure("QuizFactory::createQuiz", numberOfEntries, iterations, [quizId, &audioPlayer, &videoPlayer]() {
+			delete MusicQuiz::QuizFactory::createQuiz(quizId, MusicQuiz::QuizSettings(), audioPlayer, videoPlayer);
+		}));
+
+		MusicQuiz::util::QuizLoader::setCatalog(nullptr);
+	}
+}
+
+int main(int argc, char* argv[])
+{
+	/** Arguments */
+	std::string outputFile = "";
+	bool quick = false;
+	for ( int i = 1; i < argc; ++i ) {
+		const std::string arg = argv[i];
+		if ( arg == "--quick" ) {
+			quick = true;
+		} else if ( arg == "--output" && i + 1 < argc ) {
+			outputFile = argv[++i];
+		} else {
+			std::cerr << "Usage: " << argv[0] << " [--quick] [--output results.json]" << std::endl;
+			return 1;
+		}
+	}
+
+	/** Run headless unless a platform is requested */
+	if ( qEnvironmentVariableIsEmpty("QT_QPA_PLATFORM") ) {
+		qputenv("QT_QPA_PLATFORM", "offscreen");
+	}
+	QApplication app(argc, argv);
+
+	/** Work in a temporary folder, the media paths in the quizzes are relative to it */
+	const boost::filesystem::path initialPath = boost::filesystem::current_path();
+	const boost::filesystem::path workPath = boost::filesystem::temp_directory_path() / boost::filesystem::unique_path("MusicQuizBench_%%%%%%%%");
+	boost::filesystem::create_directories(workPath);
+	boost::filesystem::current_path(workPath);
+
+	/** Sizes */
+	const std::vector<size_t> librarySizes = quick ? std::vector<size_t>{ 10, 100 } : std::vector<size_t>{ 10, 1000, 10000 };
+	const std::vector<size_t> boardSizes = quick ? std::vector<size_t>{ 25, 500 } : std::vector<size_t>{ 25, 500, 5000 };
+
+	std::vector<Result> results;
+	int status = 0;
+	try {
+		for ( size_t i = 0; i < librarySizes.size(); ++i ) {
+			benchmarkLibrary(librarySizes[i], results);
+		}
+		for ( size_t i = 0; i < boardSizes.size(); ++i ) {
+			benchmarkBoard(boardSizes[i], boardSizes[i] >= 5000 ? 3 : 10, results);
+		}
+	} catch ( const std::exception& err ) {
+		std::cerr << "Benchmark failed. " << err.what() << std::endl;
+		status = 1;
+	}
+
+	/** Clean Up */
+	boost::filesystem::current_path(initialPath);
+	boost::system::error_code err;
+	boost::filesystem::remove_all(workPath, err);
+
+	/** Results */
+	if ( outputFile.empty() ) {
+		writeJson(std::cout, results);
+	} else {
+		std::ofstream out(outputFile);
+		writeJson(out, results);
+	}
+
+	return status;
+}
\ No newline at end of file
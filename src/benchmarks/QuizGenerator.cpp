@@ -0,0 +1,183 @@
+#include "QuizGenerator.hpp"
+
+#include <vector>
+#include <fstream>
+#include <stdexcept>
+#include <algorithm>
+
+#include <boost/filesystem.hpp>
+
+
+namespace {
+	/** Names of the shared placeholder media files */
+	const std::string SHARED_SONG_FILE = "song.mp3";
+	const std::string SHARED_VIDEO_FILE = "video.mp4";
+
+	/**
+	 * @brief Creates a placeholder media file if it does not exist.
+	 *
+	 * @param[in] path The path of the file.
+	 * @param[in] size The size of the file.
+	 */
+	void createMediaFile(const std::string& path, const std::uintmax_t size)
+	{
+		if ( boost::filesystem::exists(path) ) {
+			return;
+		}
+
+		{
+			std::ofstream file(path, std::ios::binary);
+			if ( !file.is_open() ) {
+				throw std::runtime_error("Failed to create media file '" + path + "'.");
+			}
+		}
+
+		/** Growing an empty file leaves a hole instead of writing the data */
+		if ( size > 0 ) {
+			boost::filesystem::resize_file(path, size);
+		}
+	}
+}
+
+
+std::string MusicQuiz::benchmarks::QuizGenerator::writeQuiz(const std::string& quizFolder, const std::string& quizName, const Options& options)
+{
+	boost::filesystem::create_directories(quizFolder);
+	const std::string quizFile = quizFolder + "/" + quizName + ".quiz.xml";
+	std::ofstream file(quizFile, std::ios::binary | std::ios::trunc);
+	if ( !file.is_open() ) {
+		throw std::runtime_error("Failed to write quiz '" + quizFile + "'.");
+	}
+
+	/** Names */
+	const size_t numberOfRowCategories = options.numberOfRowCategories == SIZE_MAX ? options.numberOfEntries : options.numberOfRowCategories;
+	std::vector<std::string> categoryNames, rowCategoryNames;
+	for ( size_t i = 0; i < options.numberOfCategories; ++i ) {
+		categoryNames.push_back(padName("Category " + std::to_string(i), options.nameLength));
+	}
+	for ( size_t i = 0; i < numberOfRowCategories; ++i ) {
+		rowCategoryNames.push_back(padName("Row " + std::to_string(i), options.nameLength));
+	}
+
+	/** Count Media */
+	const size_t numberOfEntries = options.numberOfCategories * options.numberOfEntries;
+	size_t numberOfVideos = 0;
+	for ( size_t i = 0; i < numberOfEntries; ++i ) {
+		numberOfVideos += isVideo(i, options.videoPercentage) ? 1 : 0;
+	}
+
+	/** Quiz */
+	file << "<?xml version=\"1.0\" encoding=\"utf-8\"?>\n<MusicQuiz>\n";
+	file << "\t<!--File content generated by the quiz generator-->\n";
+	file << "\t<QuizName>" << quizName << "</QuizName>\n\t<QuizAuthor>Quiz Generator</QuizAuthor>\n";
+	file << "\t<QuizDescription>Synthetic quiz with " << numberOfEntries << " entries.</QuizDescription>\n";
+	file << "\t<QuizGuessTheCategory enabled=\"false\">500</QuizGuessTheCategory>\n";
+
+	/** Summary */
+	if ( options.writeSummary ) {
+		file << "\t<QuizSummary songs=\"" << numberOfEntries - numberOfVideos << "\" videos=\"" << numberOfVideos << "\">\n";
+		for ( size_t i = 0; i < categoryNames.size(); ++i ) {
+			file << "\t\t<Category name=\"" << categoryNames[i] << "\" entries=\"" << options.numberOfEntries << "\"/>\n";
+		}
+		for ( size_t i = 0; i < rowCategoryNames.size(); ++i ) {
+			file << "\t\t<RowCategory>" << rowCategoryNames[i] << "</RowCategory>\n";
+		}
+		file << "\t</QuizSummary>\n";
+	}
+
+	/** Categories */
+	const std::string mediaFolder = quizFolder + "/media";
+	file << "\t<QuizCategories>\n";
+	for ( size_t i = 0; i < categoryNames.size(); ++i ) {
+		const std::string categoryFolder = mediaFolder + "/" + categoryNames[i];
+		if ( options.mediaFiles == MediaFiles::PER_ENTRY ) {
+			boost::filesystem::create_directories(categoryFolder);
+		}
+
+		file << "\t\t<Category name=\"" << categoryNames[i] << "\">\n";
+		for ( size_t j = 0; j < options.numberOfEntries; ++j ) {
+			const std::string entryName = padName("Artist " + std::to_string(i) + " - Song Title " + std::to_string(j), options.nameLength);
+			const bool video = isVideo(i * options.numberOfEntries + j, options.videoPercentage);
+
+			/** Media Files */
+			std::string songFile = mediaFolder + "/" + SHARED_SONG_FILE;
+			std::string videoFile = mediaFolder + "/" + SHARED_VIDEO_FILE;
+			if ( options.mediaFiles == MediaFiles::PER_ENTRY ) {
+				songFile = categoryFolder + "/" + entryName + (video ? "_song.mp3" : ".mp3");
+				videoFile = categoryFolder + "/" + entryName + "_video.mp4";
+			}
+
+			/** Entry */
+			file << "\t\t\t<QuizEntry name=\"" << entryName << "\" type=\"" << (video ? "video" : "song") << "\">\n";
+			file << "\t\t\t\t<Answer>" << entryName << "</Answer>\n";
+			file << "\t\t\t\t<Points>" << (j + 1) * 100 << "</Points>\n";
+			file << "\t\t\t\t<StartTime>" << j * 1000 << "</StartTime>\n";
+			if ( video ) {
+				file << "\t\t\t\t<VideoSongStartTime>0</VideoSongStartTime>\n";
+			}
+			file << "\t\t\t\t<AnswerStartTime>" << j * 2000 << "</AnswerStartTime>\n";
+			file << "\t\t\t\t<Media>\n";
+			if ( video ) {
+				file << "\t\t\t\t\t<VideoFile>" << videoFile << "</VideoFile>\n";
+			}
+			file << "\t\t\t\t\t<SongFile>" << songFile << "</SongFile>\n";
+			file << "\t\t\t\t</Media>\n\t\t\t</QuizEntry>\n";
+
+			if ( options.mediaFiles == MediaFiles::PER_ENTRY ) {
+				createMediaFile(songFile, options.songFileSize);
+				if ( video ) {
+					createMediaFile(videoFile, options.videoFileSize);
+				}
+			}
+		}
+		file << "\t\t</Category>\n";
+	}
+	file << "\t</QuizCategories>\n";
+
+	/** Row Categories */
+	file << "\t<QuizRowCategories>\n";
+	for ( size_t i = 0; i < rowCategoryNames.size(); ++i ) {
+		file << "\t\t<RowCategory>" << rowCategoryNames[i] << "</RowCategory>\n";
+	}
+	file << "\t</QuizRowCategories>\n</MusicQuiz>\n";
+
+	file.flush();
+	if ( !file ) {
+		throw std::runtime_error("Failed to write quiz '" + quizFile + "'.");
+	}
+
+	/** Shared Media */
+	if ( options.mediaFiles == MediaFiles::SHARED ) {
+		boost::filesystem::create_directories(mediaFolder);
+		createMediaFile(mediaFolder + "/" + SHARED_SONG_FILE, options.songFileSize);
+		createMediaFile(mediaFolder + "/" + SHARED_VIDEO_FILE, options.videoFileSize);
+	}
+
+	return quizFile;
+}
+
+void MusicQuiz::benchmarks::QuizGenerator::writeLibrary(const std::string& dataFolder, const size_t numberOfQuizzes, const Options& options)
+{
+	for ( size_t i = 0; i < numberOfQuizzes; ++i ) {
+		const std::string quizName = "Quiz_" + std::to_string(i);
+		writeQuiz(dataFolder + "/" + quizName, quizName, options);
+	}
+}
+
+bool MusicQuiz::benchmarks::QuizGenerator::isVideo(const size_t entryIdx, const size_t videoPercentage)
+{
+	const size_t percentage = std::min(videoPercentage, static_cast<size_t>(100));
+	return (entryIdx + 1) * percentage / 100 > entryIdx * percentage / 100;
+}
+
+std::string MusicQuiz::benchmarks::QuizGenerator::padName(const std::string& name, const size_t length)
+{
+	std::string padded = name;
+	if ( padded.size() < length ) {
+		padded += ' ';
+	}
+	for ( size_t i = 0; padded.size() < length; ++i ) {
+		padded += static_cast<char>('a' + i % 26);
+	}
+	return padded;
+}
\ No newline at end of file
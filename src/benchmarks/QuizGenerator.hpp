@@ -0,0 +1,99 @@
+#pragma once
+
+#include <string>
+#include <cstdint>
+
+
+namespace MusicQuiz {
+	namespace benchmarks {
+		/**
+		 * @brief Writes synthetic quizzes and quiz libraries for benchmarks and scale tests.
+		 *
+		 * The quizzes follow the layout QuizFactory::saveQuiz writes: a folder per quiz holding the quiz file
+		 * and a media folder with a sub folder per category. The media files are placeholders.
+		 */
+		class QuizGenerator
+		{
+		public:
+			enum class MediaFiles
+			{
+				NONE, SHARED, PER_ENTRY
+			};
+
+			struct Options
+			{
+				size_t numberOfCategories = 5;
+				size_t numberOfEntries = 5;
+
+				/** Number of row categories, the number of entries per category if not set */
+				size_t numberOfRowCategories = SIZE_MAX;
+
+				/** Percentage of the entries that are videos */
+				size_t videoPercentage = 25;
+
+				/** Minimum length of the category and entry names */
+				size_t nameLength = 0;
+
+				/** Write the summary block the quiz creator writes */
+				bool writeSummary = true;
+
+				/**
+				 * NONE: The media files are not created.
+				 * SHARED: All entries of a quiz refer to the same song and video file.
+				 * PER_ENTRY: Each entry has its own media files, named the way the quiz creator names them.
+				 */
+				MediaFiles mediaFiles = MediaFiles::PER_ENTRY;
+
+				/** Size of the placeholder media files. The files are sparse where the filesystem supports it */
+				std::uintmax_t songFileSize = 0;
+				std::uintmax_t videoFileSize = 0;
+			};
+
+			/**
+			 * @brief Deleted constructor and destructor.
+			 */
+			QuizGenerator() = delete;
+			~QuizGenerator() = delete;
+
+			/**
+			 * @brief Writes a quiz and its media files.
+			 *
+			 * @param[in] quizFolder The folder of the quiz, relative to the working directory. Media paths in the quiz start with it.
+			 * @param[in] quizName The name of the quiz.
+			 * @param[in] options The quiz layout.
+			 *
+			 * @return The path of the quiz file.
+			 */
+			static std::string writeQuiz(const std::string& quizFolder, const std::string& quizName, const Options& options);
+
+			/**
+			 * @brief Writes a quiz library laid out like the data folder.
+			 *
+			 * @param[in] dataFolder The data folder, relative to the working directory.
+			 * @param[in] numberOfQuizzes The number of quizzes.
+			 * @param[in] options The layout of each quiz.
+			 */
+			static void writeLibrary(const std::string& dataFolder, size_t numberOfQuizzes, const Options& options);
+
+			/**
+			 * @brief Checks if an entry is a video. The videos are spread evenly over the quiz.
+			 *
+			 * @param[in] entryIdx The index of the entry in the quiz.
+			 * @param[in] videoPercentage The percentage of the entries that are videos.
+			 *
+			 * @return True if the entry is a video.
+			 */
+			static bool isVideo(size_t entryIdx, size_t videoPercentage);
+
+			/**
+			 * @brief Pads a name to a minimum length.
+			 *
+			 * @param[in] name The name.
+			 * @param[in] length The minimum length.
+			 *
+			 * @return The padded name.
+			 */
+			static std::string padName(const std::string& name, size_t length);
+		};
+	}
+}
\ No newline at end of file
@@ -0,0 +1,179 @@
+#include <string>
+#include <vector>
+#include <chrono>
+#include <iostream>
+#include <stdexcept>
+
+#include <boost/filesystem.hpp>
+#include <boost/property_tree/ptree.hpp>
+#include <boost/property_tree/xml_parser.hpp>
+
+#include "util/QuizModel.hpp"
+#include "util/QuizBinary.hpp"
+#include "util/QuizDocument.hpp"
+#include "benchmarks/QuizGenerator.hpp"
+
+
+namespace {
+	/**
+	 * @brief Reads a quiz file the way the loader did before QuizDocument,
+	 *        including the copies of the category and entry subtrees.
+	 *
+	 * @param[in] path The path of the quiz file.
+	 *
+	 * @return The number of entries read.
+	 */
+	size_t readPropertyTree(const std::string& path)
+	{
+		boost::property_tree::ptree tree;
+		boost::property_tree::read_xml(path, tree, boost::property_tree::xml_parser::trim_whitespace);
+		boost::property_tree::ptree sub_tree = tree.get_child("MusicQuiz");
+
+		size_t numberOfEntries = 0;
+		boost::property_tree::ptree::const_iterator ctrl = sub_tree.begin();
+		for ( ; ctrl != sub_tree.end(); ++ctrl ) {
+			if ( ctrl->first == "QuizCategories" ) {
+				boost::property_tree::ptree categoriesTree = ctrl->second;
+				boost::property_tree::ptree::const_iterator sub_ctrl = categoriesTree.begin();
+				for ( ; sub_ctrl != categoriesTree.end(); ++sub_ctrl ) {
+					if ( sub_ctrl->first != "Category" ) {
+						continue;
+					}
+
+					const std::string categoryName = sub_ctrl->second.get<std::string>("<xmlattr>.name");
+					boost::property_tree::ptree entryTree = sub_ctrl->second;
+					boost::property_tree::ptree::const_iterator it = entryTree.begin();
+					for ( ; it != entryTree.end(); ++it ) {
+						if ( it->first != "QuizEntry" ) {
+							continue;
+						}
+
+						const std::string answer = it->second.get<std::string>("Answer");
+						const size_t points = it->second.get<size_t>("Points");
+						const size_t startTime = it->second.get<size_t>("StartTime");
+						const std::string songFile = it->second.get<std::string>("Media.SongFile");
+						if ( !answer.empty() && !songFile.empty() && points + startTime > 0 ) {
+							++numberOfEntries;
+						}
+					}
+				}
+			}
+		}
+
+		return numberOfEntries;
+	}
+
+	/**
+	 * @brief Reads a quiz file with QuizDocument.
+	 *
+	 * @param[in] path The path of the quiz file.
+	 *
+	 * @return The number of entries read.
+	 */
+	size_t readQuizDocument(const std::string& path)
+	{
+		const MusicQuiz::util::QuizDocument::CPtr document = MusicQuiz::util::QuizDocument::fromFile(path);
+		return document->getNumberOfEntries();
+	}
+
+	/**
+	 * @brief Reads the compiled binary of a quiz file.
+	 *
+	 * @param[in] path The path of the quiz file.
+	 *
+	 * @return The number of entries read.
+	 */
+	size_t readQuizBinary(const std::string& path)
+	{
+		const MusicQuiz::util::QuizDocument::CPtr document = MusicQuiz::util::QuizBinary::read(MusicQuiz::util::QuizBinary::getBinaryPath(path), path);
+		return document->getNumberOfEntries();
+	}
+
+	/**
+	 * @brief Reads the compiled binary of a quiz file and creates the quiz model, including the media file checks.
+	 *
+	 * @param[in] path The path of the quiz file.
+	 *
+	 * @return The number of entries read.
+	 */
+	size_t readQuizModel(const std::string& path)
+	{
+		const MusicQuiz::util::QuizDocument::CPtr document = MusicQuiz::util::QuizBinary::read(MusicQuiz::util::QuizBinary::getBinaryPath(path), path);
+		const MusicQuiz::util::QuizModel::CPtr model = MusicQuiz::util::QuizModel::fromDocument(*document, boost::filesystem::current_path().string() + "/");
+		return model->getNumberOfEntries();
+	}
+
+	/**
+	 * @brief Runs a reader a number of times and prints the average time.
+	 *
+	 * @param[in] name The name of the reader.
+	 * @param[in] reader The reader.
+	 * @param[in] path The path of the quiz file.
+	 * @param[in] iterations The number of iterations.
+	 *
+	 * @return The average time in microseconds.
+	 */
+	double run(const std::string& name, size_t (*reader)(const std::string&), const std::string& path, const size_t iterations)
+	{
+		size_t numberOfEntries = 0;
+		const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+		for ( size_t i = 0; i < iterations; ++i ) {
+			numberOfEntries = reader(path);
+		}
+		const std::chrono::steady_clock::time_point end = std::chrono::steady_clock::now();
+
+		const double time = std::chrono::duration<double, std::micro>(end - start).count() / static_cast<double>(iterations);
+		std::cout << name << ": " << time << " us/load (" << numberOfEntries << " entries)" << std::endl;
+		return time;
+	}
+}
+
+int main(int argc, char* argv[])
+{
+	/** Arguments */
+	if ( argc > 3 ) {
+		std::cout << "Usage: " << argv[0] << " [entries per category] [iterations]" << std::endl;
+		return 1;
+	}
+
+	size_t numberOfEntries = 200, iterations = 20;
+	try {
+		if ( argc > 1 ) {
+			numberOfEntries = std::stoul(argv[1]);
+		}
+		if ( argc > 2 ) {
+			iterations = std::stoul(argv[2]);
+		}
+	} catch ( const std::exception& err ) {
+		std::cout << "Invalid argument. " << err.what() << std::endl;
+		return 1;
+	}
+
+	/** Create Quiz */
+	const size_t numberOfCategories = 5;
+	const boost::filesystem::path folder = boost::filesystem::temp_directory_path() / boost::filesystem::unique_path("bench_%%%%%%%%");
+	MusicQuiz::benchmarks::QuizGenerator::Options options;
+	options.numberOfCategories = numberOfCategories;
+	options.numberOfEntries = numberOfEntries;
+	options.writeSummary = false;
+	options.mediaFiles = MusicQuiz::benchmarks::QuizGenerator::MediaFiles::NONE;
+	const boost::filesystem::path path = MusicQuiz::benchmarks::QuizGenerator::writeQuiz(folder.string(), "Benchmark", options);
+	std::cout << "Quiz: " << numberOfCategories * numberOfEntries << " entries, " << boost::filesystem::file_size(path) << " bytes" << std::endl;
+
+	/** Run */
+	const double propertyTreeTime = run("property_tree", &readPropertyTree, path.string(), iterations);
+	const double quizDocumentTime = run("QuizDocument ", &readQuizDocument, path.string(), iterations);
+	std::cout << "Speedup: " << propertyTreeTime / quizDocumentTime << "x" << std::endl;
+
+	/** Compiled Quiz */
+	const std::string binaryPath = MusicQuiz::util::QuizBinary::getBinaryPath(path.string());
+	MusicQuiz::util::QuizBinary::write(*MusicQuiz::util::QuizDocument::fromFile(path.string()), binaryPath);
+	const double quizBinaryTime = run("QuizBinary   ", &readQuizBinary, path.string(), iterations);
+	std::cout << "Speedup: " << propertyTreeTime / quizBinaryTime << "x" << std::endl;
+
+	/** Quiz Model */
+	run("QuizModel    ", &readQuizModel, path.string(), iterations);
+
+	boost::filesystem::remove_all(folder);
+	return 0;
+}
\ No newline at end of file
@@ -0,0 +1,125 @@
+#include <chrono>
+#include <string>
+#include <iostream>
+#include <stdexcept>
+
+#include <boost/filesystem.hpp>
+
+#include "util/QuizBinary.hpp"
+#include "util/QuizDocument.hpp"
+#include "benchmarks/QuizGenerator.hpp"
+
+
+namespace {
+	/**
+	 * @brief Prints the usage of the generator.
+	 *
+	 * @param[in] program The name of the program.
+	 */
+	void printUsage(const std::string& program)
+	{
+		std::cerr << "Usage: " << program << " [options]\n"
+			<< "  --output <folder>          Data folder to write the quizzes to (default ./data)\n"
+			<< "  --quizzes <n>              Number of quizzes (default 10)\n"
+			<< "  --categories <n>           Categories per quiz (default 5)\n"
+			<< "  --entries <n>              Entries per category (default 5)\n"
+			<< "  --video-percentage <n>     Percentage of the entries that are videos (default 25)\n"
+			<< "  --row-categories <n>       Row categories per quiz (default one per entry row)\n"
+			<< "  --name-length <n>          Minimum length of the category and entry names (default 0)\n"
+			<< "  --media <none|shared|per-entry>  Placeholder media files (default per-entry)\n"
+			<< "  --song-size <bytes>        Size of the song files, written as sparse files (default 0)\n"
+			<< "  --video-size <bytes>       Size of the video files, written as sparse files (default 0)\n"
+			<< "  --no-summary               Do not write the quiz summary\n"
+			<< "  --compile                  Also write the compiled quiz next to each quiz file\n";
+	}
+
+	/**
+	 * @brief Parses the media mode.
+	 *
+	 * @param[in] value The media mode.
+	 *
+	 * @return The media files option.
+	 */
+	MusicQuiz::benchmarks::QuizGenerator::MediaFiles parseMediaFiles(const std::string& value)
+	{
+		if ( value == "none" ) {
+			return MusicQuiz::benchmarks::QuizGenerator::MediaFiles::NONE;
+		} else if ( value == "shared" ) {
+			return MusicQuiz::benchmarks::QuizGenerator::MediaFiles::SHARED;
+		} else if ( value == "per-entry" ) {
+			return MusicQuiz::benchmarks::QuizGenerator::MediaFiles::PER_ENTRY;
+		}
+		throw std::runtime_error("Unknown media mode '" + value + "'.");
+	}
+}
+
+int main(int argc, char* argv[])
+{
+	/** Arguments */
+	std::string dataFolder = "./data";
+	size_t numberOfQuizzes = 10;
+	bool compile = false;
+	MusicQuiz::benchmarks::QuizGenerator::Options options;
+	try {
+		for ( int i = 1; i < argc; ++i ) {
+			const std::string arg = argv[i];
+			const bool hasValue = i + 1 < argc;
+			if ( arg == "--no-summary" ) {
+				options.writeSummary = false;
+			} else if ( arg == "--compile" ) {
+				compile = true;
+			} else if ( arg == "--output" && hasValue ) {
+				dataFolder = argv[++i];
+			} else if ( arg == "--quizzes" && hasValue ) {
+				numberOfQuizzes = std::stoul(argv[++i]);
+			} else if ( arg == "--categories" && hasValue ) {
+				options.numberOfCategories = std::stoul(argv[++i]);
+			} else if ( arg == "--entries" && hasValue ) {
+				options.numberOfEntries = std::stoul(argv[++i]);
+			} else if ( arg == "--video-percentage" && hasValue ) {
+				options.videoPercentage = std::stoul(argv[++i]);
+			} else if ( arg == "--row-categories" && hasValue ) {
+				options.numberOfRowCategories = std::stoul(argv[++i]);
+			} else if ( arg == "--name-length" && hasValue ) {
+				options.nameLength = std::stoul(argv[++i]);
+			} else if ( arg == "--media" && hasValue ) {
+				options.mediaFiles = parseMediaFiles(argv[++i]);
+			} else if ( arg == "--song-size" && hasValue ) {
+				options.songFileSize = std::stoull(argv[++i]);
+			} else if ( arg == "--video-size" && hasValue ) {
+				options.videoFileSize = std::stoull(argv[++i]);
+			} else {
+				printUsage(argv[0]);
+				return 1;
+			}
+		}
+	} catch ( const std::exception& err ) {
+		std::cerr << "Invalid argument. " << err.what() << std::endl;
+		printUsage(argv[0]);
+		return 1;
+	}
+
+	/** Generate */
+	const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+	try {
+		for ( size_t i = 0; i < numberOfQuizzes; ++i ) {
+			const std::string quizName = "Quiz_" + std::to_string(i);
+			const std::string quizFile = MusicQuiz::benchmarks::QuizGenerator::writeQuiz(dataFolder + "/" + quizName, quizName, options);
+
+			/** Compile Quiz */
+			if ( compile ) {
+				const MusicQuiz::util::QuizDocument::CPtr document = MusicQuiz::util::QuizDocument::fromFile(quizFile);
+				MusicQuiz::util::QuizBinary::write(*document, MusicQuiz::util::QuizBinary::getBinaryPath(quizFile));
+			}
+		}
+	} catch ( const std::exception& err ) {
+		std::cerr << "Failed to generate quizzes. " << err.what() << std::endl;
+		return 1;
+	}
+
+	const double elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+	std::cout << "Generated " << numberOfQuizzes << " quizzes with " << options.numberOfCategories * options.numberOfEntries
+		<< " entries each in '" << dataFolder << "' in " << elapsed << " s." << std::endl;
+
+	return 0;
+}
\ No newline at end of file
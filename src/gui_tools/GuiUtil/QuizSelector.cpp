@@ -1,6 +1,7 @@
 #include "QuizSelector.hpp"
 
 #include <sstream>
+#include <algorithm>
 #include <stdexcept>
 
 #include <QLabel>
@@ -38,15 +39,21 @@ MusicQuiz::QuizSelector::QuizSelector(QWidget* parent) :
 
 	/** Load Quiz Previews */
 	for ( size_t i = 0; i < _quizList.size(); ++i ) {
-		try {
-			_quizPreviews.push_back(MusicQuiz::util::QuizLoader::getQuizPreview(i));
-		} catch ( const std::exception& err ) {
-			LOG_ERROR("Failed to load quiz #" << i << ". " << err.what());
-		} catch ( ... ) {
-			LOG_ERROR("Failed to load quiz #" << i << ".");
-		}
+		_quizPreviews.push_back(loadQuizPreview(_quizList[i]));
 	}
 
+	/** Persist the previews that had to be parsed */
+	MusicQuiz::util::QuizLoader::getCatalog()->save();
+
+	/** Follow Changes to the Data Folder */
+	MusicQuiz::util::QuizLibraryWatcher* watcher = MusicQuiz::util::QuizLoader::getLibraryWatcher();
+	connect(watcher, SIGNAL(quizAdded(const QString&)), this, SLOT(quizAdded(const QString&)));
+	connect(watcher, SIGNAL(quizModified(const QString&)), this, SLOT(quizModified(const QString&)));
+	connect(watcher, SIGNAL(quizRemoved(const QString&)), this, SLOT(quizRemoved(const QString&)));
+
+	/** Build the search index in the background while the selector is shown */
+	connect(MusicQuiz::util::QuizLoader::getSearchIndexUpdater(), SIGNAL(updated()), this, SLOT(searchIndexUpdated()));
+
 	/** Create Layout */
 	createLayout();
 
@@ -74,6 +81,14 @@ void MusicQuiz::QuizSelector::createLayout()
 	mainlayout->setColumnStretch(0, 1);
 	mainlayout->setColumnStretch(1, 4);
 
+	/** Search */
+	_searchText = new QLineEdit;
+	_searchText->setObjectName("quizSearchText");
+	_searchText->setPlaceholderText("Search quizzes, categories and songs");
+	_searchText->setClearButtonEnabled(true);
+	quizSelectionLayout->addWidget(_searchText);
+	connect(_searchText, SIGNAL(textChanged(const QString&)), this, SLOT(searchChanged(const QString&)));
+
 	/** Quiz Selection List */
 	_quizSelectionList = new QListWidget;
 	_quizSelectionList->setSpacing(0);
@@ -84,11 +99,7 @@ void MusicQuiz::QuizSelector::createLayout()
 
 	/** Add Quizzes */
 	for ( size_t i = 0; i < _quizPreviews.size(); ++i ) {
-		QListWidgetItem* quizName = new QListWidgetItem;
-		quizName->setSizeHint(QSize(100, 100));
-		quizName->setTextAlignment(Qt::AlignCenter);
-		quizName->setText(QString(" ") + QString::fromStdString(_quizPreviews[i].quizName));
-		_quizSelectionList->addItem(quizName);
+		_quizSelectionList->addItem(createQuizItem(_quizPreviews[i]));
 	}
 
 	/** Description */
@@ -189,6 +200,145 @@ void MusicQuiz::QuizSelector::createLayout()
 	}
 }
 
+MusicQuiz::util::QuizLoader::QuizPreview MusicQuiz::QuizSelector::loadQuizPreview(const std::string& quizPath)
+{
+	try {
+		return MusicQuiz::util::QuizLoader::getQuizPreview(MusicQuiz::util::QuizCatalog::getQuizId(quizPath));
+	} catch ( const std::exception& err ) {
+		LOG_ERROR("Failed to load quiz '" << quizPath << "'. " << err.what());
+
+		MusicQuiz::util::QuizLoader::QuizPreview quizPreview;
+		quizPreview.quizName = quizPath.substr(quizPath.find_last_of("\\/") + 1);
+		quizPreview.quizDescription = std::string("Failed to load quiz. ") + err.what();
+		return quizPreview;
+	}
+}
+
+QListWidgetItem* MusicQuiz::QuizSelector::createQuizItem(const MusicQuiz::util::QuizLoader::QuizPreview& quizPreview)
+{
+	QListWidgetItem* quizName = new QListWidgetItem;
+	quizName->setSizeHint(QSize(100, 100));
+	quizName->setTextAlignment(Qt::AlignCenter);
+	quizName->setText(QString(" ") + QString::fromStdString(quizPreview.quizName));
+	return quizName;
+}
+
+void MusicQuiz::QuizSelector::quizAdded(const QString& quizPath)
+{
+	/** Keep the rows in catalog order */
+	const std::string path = quizPath.toStdString();
+	const std::vector<std::string>::iterator it = std::lower_bound(_quizList.begin(), _quizList.end(), path);
+	if ( it != _quizList.end() && *it == path ) {
+		quizModified(quizPath);
+		return;
+	}
+
+	const size_t row = static_cast<size_t>(it - _quizList.begin());
+	_quizList.insert(it, path);
+	_quizPreviews.insert(_quizPreviews.begin() + row, loadQuizPreview(path));
+
+	if ( _quizSelectionList != nullptr ) {
+		_quizSelectionList->insertItem(static_cast<int>(row), createQuizItem(_quizPreviews[row]));
+		if ( _quizSelectionList->currentRow() < 0 ) {
+			_quizSelectionList->setCurrentRow(0);
+		}
+	}
+}
+
+void MusicQuiz::QuizSelector::quizModified(const QString& quizPath)
+{
+	const std::string path = quizPath.toStdString();
+	const std::vector<std::string>::iterator it = std::lower_bound(_quizList.begin(), _quizList.end(), path);
+	if ( it == _quizList.end() || *it != path ) {
+		quizAdded(quizPath);
+		return;
+	}
+
+	const size_t row = static_cast<size_t>(it - _quizList.begin());
+	_quizPreviews[row] = loadQuizPreview(path);
+
+	if ( _quizSelectionList != nullptr ) {
+		_quizSelectionList->item(static_cast<int>(row))->setText(QString(" ") + QString::fromStdString(_quizPreviews[row].quizName));
+		if ( _quizSelectionList->currentRow() == static_cast<int>(row) ) {
+			selectionClicked();
+		}
+	}
+}
+
+void MusicQuiz::QuizSelector::quizRemoved(const QString& quizPath)
+{
+	const std::string path = quizPath.toStdString();
+	const std::vector<std::string>::iterator it = std::lower_bound(_quizList.begin(), _quizList.end(), path);
+	if ( it == _quizList.end() || *it != path ) {
+		return;
+	}
+
+	const size_t row = static_cast<size_t>(it - _quizList.begin());
+	_quizList.erase(it);
+	_quizPreviews.erase(_quizPreviews.begin() + row);
+
+	if ( _quizSelectionList != nullptr ) {
+		delete _quizSelectionList->takeItem(static_cast<int>(row));
+	}
+}
+
+void MusicQuiz::QuizSelector::searchIndexUpdated()
+{
+	/** Apply the search to the quizzes indexed since it was typed */
+	if ( _searchText != nullptr && !_searchText->text().trimmed().isEmpty() ) {
+		searchChanged(_searchText->text());
+	}
+}
+
+void MusicQuiz::QuizSelector::searchChanged(const QString& text)
+{
+	/** Sanity Check */
+	if ( _quizSelectionList == nullptr ) {
+		return;
+	}
+
+	/** Show all quizzes without a search */
+	const std::string searchText = text.trimmed().toStdString();
+	if ( searchText.empty() ) {
+		for ( int i = 0; i < _quizSelectionList->count(); ++i ) {
+			_quizSelectionList->item(i)->setHidden(false);
+		}
+		return;
+	}
+
+	/** Search */
+	std::vector<MusicQuiz::util::QuizSearchIndex::Result> results;
+	try {
+		results = MusicQuiz::util::QuizLoader::searchQuizzes(searchText);
+	} catch ( const std::exception& err ) {
+		LOG_ERROR("Failed to search quizzes. " << err.what());
+		return;
+	}
+
+	std::vector<bool> visible(_quizList.size(), false);
+	int bestRow = -1;
+	for ( size_t i = 0; i < results.size(); ++i ) {
+		const std::vector<std::string>::const_iterator it = std::lower_bound(_quizList.begin(), _quizList.end(), results[i].path);
+		if ( it != _quizList.end() && *it == results[i].path ) {
+			const size_t row = static_cast<size_t>(it - _quizList.begin());
+			visible[row] = true;
+			if ( bestRow < 0 ) {
+				bestRow = static_cast<int>(row);
+			}
+		}
+	}
+
+	for ( size_t i = 0; i < visible.size() && static_cast<int>(i) < _quizSelectionList->count(); ++i ) {
+		_quizSelectionList->item(static_cast<int>(i))->setHidden(!visible[i]);
+	}
+
+	/** Select the best match */
+	if ( bestRow >= 0 ) {
+		_quizSelectionList->setCurrentRow(bestRow);
+		_quizSelectionList->scrollToItem(_quizSelectionList->item(bestRow));
+	}
+}
+
 void MusicQuiz::QuizSelector::selectionClicked()
 {
 	/** Sanity Check */
@@ -278,7 +428,7 @@ void MusicQuiz::QuizSelector::quizSelected()
 		QMessageBox::No | QMessageBox::Yes, QMessageBox::Yes);
 
 	if ( resBtn == QMessageBox::Yes ) {
-		emit quizSelectedSignal(currentIndex, quizName, quizAuthor, _settings);
+		emit quizSelectedSignal(MusicQuiz::util::QuizCatalog::getQuizId(_quizList[currentIndex]), quizName, quizAuthor, _settings);
 	}
 }
 
@@ -71,6 +71,13 @@ namespace MusicQuiz {
 		 */
 		void selectionClicked();
 
+		/**
+		 * @brief Shows only the quizzes matching the search text and selects the best match.
+		 *
+		 * @param[in] text The search text.
+		 */
+		void searchChanged(const QString& text);
+
 		/**
 		 * @brief Emits the quiz selected signal.
 		 */
@@ -93,19 +100,64 @@ namespace MusicQuiz {
 		 */
 		void quit();
 
+		/**
+		 * @brief Adds a quiz that was added to the data folder.
+		 *
+		 * @param[in] quizPath The path of the quiz file.
+		 */
+		void quizAdded(const QString& quizPath);
+
+		/**
+		 * @brief Reloads the preview of a quiz that was changed.
+		 *
+		 * @param[in] quizPath The path of the quiz file.
+		 */
+		void quizModified(const QString& quizPath);
+
+		/**
+		 * @brief Removes a quiz that was removed from the data folder.
+		 *
+		 * @param[in] quizPath The path of the quiz file.
+		 */
+		void quizRemoved(const QString& quizPath);
+
+		/**
+		 * @brief Applies the search again after the search index has been updated.
+		 */
+		void searchIndexUpdated();
+
 	signals:
 		void quitSignal();
-		void quizSelectedSignal(size_t quizIdx, const QString& quizName, const QString& quizAuthor, const MusicQuiz::QuizSettings& settings);
+		void quizSelectedSignal(MusicQuiz::util::QuizId quizId, const QString& quizName, const QString& quizAuthor, const MusicQuiz::QuizSettings& settings);
 	protected:
 		/**
 		 * @brief Creates the category layout.
 		 */
 		void createLayout();
 
+		/**
+		 * @brief Loads the preview of a quiz. A quiz that fails to load is shown with the error as description.
+		 *
+		 * @param[in] quizPath The path of the quiz file.
+		 *
+		 * @return The quiz preview.
+		 */
+		MusicQuiz::util::QuizLoader::QuizPreview loadQuizPreview(const std::string& quizPath);
+
+		/**
+		 * @brief Creates the list item of a quiz.
+		 *
+		 * @param[in] quizPreview The quiz preview.
+		 *
+		 * @return The list item.
+		 */
+		QListWidgetItem* createQuizItem(const MusicQuiz::util::QuizLoader::QuizPreview& quizPreview);
+
 		/** Variables */
 		bool _quizClosed = false;
 
 		QLineEdit* _authorText = nullptr;
+		QLineEdit* _searchText = nullptr;
 		QTextEdit* _categoryText = nullptr;
 		QTextEdit* _rowCategoryText = nullptr;
 		QTextEdit* _descriptionText = nullptr;
@@ -120,4 +172,4 @@ namespace MusicQuiz {
 		std::vector<std::string> _quizList;
 		std::vector<MusicQuiz::util::QuizLoader::QuizPreview> _quizPreviews;
 	};
-}
+}
\ No newline at end of file
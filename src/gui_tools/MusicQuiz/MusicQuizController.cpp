@@ -9,6 +9,7 @@
 #include <QApplication>
 
 #include "common/Log.hpp"
+#include "util/QuizLoader.hpp"
 #include "gui_tools/widgets/QuizFactory.hpp"
 #include "gui_tools/widgets/QuizCategory.hpp"
 #include "gui_tools/GuiUtil/QuizSelector.hpp"
@@ -45,6 +46,11 @@ MusicQuiz::MusicQuizController::MusicQuizController(QWidget* parent) :
 
 MusicQuiz::MusicQuizController::~MusicQuizController()
 {
+	/** Cancel Quiz Loading */
+	if ( _loadTask != nullptr ) {
+		_loadTask->cancel();
+	}
+
 	/** Stop Audio */
 	if ( _audioPlayer != nullptr ) {
 		_audioPlayer->stop();
@@ -106,7 +112,7 @@ void MusicQuiz::MusicQuizController::executeQuiz()
 
 		/** Connect Signals */
 		connect(_quizSelector, SIGNAL(quitSignal()), this, SLOT(quitQuiz()));
-		connect(_quizSelector, SIGNAL(quizSelectedSignal(size_t, const QString&, const QString&, const MusicQuiz::QuizSettings&)), this, SLOT(quizSelected(size_t, const QString&, const QString&, const MusicQuiz::QuizSettings&)));
+		connect(_quizSelector, SIGNAL(quizSelectedSignal(MusicQuiz::util::QuizId, const QString&, const QString&, const MusicQuiz::QuizSettings&)), this, SLOT(quizSelected(MusicQuiz::util::QuizId, const QString&, const QString&, const MusicQuiz::QuizSettings&)));
 
 		/** Show widget */
 		_quizSelector->exec();
@@ -173,9 +179,39 @@ void MusicQuiz::MusicQuizController::executeQuiz()
 			break;
 		}
 
+		/** Start loading the quiz if that did not happen when it was selected */
+		if ( _loadTask == nullptr ) {
+			_loadTask = MusicQuiz::util::QuizLoader::loadAsync(_selectedQuizId);
+		}
+
+		/** Wait for the quiz to be loaded */
+		if ( _loadTask->getState() == MusicQuiz::util::QuizLoadTask::State::RUNNING ) {
+			if ( !_waitingForQuiz ) {
+				size_t done = 0, total = 0;
+				_loadTask->getProgress(done, total);
+				LOG_INFO("Waiting for the quiz to load (" << done << "/" << total << " media files and entries).");
+				QApplication::setOverrideCursor(Qt::WaitCursor);
+				_waitingForQuiz = true;
+			}
+			break;
+		}
+
+		if ( _waitingForQuiz ) {
+			QApplication::restoreOverrideCursor();
+			_waitingForQuiz = false;
+		}
+
 		try {
+			/** Get Quiz Model */
+			const MusicQuiz::util::QuizModel::CPtr model = _loadTask->getModel();
+			const std::string loadError = _loadTask->getError();
+			_loadTask = nullptr;
+			if ( model == nullptr ) {
+				throw std::runtime_error(loadError);
+			}
+
 			/** Create Quiz Board */
-			_quizBoard = MusicQuiz::QuizFactory::createQuiz(_selectedQuizIdx, _settings, _audioPlayer, _videoPlayer, _teams);
+			_quizBoard = MusicQuiz::QuizFactory::createQuiz(model, _settings, _audioPlayer, _videoPlayer, _teams);
 
 			/** Connect Signals */
 			connect(_quizBoard, SIGNAL(quitSignal()), this, SLOT(quitQuiz()));
@@ -237,17 +273,23 @@ void MusicQuiz::MusicQuizController::quitQuiz()
 	QApplication::quit();
 }
 
-void MusicQuiz::MusicQuizController::quizSelected(const size_t quizIdx, const QString& quizName, const QString& quizAuthor, const MusicQuiz::QuizSettings& settings)
+void MusicQuiz::MusicQuizController::quizSelected(const MusicQuiz::util::QuizId quizId, const QString& quizName, const QString& quizAuthor, const MusicQuiz::QuizSettings& settings)
 {
 	/** Set Quiz Selected */
 	_quizSelected = true;
-	_selectedQuizIdx = quizIdx;
+	_selectedQuizId = quizId;
 	_quizName = quizName;
 	_quizAuthor = quizAuthor;
 
 	/** Set Settings */
 	_settings = settings;
 
+	/** Load the quiz while the teams are selected and the intro is shown. A load that is replaced is cancelled, but not waited for */
+	if ( _loadTask != nullptr ) {
+		_loadTask->cancel();
+	}
+	_loadTask = MusicQuiz::util::QuizLoader::loadAsync(quizId);
+
 	/** Remove Quiz Selector */
 	_quizSelector->hide();
 	delete _quizSelector;
@@ -13,6 +13,8 @@
 
 #include "ui_MusicQuizGUI.h"
 
+#include "util/QuizId.hpp"
+#include "util/QuizLoadTask.hpp"
 #include "util/QuizSettings.hpp"
 #include "media/AudioPlayer.hpp"
 #include "media/VideoPlayer.hpp"
@@ -77,12 +79,12 @@ namespace MusicQuiz {
 		/**
 		 * @brief Handles quiz selected.
 		 *
-		 * @param[in] quizIdx The selected quiz index.
+		 * @param[in] quizId The selected quiz id.
 		 * @param[in] quizName The selected quiz name.
 		 * @param[in] quizAuthor The selected quiz author.
 		 * @param[in] settings The quiz settings.
 		 */
-		void quizSelected(size_t quizIdx, const QString& quizName, const QString& quizAuthor, const MusicQuiz::QuizSettings& settings);
+		void quizSelected(MusicQuiz::util::QuizId quizId, const QString& quizName, const QString& quizAuthor, const MusicQuiz::QuizSettings& settings);
 
 		/**
 		 * @brief Handles team selected.
@@ -128,7 +130,9 @@ namespace MusicQuiz {
 		QuizState _quizState = QuizState::SELECT_QUIZ;
 
 		/** Quiz Settings */
-		size_t _selectedQuizIdx = 0;
+		MusicQuiz::util::QuizId _selectedQuizId = 0;
+		MusicQuiz::util::QuizLoadTask::Ptr _loadTask = nullptr;
+		bool _waitingForQuiz = false;
 		QString _quizName = "";
 		QString _quizAuthor = "";
 		MusicQuiz::QuizSettings _settings;
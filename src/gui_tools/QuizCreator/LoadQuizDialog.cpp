@@ -2,6 +2,7 @@
 
 #include <algorithm>
 
+#include <QLineEdit>
 #include <QGridLayout>
 #include <QHBoxLayout>
 #include <QHeaderView>
@@ -9,6 +10,9 @@
 #include <QTableWidget>
 #include <QRadioButton>
 
+#include "common/Log.hpp"
+#include "util/QuizPackage.hpp"
+
 
 MusicQuiz::LoadQuizDialog::LoadQuizDialog(QWidget* parent) :
 	QDialog(parent)
@@ -33,6 +37,14 @@ MusicQuiz::LoadQuizDialog::LoadQuizDialog(QWidget* parent) :
 
 	/** Update Table */
 	updateTable();
+
+	/** Follow Changes to the Data Folder */
+	MusicQuiz::util::QuizLibraryWatcher* watcher = MusicQuiz::util::QuizLoader::getLibraryWatcher();
+	connect(watcher, SIGNAL(quizAdded(const QString&)), this, SLOT(quizAdded(const QString&)));
+	connect(watcher, SIGNAL(quizRemoved(const QString&)), this, SLOT(quizRemoved(const QString&)));
+
+	/** Build the search index in the background while the dialog is shown */
+	connect(MusicQuiz::util::QuizLoader::getSearchIndexUpdater(), SIGNAL(updated()), this, SLOT(searchIndexUpdated()));
 }
 
 void MusicQuiz::LoadQuizDialog::makeWidgetLayout()
@@ -42,6 +54,14 @@ void MusicQuiz::LoadQuizDialog::makeWidgetLayout()
 	mainLayout->setHorizontalSpacing(15);
 	mainLayout->setVerticalSpacing(15);
 
+	/** Search */
+	_searchText = new QLineEdit;
+	_searchText->setObjectName("quizCreatorSearchText");
+	_searchText->setPlaceholderText("Search");
+	_searchText->setClearButtonEnabled(true);
+	QObject::connect(_searchText, SIGNAL(textChanged(const QString&)), this, SLOT(searchChanged(const QString&)));
+	mainLayout->addWidget(_searchText, 0, 0, 1, 2);
+
 	/** Jobs Table */
 	_quizTable = new QTableWidget(0, 1);
 	_quizTable->setStyleSheet("border: 0;");
@@ -55,7 +75,7 @@ void MusicQuiz::LoadQuizDialog::makeWidgetLayout()
 	_quizTable->verticalHeader()->setSectionResizeMode(QHeaderView::Fixed);
 	_quizTable->verticalHeader()->setDefaultSectionSize(55);
 	_quizTable->verticalHeader()->setVisible(false);
-	mainLayout->addWidget(_quizTable, 0, 0, 1, 2);
+	mainLayout->addWidget(_quizTable, 1, 0, 1, 2);
 
 	/** Button Groupe */
 	_buttonGroup = new QButtonGroup;
@@ -64,13 +84,13 @@ void MusicQuiz::LoadQuizDialog::makeWidgetLayout()
 	QPushButton* loadBtn = new QPushButton("Load");
 	loadBtn->setObjectName("quizCreatorBtn");
 	QObject::connect(loadBtn, SIGNAL(released()), this, SLOT(loadQuiz()));
-	mainLayout->addWidget(loadBtn, 1, 0);
+	mainLayout->addWidget(loadBtn, 2, 0);
 
 	/** Close Button */
 	QPushButton* closeBtn = new QPushButton("Close");
 	closeBtn->setObjectName("quizCreatorBtn");
 	QObject::connect(closeBtn, SIGNAL(released()), this, SLOT(close()));
-	mainLayout->addWidget(closeBtn, 1, 1);
+	mainLayout->addWidget(closeBtn, 2, 1);
 
 	/** Set Layout */
 	setLayout(mainLayout);
@@ -89,33 +109,128 @@ void MusicQuiz::LoadQuizDialog::updateTable()
 	/** Get List of weldfiles */
 	_quizList = MusicQuiz::util::QuizLoader::getListOfQuizzes();
 
+	/** Quiz packages are read-only, they can not be edited */
+	_quizList.erase(std::remove_if(_quizList.begin(), _quizList.end(), &MusicQuiz::util::QuizPackage::isPackageFile), _quizList.end());
+
 	/** Update Table */
-	for ( unsigned int i = 0; i < _quizList.size(); ++i ) {
-		/** Add Row */
-		const int row = _quizTable->rowCount();
-		_quizTable->insertRow(row);
-
-		/** Quiz Name */
-		std::string quizName = _quizList[i].substr(_quizList[i].find_last_of("\\") + 1);
-		const std::string fileExtension = ".quiz.xml";
-		quizName.erase(quizName.find(fileExtension), fileExtension.length());
-
-		/** Radio Button */
-		QWidget* btnWidget = new QWidget(this);
-		QHBoxLayout* btnLayout = new QHBoxLayout(btnWidget);
-
-		QRadioButton* btn = new QRadioButton(QString::fromStdString(quizName));
-		btn->setObjectName("quizCreatorRadioButton");
-		btn->setProperty("index", i);
-		if ( i == 0 ) {
-			btn->setChecked(true);
+	for ( size_t i = 0; i < _quizList.size(); ++i ) {
+		insertRow(_quizTable->rowCount(), _quizList[i]);
+	}
+}
+
+void MusicQuiz::LoadQuizDialog::insertRow(const int row, const std::string& quizPath)
+{
+	/** Add Row */
+	_quizTable->insertRow(row);
+
+	/** Quiz Name */
+	std::string quizName = quizPath.substr(quizPath.find_last_of("\\/") + 1);
+	const std::string fileExtension = ".quiz.xml";
+	quizName.erase(quizName.find(fileExtension), fileExtension.length());
+
+	/** Radio Button */
+	QWidget* btnWidget = new QWidget(this);
+	QHBoxLayout* btnLayout = new QHBoxLayout(btnWidget);
+
+	QRadioButton* btn = new QRadioButton(QString::fromStdString(quizName));
+	btn->setObjectName("quizCreatorRadioButton");
+	btn->setProperty("quizPath", QString::fromStdString(quizPath));
+	if ( _buttonGroup->checkedButton() == nullptr ) {
+		btn->setChecked(true);
+	}
+	_buttonGroup->addButton(btn);
+
+	btnLayout->addWidget(btn, Qt::AlignCenter | Qt::AlignVCenter);
+	btnWidget->setLayout(btnLayout);
+	btnLayout->setAlignment(Qt::AlignCenter);
+	_quizTable->setCellWidget(row, 0, btnWidget);
+}
+
+void MusicQuiz::LoadQuizDialog::quizAdded(const QString& quizPath)
+{
+	/** Keep the rows in catalog order */
+	const std::string path = quizPath.toStdString();
+	const std::vector<std::string>::iterator it = std::lower_bound(_quizList.begin(), _quizList.end(), path);
+	if ( _quizTable == nullptr || (it != _quizList.end() && *it == path) || MusicQuiz::util::QuizPackage::isPackageFile(path) ) {
+		return;
+	}
+
+	const int row = static_cast<int>(it - _quizList.begin());
+	_quizList.insert(it, path);
+	insertRow(row, path);
+}
+
+void MusicQuiz::LoadQuizDialog::quizRemoved(const QString& quizPath)
+{
+	const std::string path = quizPath.toStdString();
+	const std::vector<std::string>::iterator it = std::lower_bound(_quizList.begin(), _quizList.end(), path);
+	if ( _quizTable == nullptr || it == _quizList.end() || *it != path ) {
+		return;
+	}
+
+	const int row = static_cast<int>(it - _quizList.begin());
+	_quizList.erase(it);
+	_quizTable->removeRow(row);
+}
+
+void MusicQuiz::LoadQuizDialog::searchIndexUpdated()
+{
+	/** Apply the search to the quizzes indexed since it was typed */
+	if ( _searchText != nullptr && !_searchText->text().trimmed().isEmpty() ) {
+		searchChanged(_searchText->text());
+	}
+}
+
+void MusicQuiz::LoadQuizDialog::searchChanged(const QString& text)
+{
+	/** Sanity Check */
+	if ( _quizTable == nullptr ) {
+		return;
+	}
+
+	/** Show all quizzes without a search */
+	const std::string searchText = text.trimmed().toStdString();
+	if ( searchText.empty() ) {
+		for ( int i = 0; i < _quizTable->rowCount(); ++i ) {
+			_quizTable->setRowHidden(i, false);
 		}
-		_buttonGroup->addButton(btn, i);
+		return;
+	}
+
+	/** Search */
+	std::vector<MusicQuiz::util::QuizSearchIndex::Result> results;
+	try {
+		results = MusicQuiz::util::QuizLoader::searchQuizzes(searchText);
+	} catch ( const std::exception& err ) {
+		LOG_ERROR("Failed to search quizzes. " << err.what());
+		return;
+	}
+
+	std::vector<bool> visible(_quizList.size(), false);
+	int bestRow = -1;
+	for ( size_t i = 0; i < results.size(); ++i ) {
+		const std::vector<std::string>::const_iterator it = std::lower_bound(_quizList.begin(), _quizList.end(), results[i].path);
+		if ( it != _quizList.end() && *it == results[i].path ) {
+			const size_t row = static_cast<size_t>(it - _quizList.begin());
+			visible[row] = true;
+			if ( bestRow < 0 ) {
+				bestRow = static_cast<int>(row);
+			}
+		}
+	}
+
+	for ( size_t i = 0; i < visible.size() && static_cast<int>(i) < _quizTable->rowCount(); ++i ) {
+		_quizTable->setRowHidden(static_cast<int>(i), !visible[i]);
+	}
 
-		btnLayout->addWidget(btn, Qt::AlignCenter | Qt::AlignVCenter);
-		btnWidget->setLayout(btnLayout);
-		btnLayout->setAlignment(Qt::AlignCenter);
-		_quizTable->setCellWidget(row, 0, btnWidget);
+	/** Check the best match */
+	if ( bestRow >= 0 ) {
+		QWidget* btnWidget = _quizTable->cellWidget(bestRow, 0);
+		QRadioButton* btn = btnWidget != nullptr ? btnWidget->findChild<QRadioButton*>() : nullptr;
+		if ( btn != nullptr ) {
+			btn->setChecked(true);
+		}
+		_quizTable->scrollTo(_quizTable->model()->index(bestRow, 0));
 	}
 }
 
@@ -126,17 +241,17 @@ void MusicQuiz::LoadQuizDialog::loadQuiz()
 		return;
 	}
 
-	/** Get Index */
+	/** Get Selected Quiz */
 	QRadioButton* btn = qobject_cast<QRadioButton*>(_buttonGroup->checkedButton());
 	if ( btn == nullptr ) {
 		close();
 		return;
 	}
-	const size_t idx = btn->property("index").toInt();
+	std::string quizPath = btn->property("quizPath").toString().toStdString();
 
 	/** Emit Signal */
-	std::replace(_quizList[idx].begin(), _quizList[idx].end(), '\\', '/');
-	emit loadSignal(_quizList[idx]);
+	std::replace(quizPath.begin(), quizPath.end(), '\\', '/');
+	emit loadSignal(quizPath);
 
 	/** Close Dialog */
 	close();
@@ -10,6 +10,7 @@
 
 #include "util/QuizLoader.hpp"
 
+class QLineEdit;
 class QTableWidget;
 
 
@@ -44,11 +45,37 @@ namespace MusicQuiz {
 		 */
 		void updateTable();
 
+		/**
+		 * @brief Shows only the quizzes matching the search text and checks the best match.
+		 *
+		 * @param[in] text The search text.
+		 */
+		void searchChanged(const QString& text);
+
 		/**
 		 * @brief Emits the load quiz with the selected index.
 		 */
 		void loadQuiz();
 
+		/**
+		 * @brief Adds the row of a quiz that was added to the data folder.
+		 *
+		 * @param[in] quizPath The path of the quiz file.
+		 */
+		void quizAdded(const QString& quizPath);
+
+		/**
+		 * @brief Removes the row of a quiz that was removed from the data folder.
+		 *
+		 * @param[in] quizPath The path of the quiz file.
+		 */
+		void quizRemoved(const QString& quizPath);
+
+		/**
+		 * @brief Applies the search again after the search index has been updated.
+		 */
+		void searchIndexUpdated();
+
 	signals:
 		void loadSignal(const std::string&);
 
@@ -58,7 +85,16 @@ namespace MusicQuiz {
 		 */
 		void makeWidgetLayout();
 
+		/**
+		 * @brief Inserts the row of a quiz.
+		 *
+		 * @param[in] row The row to insert.
+		 * @param[in] quizPath The path of the quiz file.
+		 */
+		void insertRow(int row, const std::string& quizPath);
+
 		/** Variables */
+		QLineEdit* _searchText = nullptr;
 		QTableWidget* _quizTable = nullptr;
 		QButtonGroup* _buttonGroup = nullptr;
 
@@ -8,6 +8,7 @@
 #include <QSpacerItem>
 #include <QPushButton>
 #include <QHeaderView>
+#include <QFileDialog>
 #include <QMessageBox>
 #include <QApplication>
 #include <QTableWidgetItem>
@@ -21,6 +22,8 @@
 
 #include "common/Log.hpp"
 #include "common/TimeUtil.hpp"
+#include "util/QuizLoader.hpp"
+#include "util/QuizPackage.hpp"
 #include "util/QuizSettings.hpp"
 #include "gui_tools/widgets/QuizTeam.hpp"
 #include "gui_tools/widgets/QuizBoard.hpp"
@@ -123,6 +126,22 @@ void MusicQuiz::QuizCreator::createLayout()
 	_hiddenCategoriesCheckbox->setObjectName("quizCreatorCheckbox");
 	setupTabLayout->addWidget(_hiddenCategoriesCheckbox, ++row, 0, 1, 2);
 
+	_mediaStoreCheckbox = new QCheckBox("Share Media Files Between Quizzes");
+	_mediaStoreCheckbox->setObjectName("quizCreatorCheckbox");
+	setupTabLayout->addWidget(_mediaStoreCheckbox, ++row, 0, 1, 1);
+
+	QPushButton* cleanMediaStoreBtn = new QPushButton("Clean Shared Media");
+	cleanMediaStoreBtn->setObjectName("quizCreatorBtn");
+	cleanMediaStoreBtn->setFocusPolicy(Qt::FocusPolicy::NoFocus);
+	connect(cleanMediaStoreBtn, SIGNAL(released()), this, SLOT(cleanMediaStore()));
+	setupTabLayout->addWidget(cleanMediaStoreBtn, row, 1, 1, 1, Qt::AlignRight);
+
+	QPushButton* exportPackageBtn = new QPushButton("Export Package");
+	exportPackageBtn->setObjectName("quizCreatorBtn");
+	exportPackageBtn->setFocusPolicy(Qt::FocusPolicy::NoFocus);
+	connect(exportPackageBtn, SIGNAL(released()), this, SLOT(exportQuizPackage()));
+	setupTabLayout->addWidget(exportPackageBtn, ++row, 1, 1, 1, Qt::AlignRight);
+
 	/** Setup Tab - Categories */
 	label = new QLabel("Categories:");
 	label->setObjectName("quizCreatorLabel");
@@ -514,6 +533,9 @@ void MusicQuiz::QuizCreator::saveQuiz()
 	quizData.guessTheCategory = _hiddenCategoriesCheckbox->isChecked();
 	quizData.guessTheCategoryPoints = 500; // \todo implement this.
 
+	/** Media Store */
+	quizData.useMediaStore = _mediaStoreCheckbox->isChecked();
+
 	/** Quiz Categories */
 	quizData.quizCategories = _categories;
 
@@ -599,6 +621,11 @@ void MusicQuiz::QuizCreator::loadQuiz(const std::string& quizName)
 		_quizDescriptionTextEdit->setText(quizData.quizDescription);
 	}
 
+	/** Set Media Store */
+	if ( _mediaStoreCheckbox != nullptr ) {
+		_mediaStoreCheckbox->setChecked(quizData.useMediaStore);
+	}
+
 	/** Add Categories to Table */
 	_categories = quizData.quizCategories;
 	if ( _categoriesTable != nullptr ) {
@@ -747,6 +774,44 @@ void MusicQuiz::QuizCreator::stopQuizPreview()
 	_previewQuizBoard = nullptr;
 }
 
+void MusicQuiz::QuizCreator::cleanMediaStore()
+{
+	try {
+		const MusicQuiz::util::MediaStore::GarbageReport report = MusicQuiz::util::QuizLoader::collectMediaGarbage();
+		QMessageBox::information(this, "Info", QString("Removed %1 unused media files (%2 MB).").arg(report.files).arg(static_cast<double>(report.bytes) / 1e6, 0, 'f', 1));
+	} catch ( const std::exception& err ) {
+		QMessageBox::warning(this, "Failed to Clean Shared Media", "Failed to clean the shared media. " + QString::fromStdString(err.what()));
+	}
+}
+
+void MusicQuiz::QuizCreator::exportQuizPackage()
+{
+	/** Check that quiz have been saved */
+	const std::string quizName = _quizNameLineEdit->text().toStdString();
+	const std::string quizPath = "./data/" + quizName + "/" + quizName + ".quiz.xml";
+	if ( quizName.empty() || !boost::filesystem::exists(quizPath) ) {
+		QMessageBox::information(nullptr, "Info", "Quiz must be saved before it can be exported.");
+		return;
+	}
+
+	/** Select Package File */
+	const QString packagePath = QFileDialog::getSaveFileName(this, "Export Quiz Package", QString::fromStdString("./data/" + quizName + ".quizpack"), "Quiz Package (*.quizpack);");
+	if ( packagePath.isEmpty() ) {
+		return;
+	}
+
+	/** Write Package */
+	QApplication::setOverrideCursor(Qt::WaitCursor);
+	try {
+		const size_t numberOfFiles = MusicQuiz::util::QuizPackage::write(quizPath, packagePath.toStdString(), boost::filesystem::current_path().string());
+		QApplication::restoreOverrideCursor();
+		QMessageBox::information(this, "Info", QString("Exported the quiz with %1 media files to '%2'.").arg(numberOfFiles).arg(packagePath));
+	} catch ( const std::exception& err ) {
+		QApplication::restoreOverrideCursor();
+		QMessageBox::warning(this, "Failed to Export Quiz", "Failed to export the quiz. " + QString::fromStdString(err.what()));
+	}
+}
+
 void MusicQuiz::QuizCreator::quitCreator()
 {
 	QMessageBox::StandardButton resBtn = QMessageBox::question(this, "Close Quiz Creator?", "Are you sure you want to close the Quiz Creator?",
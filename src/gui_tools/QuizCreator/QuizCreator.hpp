@@ -32,6 +32,9 @@ namespace MusicQuiz {
 			bool guessTheCategory = false;
 			size_t guessTheCategoryPoints = 0;
 
+			/** Store the media files in the media store shared between quizzes */
+			bool useMediaStore = false;
+
 			std::vector< QString > quizRowCategories;
 			std::vector< MusicQuiz::CategoryCreator* > quizCategories;
 		};
@@ -128,6 +131,16 @@ namespace MusicQuiz {
 		 */
 		void quitCreator();
 
+		/**
+		 * @brief Removes the files in the shared media store that no quiz uses.
+		 */
+		void cleanMediaStore();
+
+		/**
+		 * @brief Exports the saved quiz and its media files to a single quiz package.
+		 */
+		void exportQuizPackage();
+
 
 
 		void categoryOrderChanged(int, int, int);
@@ -152,6 +165,7 @@ namespace MusicQuiz {
 		QTextEdit* _quizDescriptionTextEdit = nullptr;
 
 		QCheckBox* _hiddenCategoriesCheckbox = nullptr;
+		QCheckBox* _mediaStoreCheckbox = nullptr;
 
 		QTableWidget* _categoriesTable = nullptr;
 		QTableWidget* _rowCategoriesTable = nullptr;
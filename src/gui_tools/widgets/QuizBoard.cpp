@@ -22,6 +22,12 @@
 #include "gui_tools/GuiUtil/QExtensions/QPushButtonExtender.hpp"
 
 
+namespace {
+	/** Number of unplayed neighbours of a hovered entry that are preloaded along with it */
+	const size_t MAX_ADJACENT_PRELOADS = 2;
+}
+
+
 MusicQuiz::QuizBoard::QuizBoard(const std::vector<MusicQuiz::QuizCategory*>& categories, const std::vector<QString>& rowCategories,
 	const std::vector<MusicQuiz::QuizTeam*>& teams, const MusicQuiz::QuizSettings& settings, bool preview, QWidget* parent) :
 	QDialog(parent), _settings(settings), _teams(teams), _categories(categories)
@@ -316,7 +322,51 @@ bool MusicQuiz::QuizBoard::eventFilter(QObject* target, QEvent* event)
 			closeWindow();
 			return true;
 		}
+	} else if ( event->type() == QEvent::Enter ) {
+		MusicQuiz::QuizEntry* quizEntry = dynamic_cast<MusicQuiz::QuizEntry*>(target);
+		if ( quizEntry != nullptr ) {
+			preloadEntries(quizEntry);
+		}
 	}
 
 	return QDialog::eventFilter(target, event);
+}
+
+void MusicQuiz::QuizBoard::preloadEntries(MusicQuiz::QuizEntry* quizEntry)
+{
+	/** Find Entry */
+	int category = -1, row = -1;
+	for ( size_t i = 0; i < _categories.size() && category < 0; ++i ) {
+		for ( size_t j = 0; j < _categories[i]->getSize(); ++j ) {
+			if ( (*_categories[i])[static_cast<int>(j)] == quizEntry ) {
+				category = static_cast<int>(i);
+				row = static_cast<int>(j);
+				break;
+			}
+		}
+	}
+
+	if ( category < 0 ) {
+		return;
+	}
+
+	/** Neighbours, the next entry in the category first, as the points usually go up */
+	const int neighbours[4][2] = { { category, row + 1 }, { category + 1, row }, { category, row - 1 }, { category - 1, row } };
+	size_t preloaded = 0;
+	for ( size_t i = 0; i < 4 && preloaded < MAX_ADJACENT_PRELOADS; ++i ) {
+		const int neighbourCategory = neighbours[i][0], neighbourRow = neighbours[i][1];
+		if ( neighbourCategory < 0 || neighbourRow < 0 || neighbourCategory >= static_cast<int>(_categories.size()) ||
+			neighbourRow >= static_cast<int>(_categories[neighbourCategory]->getSize()) ) {
+			continue;
+		}
+
+		MusicQuiz::QuizEntry* neighbour = (*_categories[neighbourCategory])[neighbourRow];
+		if ( neighbour != nullptr && neighbour->getEntryState() == QuizEntry::EntryState::IDLE ) {
+			neighbour->preload();
+			++preloaded;
+		}
+	}
+
+	/** The hovered entry is preloaded last, so it is the last to be replaced */
+	quizEntry->preload();
 }
\ No newline at end of file
@@ -15,6 +15,7 @@
 
 namespace MusicQuiz {
 	class QuizTeam;
+	class QuizEntry;
 	class QuizCategory;
 	class QuizBoard : public QDialog
 	{
@@ -110,6 +111,13 @@ namespace MusicQuiz {
 		 */
 		void createLayout();
 
+		/**
+		 * @brief Preloads the audio of a hovered entry and of its unplayed neighbours, so the next click starts playing at once.
+		 *
+		 * @param[in] quizEntry The hovered entry.
+		 */
+		void preloadEntries(MusicQuiz::QuizEntry* quizEntry);
+
 		/** Variables */
 		bool _quizClosed = false;
 		bool _quizStopped = false;
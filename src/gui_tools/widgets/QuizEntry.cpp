@@ -12,7 +12,7 @@
 
 
 MusicQuiz::QuizEntry::QuizEntry(const QString& audioFile, const QString& answer, const size_t points, const size_t startTime, const size_t answerStartTime, const media::AudioPlayer::Ptr& audioPlayer, QWidget* parent) :
-	QPushButton(parent), _points(points), _startTime(startTime), _answerStartTime(answerStartTime), _answer(answer), _audioFile(audioFile), _audioPlayer(audioPlayer)
+	QPushButton(parent), _points(points), _startTime(startTime), _answerStartTime(answerStartTime), _answer(answer), _audioSource(media::MediaSource::fromFile(audioFile)), _audioPlayer(audioPlayer)
 {
 	/** Sanity Check */
 	if ( _audioPlayer == nullptr ) {
@@ -41,8 +41,8 @@ MusicQuiz::QuizEntry::QuizEntry(const QString& audioFile, const QString& answer,
 MusicQuiz::QuizEntry::QuizEntry(const QString& audioFile, const QString& videoFile, const QString& answer, size_t points, size_t songStartTime, size_t videoStartTime, size_t answerStartTime,
 	const media::AudioPlayer::Ptr& audioPlayer, const media::VideoPlayer::Ptr& videoPlayer, QWidget* parent) :
 	QPushButton(parent), _points(points), _startTime(songStartTime), _videoStartTime(videoStartTime), 
-	_answerStartTime(answerStartTime), _answer(answer), _audioFile(audioFile), 
-	_videoFile(videoFile), _audioPlayer(audioPlayer), _videoPlayer(videoPlayer)
+	_answerStartTime(answerStartTime), _answer(answer), _audioSource(media::MediaSource::fromFile(audioFile)), 
+	_videoSource(media::MediaSource::fromFile(videoFile)), _audioPlayer(audioPlayer), _videoPlayer(videoPlayer)
 {
 	/** Sanity Check */
 	if ( _audioPlayer == nullptr ) {
@@ -134,12 +134,12 @@ void MusicQuiz::QuizEntry::leftClickEvent()
 	case EntryState::IDLE: // Start Media
 		_state = EntryState::PLAYING;
 		if ( _type == EntryType::Song ) {
-			_audioPlayer->play(_audioFile, _startTime);
+			playAudio(_startTime);
 		} else if ( _type == EntryType::Video ) {
 			_audioPlayer->stop();
-			_videoPlayer->play(_videoFile, _videoStartTime, true);
+			playVideo(_videoStartTime, true);
 			_videoPlayer->show();
-			_audioPlayer->play(_audioFile, _startTime);
+			playAudio(_startTime);
 		}
 		break;
 	case EntryState::PLAYING: // Pause Media
@@ -148,14 +148,19 @@ void MusicQuiz::QuizEntry::leftClickEvent()
 		if ( _videoPlayer != nullptr ) {
 			_videoPlayer->pause();
 		}
+
+		/** The next click plays the answer */
+		if ( _type == EntryType::Song ) {
+			_audioPlayer->preload(_audioSource, _answerStartTime);
+		}
 		break;
 	case EntryState::PAUSED: // Play Answer
 		_textSizeSet = false;
 		_state = EntryState::PLAYING_ANSWER;
 		if ( _type == EntryType::Song ) {
-			_audioPlayer->play(_audioFile, _answerStartTime);
+			playAudio(_answerStartTime);
 		} else if ( _type == EntryType::Video ) {
-			_videoPlayer->play(_videoFile, _answerStartTime);
+			playVideo(_answerStartTime);
 			_videoPlayer->show();
 		}
 
@@ -173,9 +178,9 @@ void MusicQuiz::QuizEntry::leftClickEvent()
 		break;
 	case QuizEntry::EntryState::PLAYED: // Play Answer Again
 		if ( _type == EntryType::Song ) {
-			_audioPlayer->play(_audioFile, _answerStartTime);
+			playAudio(_answerStartTime);
 		} else if ( _type == EntryType::Video ) {
-			_videoPlayer->play(_videoFile, _answerStartTime);
+			playVideo(_answerStartTime);
 			_videoPlayer->show();
 		}
 		_state = EntryState::PLAYING_ANSWER;
@@ -285,6 +290,34 @@ MusicQuiz::QuizEntry::EntryState MusicQuiz::QuizEntry::getEntryState()
 	return _state;
 }
 
+void MusicQuiz::QuizEntry::setMediaSources(const media::MediaSource& audio, const media::MediaSource& video)
+{
+	if ( audio.isValid() ) {
+		_audioSource = audio;
+	}
+
+	if ( video.isValid() ) {
+		_videoSource = video;
+	}
+}
+
+void MusicQuiz::QuizEntry::preload()
+{
+	if ( _state == EntryState::IDLE ) {
+		_audioPlayer->preload(_audioSource, _startTime);
+	}
+}
+
+void MusicQuiz::QuizEntry::playAudio(const size_t startTime)
+{
+	_audioPlayer->play(_audioSource, startTime);
+}
+
+void MusicQuiz::QuizEntry::playVideo(const size_t startTime, const bool muted)
+{
+	_videoPlayer->play(_videoSource, startTime, muted);
+}
+
 void MusicQuiz::QuizEntry::setHiddenAnswer(bool hidden)
 {
 	_hiddenAnswer = hidden;
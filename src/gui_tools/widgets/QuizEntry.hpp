@@ -11,6 +11,7 @@
 
 #include "media/AudioPlayer.hpp"
 #include "media/VideoPlayer.hpp"
+#include "media/MediaSource.hpp"
 
 #include "common/Log.hpp"
 class QMouseEvent;
@@ -84,6 +85,19 @@ namespace MusicQuiz {
 		 */
 		EntryState getEntryState();
 
+		/**
+		 * @brief Replaces the media files by other media sources, such as media in a quiz package.
+		 *
+		 * @param[in] audio The audio source. Ignored if empty.
+		 * @param[in] video The video source. Ignored if empty.
+		 */
+		void setMediaSources(const media::MediaSource& audio, const media::MediaSource& video);
+
+		/**
+		 * @brief Preloads the audio the next click on the entry plays, if the entry has not been played yet.
+		 */
+		void preload();
+
 	public slots:
 		/**
 		 * @brief Sets the color of the button (used after the entry is answered).
@@ -151,6 +165,21 @@ namespace MusicQuiz {
 		 */
 		void applyColor(const QColor& color);
 
+		/**
+		 * @brief Plays the audio of the entry.
+		 *
+		 * @param[in] startTime The start time in [ms].
+		 */
+		void playAudio(size_t startTime);
+
+		/**
+		 * @brief Plays the video of the entry.
+		 *
+		 * @param[in] startTime The start time in [ms].
+		 * @param[in] muted True if the audio of the video should be muted.
+		 */
+		void playVideo(size_t startTime, bool muted = false);
+
 		/** Variables */
 		size_t _points = 0;
 		size_t _fontSize = 40;
@@ -164,8 +193,8 @@ namespace MusicQuiz {
 		bool _entryAnswered = false;
 		QColor _answeredColor = QColor(0, 0, 120);
 
-		QString _audioFile = "";
-		QString _videoFile = "";
+		media::MediaSource _audioSource;
+		media::MediaSource _videoSource;
 
 		EntryType _type = EntryType::Song;
 		EntryState _state = EntryState::IDLE;
@@ -2,75 +2,84 @@
 
 #include <math.h>
 #include <time.h>
+#include <map>
 #include <vector>
 #include <string>
-#include <fstream>
 #include <stdlib.h>
 #include <stdexcept>
+#include <algorithm>
 
+#include <QTimer>
 #include <QString>
 #include <QMessageBox>
-
-#include <boost/property_tree/ptree.hpp>
-#include <boost/property_tree/xml_parser.hpp>
+#include <QStringList>
+#include <QProgressDialog>
 
 #include "common/Log.hpp"
-#include "common/TimeUtil.hpp"
 #include "util/QuizLoader.hpp"
+#include "util/QuizSaveTask.hpp"
+#include "util/QuizValidator.hpp"
+#include "util/SpecialTileAssigner.hpp"
 #include "gui_tools/widgets/QuizEntry.hpp"
 #include "gui_tools/widgets/QuizCategory.hpp"
 #include "gui_tools/QuizCreator/EntryCreator.hpp"
 #include "gui_tools/QuizCreator/CategoryCreator.hpp"
 
 
+namespace {
+	/** Number of problems listed when a quiz is validated, so the dialog fits on the screen */
+	const size_t MAX_REPORTED_ISSUES = 20;
+}
+
+
 MusicQuiz::QuizBoard* MusicQuiz::QuizFactory::createQuiz(const std::string& quizName, const QuizSettings& settings, const media::AudioPlayer::Ptr& audioPlayer,
 	const media::VideoPlayer::Ptr& videoPlayer, const std::vector<MusicQuiz::QuizTeam*>& teams, bool preview, QWidget* parent)
 {
-	/** Get List of Quizzes */
-	std::vector<std::string> quizList = MusicQuiz::util::QuizLoader::getListOfQuizzes();
-	if ( quizList.empty() ) {
-		throw std::runtime_error("No quizzes found in the data folder.");
-	}
-
 	/** Check if Quiz Exists */
-	size_t idx = 0;
-	bool quizExists = false;
-	for ( size_t i = 0; i < quizList.size(); ++i ) {
-		std::replace(quizList[i].begin(), quizList[i].end(), '\\', '/');
-		if ( quizName == quizList[i] ) {
-			idx = i;
-			quizExists = true;
-			break;
-		}
-	}
-
-	/** Sanity Check */
-	if ( !quizExists ) {
+	const MusicQuiz::util::QuizId quizId = MusicQuiz::util::QuizCatalog::getQuizId(quizName);
+	if ( !MusicQuiz::util::QuizLoader::getCatalog()->contains(quizId) ) {
 		throw std::runtime_error("Quiz does not exists.");
 	}
 
 	/** Create Quiz */
-	return createQuiz(idx, settings, audioPlayer, videoPlayer, teams, preview, parent);
+	return createQuiz(quizId, settings, audioPlayer, videoPlayer, teams, preview, parent);
 }
 
-MusicQuiz::QuizBoard* MusicQuiz::QuizFactory::createQuiz(const size_t idx, const QuizSettings& settings, const media::AudioPlayer::Ptr& audioPlayer,
+MusicQuiz::QuizBoard* MusicQuiz::QuizFactory::createQuiz(const MusicQuiz::util::QuizId quizId, const QuizSettings& settings, const media::AudioPlayer::Ptr& audioPlayer,
 	const media::VideoPlayer::Ptr& videoPlayer, const std::vector<MusicQuiz::QuizTeam*>& teams, bool preview, QWidget* parent)
 {
-	/** Seed Rand */
-	srand(time(NULL));
+	/** Load Quiz */
+	const MusicQuiz::util::QuizModel::CPtr model = MusicQuiz::util::QuizLoader::loadQuizModel(quizId);
 
+	/** Create Quiz */
+	return createQuiz(model, settings, audioPlayer, videoPlayer, teams, preview, parent);
+}
+
+MusicQuiz::QuizBoard* MusicQuiz::QuizFactory::createMixQuiz(const MusicQuiz::util::EntryIndex::Query& query, size_t numberOfCategories, size_t numberOfEntries, const QuizSettings& settings,
+	const media::AudioPlayer::Ptr& audioPlayer, const media::VideoPlayer::Ptr& videoPlayer, const std::vector<MusicQuiz::QuizTeam*>& teams, bool preview, QWidget* parent)
+{
+	/** Assemble Quiz */
+	const MusicQuiz::util::QuizModel::CPtr model = MusicQuiz::util::QuizLoader::loadMixModel(query, numberOfCategories, numberOfEntries, static_cast<unsigned int>(time(NULL)));
+
+	/** Create Quiz */
+	return createQuiz(model, settings, audioPlayer, videoPlayer, teams, preview, parent);
+}
+
+MusicQuiz::QuizBoard* MusicQuiz::QuizFactory::createQuiz(const MusicQuiz::util::QuizModel::CPtr& model, const QuizSettings& settings, const media::AudioPlayer::Ptr& audioPlayer,
+	const media::VideoPlayer::Ptr& videoPlayer, const std::vector<MusicQuiz::QuizTeam*>& teams, bool preview, QWidget* parent)
+{
 	/** Create Quiz Board */
 	MusicQuiz::QuizBoard* quizBoard = nullptr;
 
 	/** Load Categories */
-	std::string loadError;
-	std::vector<MusicQuiz::QuizCategory*> categories = MusicQuiz::util::QuizLoader::loadQuizCategories(idx, audioPlayer, videoPlayer, loadError);
+	const std::string loadError = model->getLoadError();
+	std::vector<MusicQuiz::QuizCategory*> categories = MusicQuiz::util::QuizLoader::loadQuizCategories(model, audioPlayer, videoPlayer);
 	if ( !loadError.empty() ) {
 		QMessageBox::information(nullptr, "Info", "Incomplete Quiz:\n\n" + QString::fromStdString(loadError));
 	}
 
 	/** Load Row Categories */
-	std::vector< QString > rowCategories = MusicQuiz::util::QuizLoader::loadQuizRowCategories(idx);
+	std::vector< QString > rowCategories = MusicQuiz::util::QuizLoader::loadQuizRowCategories(model);
 
 	/** Hidden Team Score */
 	if ( settings.hiddenTeamScore ) {
@@ -81,47 +90,33 @@ MusicQuiz::QuizBoard* MusicQuiz::QuizFactory::createQuiz(const size_t idx, const
 
 	/** Get Number of Entries */
 	size_t numberOfEntries = 0;
+	std::vector<size_t> categorySizes;
 	for ( size_t i = 0; i < categories.size(); ++i ) {
 		numberOfEntries += categories[i]->getSize();
+		categorySizes.push_back(categories[i]->getSize());
 	}
 
-	std::vector<size_t> entriesIndicies(numberOfEntries);
-	for ( size_t i = 0; i < numberOfEntries; ++i ) {
-		entriesIndicies[i] = i;
-	}
-
-	/** Get Daily Double Entries */
-	size_t dailyDoubleCount = std::floor(double(numberOfEntries * settings.dailyDoublePercentage) / 100.0);
-	std::vector<size_t> dailyDoubleSelectedElements;
+	/** Number of Daily Double Entries, atleast one if the setting is enabled */
+	size_t dailyDoubleCount = 0;
 	if ( settings.dailyDouble && !teams.empty() ) {
-		/** Ensure that there is atleas one element if the setting is enabled */
-		if ( dailyDoubleCount == 0 ) {
-			dailyDoubleCount = 1;
-		}
-
-		/** Select Elements */
-		while ( dailyDoubleSelectedElements.size() < dailyDoubleCount && !entriesIndicies.empty() ) {
-			const size_t randomIdx = rand() % entriesIndicies.size();
-			dailyDoubleSelectedElements.push_back(entriesIndicies[randomIdx]);
-			entriesIndicies.erase(entriesIndicies.begin() + randomIdx);
-		}
+		dailyDoubleCount = std::max(static_cast<size_t>(std::floor(double(numberOfEntries * settings.dailyDoublePercentage) / 100.0)), static_cast<size_t>(1));
 	}
 
-	/** Get Daily Triple Entries */
-	size_t dailyTripleCount = std::floor(double(numberOfEntries * settings.dailyTriplePercentage) / 100.0);
-	std::vector<size_t> dailyTripleSelectedElements;
+	/** Number of Daily Triple Entries, atleast one if the setting is enabled */
+	size_t dailyTripleCount = 0;
 	if ( settings.dailyTriple && !teams.empty() ) {
-		/** Ensure that there is atleas one element if the setting is enabled */
-		if ( dailyTripleCount == 0 ) {
-			dailyTripleCount = 1;
-		}
+		dailyTripleCount = std::max(static_cast<size_t>(std::floor(double(numberOfEntries * settings.dailyTriplePercentage) / 100.0)), static_cast<size_t>(1));
+	}
 
-		/** Select Elements */
-		while ( dailyTripleSelectedElements.size() < dailyTripleCount && !entriesIndicies.empty() ) {
-			const size_t randomIdx = rand() % entriesIndicies.size();
-			dailyTripleSelectedElements.push_back(entriesIndicies[randomIdx]);
-			entriesIndicies.erase(entriesIndicies.begin() + randomIdx);
-		}
+	/** Place Special Tiles */
+	MusicQuiz::util::SpecialTileAssigner::Constraints constraints;
+	constraints.onePerCategory = settings.oneSpecialTilePerCategory;
+	constraints.onePerRow = settings.oneSpecialTilePerRow;
+	constraints.bothHalves = settings.specialTilesInBothHalves;
+	const std::uint64_t seed = settings.specialTileSeed != 0 ? settings.specialTileSeed : MusicQuiz::util::SpecialTileAssigner::createSeed();
+	const MusicQuiz::util::SpecialTileAssigner::Assignment assignment = MusicQuiz::util::SpecialTileAssigner::assign(categorySizes, dailyDoubleCount, dailyTripleCount, constraints, seed);
+	if ( dailyDoubleCount + dailyTripleCount > 0 ) {
+		LOG_INFO("Placed " << assignment.numberOfDoubles << " daily doubles and " << assignment.numberOfTriples << " daily triples with seed " << assignment.seed << ".");
 	}
 
 	/** Apply Settings */
@@ -133,24 +128,23 @@ MusicQuiz::QuizBoard* MusicQuiz::QuizFactory::createQuiz(const size_t idx, const
 		for ( size_t j = 0; j < categories[i]->getSize(); ++j ) {
 			MusicQuiz::QuizEntry* quizEntry = (*categories[i])[j];
 			if ( quizEntry != nullptr ) {
-				/** Double Points */
-				for ( size_t k = 0; k < dailyDoubleSelectedElements.size(); ++k ) {
-					if ( counter == dailyDoubleSelectedElements[k] ) {
-						quizEntry->setDoublePointsEnabled(true, settings.dailyDoubleHidden);
-					}
-
-				}
-
-				/** Triple Points */
-				for ( size_t k = 0; k < dailyTripleSelectedElements.size(); ++k ) {
-					if ( counter == dailyTripleSelectedElements[k] ) {
-						quizEntry->setTriplePointsEnabled(true, settings.dailyTripleHidden);
-					}
-
+				/** Double and Triple Points */
+				if ( assignment.tiles[counter] == MusicQuiz::util::SpecialTileAssigner::Tile::DOUBLE ) {
+					quizEntry->setDoublePointsEnabled(true, settings.dailyDoubleHidden);
+				} else if ( assignment.tiles[counter] == MusicQuiz::util::SpecialTileAssigner::Tile::TRIPLE ) {
+					quizEntry->setTriplePointsEnabled(true, settings.dailyTripleHidden);
 				}
 
 				/** Hidden Answers */
 				quizEntry->setHiddenAnswer(settings.hiddenAnswers);
+
+				/** Play History */
+				if ( !preview && i < model->categories.size() && j < model->categories[i].entries.size() ) {
+					const std::uint64_t key = model->categories[i].entries[j].key;
+					QObject::connect(quizEntry, &MusicQuiz::QuizEntry::played, [key]() {
+						MusicQuiz::util::QuizLoader::markPlayed(key);
+					});
+				}
 			}
 			++counter;
 		}
@@ -164,403 +158,261 @@ MusicQuiz::QuizBoard* MusicQuiz::QuizFactory::createQuiz(const size_t idx, const
 
 void MusicQuiz::QuizFactory::saveQuiz(const MusicQuiz::QuizCreator::QuizData& data, QWidget* parent)
 {
-	/** Tmp Folder */
-	std::string mediaDirectoryPath;
-
-	try {
-		/** Get Quiz Name */
-		const std::string quizName = data.quizName.toStdString();
-		if ( quizName.empty() ) {
-			QMessageBox::warning(parent, "Failed to Save Quiz", "The quiz name needs to be set before saving.");
-			return;
-		}
+	/** Copy the quiz out of the widgets, the save itself runs on a worker thread */
+	const MusicQuiz::util::QuizSnapshot snapshot = toSnapshot(data);
+
+	/** Validate Quiz. Every problem is reported at once */
+	const MusicQuiz::util::QuizValidator::Report report = MusicQuiz::util::QuizValidator::validate(snapshot);
+	LOG_INFO("Validated quiz in " << report.elapsed.count() << " us, " << report.errorCount << " errors and " << report.warningCount << " warnings.");
+	if ( !report.ok() ) {
+		QMessageBox::warning(parent, "Failed to Save Quiz", "Failed to save quiz. Please fix the following problems.\n\n" + QString::fromStdString(report.toString(MAX_REPORTED_ISSUES)));
+		return;
+	}
 
-		/** Get Quiz Name */
-		const std::string quizAuthor = data.quizAuthor.toStdString();
-		if ( quizAuthor.empty() ) {
-			QMessageBox::warning(parent, "Failed to Save Quiz", "The author needs to be set before saving.");
-			return;
-		}
+	if ( report.warningCount > 0 ) {
+		QMessageBox::StandardButton resBtn = QMessageBox::question(parent, "Save Quiz?", "The quiz has the following problems, do you want to save it anyway?\n\n" + QString::fromStdString(report.toString(MAX_REPORTED_ISSUES)),
+			QMessageBox::No | QMessageBox::Yes, QMessageBox::Yes);
 
-		/** Get Quiz Description */
-		const std::string quizDescription = data.quizDescription.toStdString();
-		if ( quizName.empty() ) {
-			QMessageBox::warning(parent, "Failed to Save Quiz", "The description needs to be set before saving.");
+		if ( resBtn != QMessageBox::Yes ) {
 			return;
 		}
+	}
 
-		/** Check if quiz already exists */
-		boost::system::error_code boost_err;
-		const std::string quizPath = "./data/" + quizName;
-		if ( boost::filesystem::is_directory(quizPath) ) {
-			QMessageBox::StandardButton resBtn = QMessageBox::question(parent, "Overwrite Quiz?", "Quiz already exists, do you want to overwrite existing quiz?",
-				QMessageBox::No | QMessageBox::Yes, QMessageBox::Yes);
+	/** Check if quiz already exists */
+	if ( boost::filesystem::is_directory("./data/" + snapshot.quizName) ) {
+		QMessageBox::StandardButton resBtn = QMessageBox::question(parent, "Overwrite Quiz?", "Quiz already exists, do you want to overwrite existing quiz?",
+			QMessageBox::No | QMessageBox::Yes, QMessageBox::Yes);
 
-			if ( resBtn != QMessageBox::Yes ) {
-				return;
-			}
-		} else if ( !boost::filesystem::is_directory(quizPath) ) {
-			/** Create Folder */
-			boost::filesystem::create_directory(quizPath, boost_err);
-			if ( boost_err ) {
-				QMessageBox::warning(parent, "Failed to Save Quiz", "Failed to create directory to save the quiz in.");
-				return;
-			}
+		if ( resBtn != QMessageBox::Yes ) {
+			return;
 		}
+	}
 
-		/** Create Media Folder */
-		mediaDirectoryPath = quizPath + "/mediaTmp";
-		boost::filesystem::create_directory(mediaDirectoryPath, boost_err);
-		if ( boost_err ) {
-			QMessageBox::warning(parent, "Failed to Save Quiz", "Failed to create directory to save the media files in.");
+	/** Start Saving. Only the media files that are new or changed are copied */
+	MusicQuiz::util::QuizSaveTask::Options options;
+	options.mode = MusicQuiz::util::QuizSaveTask::Mode::INCREMENTAL;
+	options.useMediaStore = data.useMediaStore;
+	options.mediaStore = MusicQuiz::util::QuizLoader::getMediaStore();
+	const MusicQuiz::util::QuizSaveTask::Ptr task = std::make_shared<MusicQuiz::util::QuizSaveTask>(snapshot, "./data", options);
+
+	/** Show the progress while the task runs. The dialog keeps the event loop running, so the creator stays responsive */
+	QProgressDialog progressDialog("Saving quiz...", "Cancel", 0, 1000, parent);
+	progressDialog.setWindowTitle("Saving Quiz");
+	progressDialog.setWindowModality(Qt::WindowModal);
+	progressDialog.setMinimumDuration(0);
+	progressDialog.setAutoClose(false);
+	progressDialog.setAutoReset(false);
+
+	QTimer progressTimer;
+	QObject::connect(&progressTimer, &QTimer::timeout, [&progressDialog, &task]() {
+		if ( task->getState() != MusicQuiz::util::QuizSaveTask::State::RUNNING ) {
+			progressDialog.accept();
 			return;
 		}
 
-		/** Wirte Quiz to XML Parser */
-		boost::property_tree::ptree tree;
-		boost::property_tree::ptree& main_tree = tree.put("MusicQuiz", "");
-		main_tree.put("<xmlcomment>", std::string("File content written on the ") + common::TimeUtil::getTimeNow());
-
-		/** Quiz Name */
-		main_tree.put("QuizName", quizName);
-
-		/** Quiz Author */
-		main_tree.put("QuizAuthor", quizAuthor);
-
-		/** Quiz Description */
-		main_tree.put("QuizDescription", quizDescription);
-
-		/** Guess the Category Setting */
-		boost::property_tree::ptree& guessTheCategory_tree = main_tree.add("QuizGuessTheCategory", 500);
-		guessTheCategory_tree.put<bool>("<xmlattr>.enabled", data.guessTheCategory);
-
-		/** Categories */
-		const size_t numberOfCategories = data.quizCategories.size();
-		for ( size_t i = 0; i < numberOfCategories; ++i ) {
-			/** Get Category */
-			const MusicQuiz::CategoryCreator* category = data.quizCategories[i];
+		const MusicQuiz::util::QuizSaveTask::Progress progress = task->getProgress();
+		if ( progress.committing ) {
+			progressDialog.setLabelText("Writing quiz...");
+			progressDialog.setCancelButton(nullptr);
+		} else if ( progress.currentFile.empty() && progress.filesTotal > 0 ) {
+			progressDialog.setLabelText(QString("Adding media files to the media store (%1 of %2)\n%3 of %4 MB, %5 MB/s")
+				.arg(progress.filesDone).arg(progress.filesTotal)
+				.arg(static_cast<double>(progress.bytesDone) / 1e6, 0, 'f', 1)
+				.arg(static_cast<double>(progress.bytesTotal) / 1e6, 0, 'f', 1)
+				.arg(progress.bytesPerSecond / 1e6, 0, 'f', 1));
+		} else if ( !progress.currentFile.empty() ) {
+			progressDialog.setLabelText(QString("Copying %1 (%2 of %3)\n%4 of %5 MB, %6 MB/s")
+				.arg(QString::fromStdString(boost::filesystem::path(progress.currentFile).filename().string()))
+				.arg(progress.filesDone + 1).arg(progress.filesTotal)
+				.arg(static_cast<double>(progress.bytesDone) / 1e6, 0, 'f', 1)
+				.arg(static_cast<double>(progress.bytesTotal) / 1e6, 0, 'f', 1)
+				.arg(progress.bytesPerSecond / 1e6, 0, 'f', 1));
+		}
 
-			/** Create Category tree */
-			boost::property_tree::ptree& category_tree = main_tree.add("QuizCategories.Category", "");
+		if ( progress.bytesTotal > 0 ) {
+			progressDialog.setValue(static_cast<int>(1000 * progress.bytesDone / progress.bytesTotal));
+		}
+	});
+	progressTimer.start(50);
+	progressDialog.exec();
+	progressTimer.stop();
+
+	/** The dialog was closed by the user */
+	if ( task->getState() == MusicQuiz::util::QuizSaveTask::State::RUNNING ) {
+		task->cancel();
+	}
+	task->wait();
 
-			/** Category Name */
-			const std::string categoryName = category->getName().toStdString();
-			if ( categoryName.empty() ) {
-				QMessageBox::warning(parent, "Failed to Save Quiz", "Failed to save quiz. All categories must have a name.");
-				deleteDirectory(mediaDirectoryPath);
-				return;
-			}
+	/** Commit */
+	const MusicQuiz::util::QuizSaveTask::Progress progress = task->getProgress();
+	switch ( task->getState() )
+	{
+	case MusicQuiz::util::QuizSaveTask::State::FINISHED:
+		/** Update Quiz Catalog */
+		MusicQuiz::util::QuizLoader::invalidateQuiz(task->getQuizFile());
 
-			/** Check if two categories have the same name */
-			for ( size_t j = 0; j < numberOfCategories; ++j ) {
-				if ( j != i ) {
-					if ( categoryName == data.quizCategories[j]->getName().toStdString() ) {
-						QMessageBox::warning(parent, "Failed to Save Quiz", "Failed to save quiz. All categories must have a unique name.");
-						deleteDirectory(mediaDirectoryPath);
-						return;
-					}
-				}
-			}
-			category_tree.put("<xmlattr>.name", categoryName);
-
-			/** Create Category Folder */
-			boost::filesystem::create_directory(mediaDirectoryPath + "/" + categoryName, boost_err);
-			if ( boost_err ) {
-				QMessageBox::warning(parent, "Failed to Save Quiz", "Failed to create directory to save the catrgory files in.");
-				deleteDirectory(mediaDirectoryPath);
-				return;
+		/** Popup to tell user that the quiz was saved */
+		{
+			QStringList backends;
+			for ( std::map<MusicQuiz::util::FileCopier::Backend, size_t>::const_iterator it = progress.copyBackends.begin(); it != progress.copyBackends.end(); ++it ) {
+				backends << QString("%1 (%2)").arg(QString::fromStdString(MusicQuiz::util::FileCopier::getBackendName(it->first))).arg(it->second);
 			}
 
-			/** Category Entries */
-			const std::vector< MusicQuiz::EntryCreator* > entries = category->getEntries();
-			const size_t numberOfEntries = entries.size();
-			for ( size_t j = 0; j < numberOfEntries; ++j ) {
-				/** Get Entry */
-				MusicQuiz::EntryCreator* entry = entries[j];
-
-				/** Create Entry tree */
-				boost::property_tree::ptree& entry_tree = category_tree.add("QuizEntry", "");
-
-				/** Entry Name */
-				const std::string entryName = entry->getName().toStdString();
-				if ( entryName.empty() ) {
-					QMessageBox::warning(parent, "Failed to Save Quiz", "Failed to save quiz. " + QString::fromStdString(categoryName) + ": All entries needs to have a name.");
-					deleteDirectory(mediaDirectoryPath);
-					return;
-				}
-				entry_tree.put("Answer", entryName);
-
-				/** Check if two entries have the same name */
-				for ( size_t k = 0; k < numberOfEntries; ++k ) {
-					if ( k != j ) {
-						if ( entryName == category->getEntries()[k]->getName().toStdString() ) {
-							QMessageBox::warning(parent, "Failed to Save Quiz", "Failed to save quiz. " + QString::fromStdString(categoryName) + ": All entires in a category must have a unique name.");
-							deleteDirectory(mediaDirectoryPath);
-							return;
-						}
-					}
-				}
-				entry_tree.put("<xmlattr>.name", entryName);
-
-				/** Entry Type */
-				const MusicQuiz::EntryCreator::EntryType type = entry->getType();
-				if ( type == MusicQuiz::EntryCreator::EntryType::Song ) {
-					entry_tree.put("<xmlattr>.type", "song");
-				} else if ( type == MusicQuiz::EntryCreator::EntryType::Video ) {
-					entry_tree.put("<xmlattr>.type", "video");
-				}
-
-				/** Entry Points */
-				entry_tree.put("Points", entry->getPoints());
-
-				/** Media */
-				if ( type == MusicQuiz::EntryCreator::EntryType::Song ) { // Song
-					/** Entry Song Start Time */
-					entry_tree.put("StartTime", entry->getSongStartTime());
-
-					/** Entry Song Answer Start Time */
-					entry_tree.put("AnswerStartTime", entry->getAnswerStartTime());
-
-					/** Media File */
-					const std::string songFile = entry->getSongFile().toStdString();
-					if ( !songFile.empty() ) {
-						const std::string audioFileExtension = boost::filesystem::path(songFile).extension().string();
-						const std::string songPath = quizPath + "/media/" + categoryName + "/" + entryName + audioFileExtension;
-						boost::property_tree::ptree& media_tree = entry_tree.add("Media", "");
-						media_tree.put("SongFile", songPath);
-
-						/** Copy Media File */
-						boost::filesystem::copy_file(songFile, mediaDirectoryPath + "/" + categoryName + "/" + entryName + audioFileExtension, boost::filesystem::copy_option::overwrite_if_exists);
-					}
-				} else if ( type == MusicQuiz::EntryCreator::EntryType::Video ) { // Video
-					/** Entry Video Start Time */
-					entry_tree.put("StartTime", entry->getVideoStartTime());
-
-					/** Entry Video Song Start Time */
-					entry_tree.put("VideoSongStartTime", entry->getVideoSongStartTime());
-
-					/** Entry Video Answer Start Time */
-					entry_tree.put("AnswerStartTime", entry->getVideoAnswerStartTime());
-
-					/** Media File */
-					const std::string videoFile = entry->getVideoFile().toStdString();
-					const std::string songFile = entry->getVideoSongFile().toStdString();
-
-					if ( !videoFile.empty() && !songFile.empty() ) {
-						const std::string videoFileExtension = boost::filesystem::path(videoFile).extension().string();
-						const std::string audioFileExtension = boost::filesystem::path(songFile).extension().string();
-						const std::string videoPath = quizPath + "/media/" + categoryName + "/" + entryName + "_video" + videoFileExtension;
-						const std::string songPath = quizPath + "/media/" + categoryName + "/" + entryName + "_song" + audioFileExtension;
-						boost::property_tree::ptree& media_tree = entry_tree.add("Media", "");
-						media_tree.put("VideoFile", videoPath);
-						media_tree.put("SongFile", songPath);
-
-						/** Copy Media File */
-						boost::filesystem::copy_file(videoFile, mediaDirectoryPath + "/" + categoryName + "/" + entryName + "_video" + videoFileExtension, boost::filesystem::copy_option::overwrite_if_exists);
-						boost::filesystem::copy_file(songFile, mediaDirectoryPath + "/" + categoryName + "/" + entryName + "_song" + audioFileExtension, boost::filesystem::copy_option::overwrite_if_exists);
-					}
-				}
-			}
+			QMessageBox::information(parent, "Info", QString("Quiz saved successfully.\nCopied %1 media files (%2 MB) at %3 MB/s%4, %5 files were up to date and %6 were renamed.")
+				.arg(progress.filesDone)
+				.arg(static_cast<double>(progress.bytesDone) / 1e6, 0, 'f', 1)
+				.arg(progress.bytesPerSecond / 1e6, 0, 'f', 1)
+				.arg(backends.isEmpty() ? "" : " using " + backends.join(", "))
+				.arg(progress.filesKept)
+				.arg(progress.filesMoved));
 		}
+		break;
+	case MusicQuiz::util::QuizSaveTask::State::CANCELLED:
+		QMessageBox::information(parent, "Info", "Saving the quiz was cancelled. The quiz was not changed.");
+		break;
+	default:
+		QMessageBox::warning(parent, "Failed to Save Quiz", "Failed to save the quiz. " + QString::fromStdString(task->getError()));
+		break;
+	}
+}
 
-		/** Row Categories */
-		const size_t numberOfRowCategories = data.quizRowCategories.size();
-		for ( size_t i = 0; i < numberOfRowCategories; ++i ) {
-			main_tree.add("QuizRowCategories.RowCategory", data.quizRowCategories[i].toStdString());
-		}
+MusicQuiz::util::QuizSnapshot MusicQuiz::QuizFactory::toSnapshot(const MusicQuiz::QuizCreator::QuizData& data)
+{
+	MusicQuiz::util::QuizSnapshot snapshot;
+	snapshot.quizName = data.quizName.toStdString();
+	snapshot.quizAuthor = data.quizAuthor.toStdString();
+	snapshot.quizDescription = data.quizDescription.toStdString();
+	snapshot.guessTheCategory = data.guessTheCategory;
+	snapshot.guessTheCategoryPoints = data.guessTheCategoryPoints;
 
-		/** Delete Previous Folder */
-		const boost::filesystem::path target(quizPath + "/media");
-		deleteDirectory(target);
-
-		/** Rename tmp folder */
-		boost::filesystem::rename(mediaDirectoryPath, target);
-
-		/** Save Quiz */
-#if ( BOOST_VERSION >= 105600 )
-		boost::property_tree::xml_writer_settings<std::string> settings('\t', 1);
-#elif
-		boost::property_tree::xml_writer_settings<char> settings('\t', 1);
-#endif
-		boost::property_tree::write_xml(quizPath + "/" + quizName + ".quiz.xml", tree, std::locale(), settings);
-
-		/** Create Cheat Sheet */
-		std::ofstream cheatSheet(quizPath + "/" + quizName + ".cheatsheet.txt");
-		if ( cheatSheet.is_open() ) {
-			cheatSheet << "--------------   CHEATSHEET   --------------\n"
-				<< "Quiz: " << quizName << "\n"
-				<< "Guess the Category: " << (data.guessTheCategory ? "Enabled" : "Disabled");
-
-			const std::vector< MusicQuiz::CategoryCreator* > categories = data.quizCategories;
-			for ( size_t i = 0; i < categories.size(); ++i ) {
-				cheatSheet << "\n\n-----  " << categories[i]->getName().toStdString() << "  -----";
-				std::vector< MusicQuiz::EntryCreator* > categoryEntries = data.quizCategories[i]->getEntries();
-				for ( size_t j = 0; j < categoryEntries.size(); ++j ) {
-					cheatSheet << "\n#" << j + 1 << " - " << categoryEntries[j]->getPoints() << " - " << categoryEntries[j]->getName().toStdString();
-				}
+	/** Categories */
+	snapshot.categories.resize(data.quizCategories.size());
+	for ( size_t i = 0; i < data.quizCategories.size(); ++i ) {
+		MusicQuiz::util::QuizSnapshot::Category& category = snapshot.categories[i];
+		category.name = data.quizCategories[i]->getName().toStdString();
+
+		/** Category Entries */
+		const std::vector< MusicQuiz::EntryCreator* > entries = data.quizCategories[i]->getEntries();
+		category.entries.resize(entries.size());
+		for ( size_t j = 0; j < entries.size(); ++j ) {
+			MusicQuiz::EntryCreator* entryCreator = entries[j];
+			MusicQuiz::util::QuizSnapshot::Entry& entry = category.entries[j];
+			entry.name = entryCreator->getName().toStdString();
+			entry.points = entryCreator->getPoints();
+
+			if ( entryCreator->getType() == MusicQuiz::EntryCreator::EntryType::Song ) { // Song
+				entry.type = MusicQuiz::util::QuizSnapshot::EntryType::Song;
+				entry.startTime = entryCreator->getSongStartTime();
+				entry.answerStartTime = entryCreator->getAnswerStartTime();
+				entry.songFile = entryCreator->getSongFile().toStdString();
+			} else if ( entryCreator->getType() == MusicQuiz::EntryCreator::EntryType::Video ) { // Video
+				entry.type = MusicQuiz::util::QuizSnapshot::EntryType::Video;
+				entry.startTime = entryCreator->getVideoStartTime();
+				entry.videoSongStartTime = entryCreator->getVideoSongStartTime();
+				entry.answerStartTime = entryCreator->getVideoAnswerStartTime();
+				entry.videoFile = entryCreator->getVideoFile().toStdString();
+				entry.songFile = entryCreator->getVideoSongFile().toStdString();
 			}
-			cheatSheet.flush();
-			cheatSheet.close();
 		}
+	}
 
-		/** Popup to tell user that the quiz was saved */
-		QMessageBox::information(parent, "Info", "Quiz saves successfully.");
-	} catch ( const std::exception& err ) {
-		QMessageBox::warning(parent, "Failed to Save Quiz", "Failed to save the quiz. " + QString::fromStdString(err.what()));
-		deleteDirectory(mediaDirectoryPath);
-	} catch ( ... ) {
-		QMessageBox::warning(parent, "Failed to Save Quiz", "Failed to save the quiz. Unkown Error.");
-		deleteDirectory(mediaDirectoryPath);
+	/** Row Categories */
+	for ( size_t i = 0; i < data.quizRowCategories.size(); ++i ) {
+		snapshot.rowCategories.push_back(data.quizRowCategories[i].toStdString());
 	}
+	return snapshot;
 }
 
 MusicQuiz::QuizCreator::QuizData MusicQuiz::QuizFactory::loadQuiz(const std::string& quizName, const media::AudioPlayer::Ptr& audioPlayer,
 	QWidget* parent)
 {
-	/** Get List of Quizzes */
-	std::vector<std::string> quizList = MusicQuiz::util::QuizLoader::getListOfQuizzes();
-	if ( quizList.empty() ) {
-		throw std::runtime_error("No quizzes found in the data folder.");
-	}
-
 	/** Check if Quiz Exists */
-	size_t idx = 0;
-	bool quizExists = false;
-	for ( size_t i = 0; i < quizList.size(); ++i ) {
-		std::replace(quizList[i].begin(), quizList[i].end(), '\\', '/');
-		if ( quizName == quizList[i] ) {
-			idx = i;
-			quizExists = true;
-			break;
-		}
-	}
-
-	/** Sanity Check */
-	if ( !quizExists ) {
+	const MusicQuiz::util::QuizId quizId = MusicQuiz::util::QuizCatalog::getQuizId(quizName);
+	if ( !MusicQuiz::util::QuizLoader::getCatalog()->contains(quizId) ) {
 		throw std::runtime_error("Quiz does not exists.");
 	}
 
+	/** Load Quiz */
+	const MusicQuiz::util::QuizDocument::CPtr document = MusicQuiz::util::QuizLoader::loadQuizDocument(quizId);
+
 	/** Quiz Data */
 	MusicQuiz::QuizCreator::QuizData data;
 
-	/** Load Categories */
-	boost::property_tree::ptree tree;
-	boost::property_tree::read_xml(quizList[idx], tree, boost::property_tree::xml_parser::trim_whitespace);
-	boost::property_tree::ptree sub_tree = tree.get_child("MusicQuiz");
-
 	/** Quiz Name */
-	boost::property_tree::ptree::const_iterator ini_ctrl = tree.begin();
-	data.quizName = QString::fromStdString(ini_ctrl->second.get<std::string>("QuizName"));
+	data.quizName = MusicQuiz::util::QuizLoader::toQString(document->quizName);
 
 	/** Quiz Author */
-	data.quizAuthor = QString::fromStdString(ini_ctrl->second.get<std::string>("QuizAuthor"));
+	data.quizAuthor = MusicQuiz::util::QuizLoader::toQString(document->quizAuthor);
 
 	/** Quiz Description */
-	data.quizDescription = QString::fromStdString(ini_ctrl->second.get<std::string>("QuizDescription"));
+	data.quizDescription = MusicQuiz::util::QuizLoader::toQString(document->quizDescription);
 
 	/** Hidden Categories */
-	data.guessTheCategory = ini_ctrl->second.get("QuizGuessTheCategory.<xmlattr>.enabled", false);
+	data.guessTheCategory = document->guessTheCategory;
+
+	/** Media Store */
+	const MusicQuiz::util::MediaStore::Ptr& mediaStore = MusicQuiz::util::QuizLoader::getMediaStore();
+	for ( size_t i = 0; i < document->categories.size() && !data.useMediaStore; ++i ) {
+		const std::vector<MusicQuiz::util::QuizDocument::Entry>& entries = document->categories[i].entries;
+		for ( size_t j = 0; j < entries.size() && !data.useMediaStore; ++j ) {
+			data.useMediaStore = mediaStore->contains(std::string(entries[j].songFile)) || mediaStore->contains(std::string(entries[j].videoFile));
+		}
+	}
 
 	/** Categories */
+	const boost::filesystem::path full_path(boost::filesystem::current_path());
 	std::vector< MusicQuiz::CategoryCreator* > categories;
-	boost::property_tree::ptree::const_iterator ctrl = sub_tree.begin();
-	for ( ; ctrl != sub_tree.end(); ++ctrl ) {
-		if ( ctrl->first == "QuizCategories" ) {
-			boost::property_tree::ptree categoriesTree = ctrl->second;
-			boost::property_tree::ptree::const_iterator sub_ctrl = categoriesTree.begin();
-			try {
-				for ( ; sub_ctrl != categoriesTree.end(); ++sub_ctrl ) {
-					if ( sub_ctrl->first == "Category" ) {
-						/** Category Name */
-						const QString categoryName = QString::fromStdString(sub_ctrl->second.get<std::string>("<xmlattr>.name"));
-
-						/** Category */
-						MusicQuiz::CategoryCreator* category = new MusicQuiz::CategoryCreator(categoryName, audioPlayer, parent);
-
-						/** Category Entries */
-						std::vector< MusicQuiz::EntryCreator* > categorieEntries;
-						boost::property_tree::ptree entryTree = sub_ctrl->second;
-						boost::property_tree::ptree::const_iterator it = entryTree.begin();
-						for ( ; it != entryTree.end(); ++it ) {
-							try {
-								if ( it->first == "QuizEntry" ) {
-									const boost::filesystem::path full_path(boost::filesystem::current_path());
-
-									/** Settings */
-									const QString entryName = QString::fromStdString(it->second.get<std::string>("<xmlattr>.name"));
-									const size_t points = it->second.get<size_t>("Points");
-
-									/** Quiz Entry */
-									MusicQuiz::EntryCreator* entry = new MusicQuiz::EntryCreator(entryName, points, audioPlayer, category);
-
-									/** Media Type */
-									const std::string type = it->second.get<std::string>("<xmlattr>.type");
-									if ( type == "song" ) { // Song
-										entry->setType(MusicQuiz::EntryCreator::EntryType::Song);
-
-										/** Start Time */
-										try {
-											entry->setSongStartTime(it->second.get<size_t>("StartTime"));
-										} catch ( ... ) {}
-
-										try {
-											entry->setAnswerStartTime(it->second.get<size_t>("AnswerStartTime"));
-										} catch ( ... ) {}
-
-										/** Song File */
-										try {
-											QString songFile = QString::fromStdString(full_path.string() + "/" + it->second.get<std::string>("Media.SongFile"));
-											std::replace(songFile.begin(), songFile.end(), '\\', '/');
-											entry->setSongFile(songFile);
-										} catch ( ... ) {}
-									} else if ( type == "video" ) { // Video
-										entry->setType(MusicQuiz::EntryCreator::EntryType::Video);
-
-										/** Song File */
-										try {
-											QString songFile = QString::fromStdString(full_path.string() + "/" + it->second.get<std::string>("Media.SongFile"));
-											std::replace(songFile.begin(), songFile.end(), '\\', '/');
-											entry->setVideoSongFile(songFile);
-										} catch ( ... ) {}
-
-										try {
-											entry->setVideoSongStartTime(it->second.get<size_t>("VideoSongStartTime"));
-										} catch ( ... ) {}
-
-										/** Video File */
-										try {
-											QString videoFile = QString::fromStdString(full_path.string() + "/" + it->second.get<std::string>("Media.VideoFile"));
-											std::replace(videoFile.begin(), videoFile.end(), '\\', '/');
-											entry->setVideoFile(videoFile);
-										} catch ( ... ) {}
-
-										try {
-											entry->setVideoStartTime(it->second.get<size_t>("StartTime"));
-										} catch ( ... ) {}
-
-										try {
-											entry->setVideoAnswerStartTime(it->second.get<size_t>("AnswerStartTime"));
-										} catch ( ... ) {}
-									}
-									categorieEntries.push_back(entry);
-								}
-							} catch ( ... ) {}
-						}
-						category->setEntries(categorieEntries);
-						categories.push_back(category);
-					}
+	for ( size_t i = 0; i < document->categories.size(); ++i ) {
+		const MusicQuiz::util::QuizDocument::Category& categoryDocument = document->categories[i];
+
+		/** Category */
+		const QString categoryName = MusicQuiz::util::QuizLoader::toQString(categoryDocument.name);
+		MusicQuiz::CategoryCreator* category = new MusicQuiz::CategoryCreator(categoryName, audioPlayer, parent);
+
+		/** Category Entries */
+		std::vector< MusicQuiz::EntryCreator* > categorieEntries;
+		for ( size_t j = 0; j < categoryDocument.entries.size(); ++j ) {
+			const MusicQuiz::util::QuizDocument::Entry& entryDocument = categoryDocument.entries[j];
+
+			/** Quiz Entry */
+			const QString entryName = MusicQuiz::util::QuizLoader::toQString(entryDocument.name);
+			MusicQuiz::EntryCreator* entry = new MusicQuiz::EntryCreator(entryName, entryDocument.points, audioPlayer, category);
+
+			/** Media Files */
+			QString songFile = QString::fromStdString(full_path.string() + "/") + MusicQuiz::util::QuizLoader::toQString(entryDocument.songFile);
+			QString videoFile = QString::fromStdString(full_path.string() + "/") + MusicQuiz::util::QuizLoader::toQString(entryDocument.videoFile);
+			std::replace(songFile.begin(), songFile.end(), '\\', '/');
+			std::replace(videoFile.begin(), videoFile.end(), '\\', '/');
+
+			/** Media Type */
+			if ( entryDocument.type == MusicQuiz::util::QuizDocument::EntryType::Song ) { // Song
+				entry->setType(MusicQuiz::EntryCreator::EntryType::Song);
+				entry->setSongStartTime(entryDocument.startTime);
+				entry->setAnswerStartTime(entryDocument.answerStartTime);
+				if ( !entryDocument.songFile.empty() ) {
+					entry->setSongFile(songFile);
+				}
+			} else if ( entryDocument.type == MusicQuiz::util::QuizDocument::EntryType::Video ) { // Video
+				entry->setType(MusicQuiz::EntryCreator::EntryType::Video);
+				entry->setVideoSongStartTime(entryDocument.videoSongStartTime);
+				entry->setVideoStartTime(entryDocument.startTime);
+				entry->setVideoAnswerStartTime(entryDocument.answerStartTime);
+				if ( !entryDocument.songFile.empty() ) {
+					entry->setVideoSongFile(songFile);
+				}
+				if ( !entryDocument.videoFile.empty() ) {
+					entry->setVideoFile(videoFile);
 				}
-			} catch ( const std::exception& err ) {
-				LOG_ERROR("Failed to load quiz. " << err.what());
-			} catch ( ... ) {
-				LOG_ERROR("Failed to load quiz.");
 			}
+			categorieEntries.push_back(entry);
 		}
+		category->setEntries(categorieEntries);
+		categories.push_back(category);
 	}
 	data.quizCategories = categories;
 
 	/** Load Row Categories */
-	data.quizRowCategories = MusicQuiz::util::QuizLoader::loadQuizRowCategories(idx);
+	data.quizRowCategories = MusicQuiz::util::QuizLoader::loadQuizRowCategories(document);
 
 	/** Return */
 	return data;
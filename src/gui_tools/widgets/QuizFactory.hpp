@@ -7,6 +7,10 @@
 
 #include <boost/filesystem.hpp>
 
+#include "util/QuizId.hpp"
+#include "util/QuizModel.hpp"
+#include "util/QuizSnapshot.hpp"
+#include "util/EntryIndex.hpp"
 #include "util/QuizSettings.hpp"
 #include "media/AudioPlayer.hpp"
 #include "media/VideoPlayer.hpp"
@@ -54,7 +58,7 @@ namespace MusicQuiz {
 		/**
 		 * @brief Creates the music quiz.
 		 *
-		 * @param[in] idx The quiz index to load.
+		 * @param[in] quizId The id of the quiz to load.
 		 * @param[in] settings The quiz settings.
 		 * @param[in] audioPlayer The audio player.
 		 * @param[in] videoPlayer The video player
@@ -64,17 +68,62 @@ namespace MusicQuiz {
 		 *
 		 * @return The quiz board.
 		 */
-		static MusicQuiz::QuizBoard* createQuiz(const size_t idx, const MusicQuiz::QuizSettings& settings, const std::shared_ptr< media::AudioPlayer >& audioPlayer,
+		static MusicQuiz::QuizBoard* createQuiz(const MusicQuiz::util::QuizId quizId, const MusicQuiz::QuizSettings& settings, const std::shared_ptr< media::AudioPlayer >& audioPlayer,
 			const std::shared_ptr< media::VideoPlayer >& videoPlayer, const std::vector<MusicQuiz::QuizTeam*>& teams = {}, bool preview = false, QWidget* parent = nullptr);
 
 		/**
-		 * @brief Saves the quiz.
+		 * @brief Creates the music quiz from a loaded model. Only creates the widgets, the model can be loaded on a worker thread.
+		 *
+		 * @param[in] model The quiz model.
+		 * @param[in] settings The quiz settings.
+		 * @param[in] audioPlayer The audio player.
+		 * @param[in] videoPlayer The video player
+		 * @param[in] teams The teams list.
+		 * @param[in] preview If the quiz should be displayed in preview mode.
+		 * @param[in] parent The quiz board parent.
+		 *
+		 * @return The quiz board.
+		 */
+		static MusicQuiz::QuizBoard* createQuiz(const MusicQuiz::util::QuizModel::CPtr& model, const MusicQuiz::QuizSettings& settings, const std::shared_ptr< media::AudioPlayer >& audioPlayer,
+			const std::shared_ptr< media::VideoPlayer >& videoPlayer, const std::vector<MusicQuiz::QuizTeam*>& teams = {}, bool preview = false, QWidget* parent = nullptr);
+
+		/**
+		 * @brief Creates a mix quiz from the entries of all quizzes in the library that match a query.
+		 *
+		 * @param[in] query The query selecting the entries.
+		 * @param[in] numberOfCategories The number of categories on the board.
+		 * @param[in] numberOfEntries The number of entries per category.
+		 * @param[in] settings The quiz settings.
+		 * @param[in] audioPlayer The audio player.
+		 * @param[in] videoPlayer The video player
+		 * @param[in] teams The teams list.
+		 * @param[in] preview If the quiz should be displayed in preview mode.
+		 * @param[in] parent The quiz board parent.
+		 *
+		 * @return The quiz board.
+		 */
+		static MusicQuiz::QuizBoard* createMixQuiz(const MusicQuiz::util::EntryIndex::Query& query, size_t numberOfCategories, size_t numberOfEntries, const MusicQuiz::QuizSettings& settings,
+			const std::shared_ptr< media::AudioPlayer >& audioPlayer, const std::shared_ptr< media::VideoPlayer >& videoPlayer, const std::vector<MusicQuiz::QuizTeam*>& teams = {},
+			bool preview = false, QWidget* parent = nullptr);
+
+		/**
+		 * @brief Saves the quiz. The quiz is checked on the GUI thread and saved on a worker thread, while a progress dialog
+		 *        with a cancel button is shown. Returns once the quiz is saved or the save is cancelled.
 		 *
 		 * @param[in] quizData The quiz data.
 		 * @param[in] parent The quiz board parent.
 		 */
 		static void saveQuiz(const MusicQuiz::QuizCreator::QuizData& data, QWidget* parent = nullptr);
 
+		/**
+		 * @brief Copies the quiz out of the creator widgets. Must be called on the GUI thread.
+		 *
+		 * @param[in] data The quiz data.
+		 *
+		 * @return The quiz snapshot.
+		 */
+		static MusicQuiz::util::QuizSnapshot toSnapshot(const MusicQuiz::QuizCreator::QuizData& data);
+
 		/**
 		 * @brief Loads a quiz.
 		 *
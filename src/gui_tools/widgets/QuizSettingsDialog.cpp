@@ -16,7 +16,7 @@
 
 
 MusicQuiz::QuizSettingsDialog::QuizSettingsDialog(const MusicQuiz::QuizSettings& settings, QWidget* parent) :
-	QDialog(parent)
+	QDialog(parent), _settings(settings)
 {
 	/** Set Window Flags */
 	setWindowFlags(windowFlags() | Qt::WindowMaximizeButtonHint | Qt::WindowMinimizeButtonHint);
@@ -306,7 +306,8 @@ void MusicQuiz::QuizSettingsDialog::setDailyTriplePercentage(int value)
 
 void MusicQuiz::QuizSettingsDialog::saveSettings()
 {
-	MusicQuiz::QuizSettings settings;
+	/** Keep the settings that are not shown in the dialog */
+	MusicQuiz::QuizSettings settings = _settings;
 
 	/** Hidden Anwsers */
 	settings.hiddenAnswers = _hiddenAnswers->isChecked();
@@ -142,6 +142,8 @@ namespace MusicQuiz {
 		void setLayoutEnabled(QLayout* layout, bool enabled);
 
 		/** Variables */
+		const MusicQuiz::QuizSettings _settings;
+
 		QCheckBox* _hiddenTeam = nullptr;
 		QCheckBox* _hiddenAnswers = nullptr;
 
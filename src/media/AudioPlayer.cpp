@@ -3,60 +3,65 @@
 #include <stdexcept>
 
 #include <QVBoxLayout>
-#include <QMediaContent>
 
 #include "common/Log.hpp"
 
 
+namespace {
+	/** One player plays, the others hold the audio of the entries that are likely to be played next */
+	const size_t POOL_SIZE = 4;
+}
+
+
 media::AudioPlayer::AudioPlayer(QWidget* parent) :
 	QWidget(parent)
 {
-	/** Create Media Player */
-	_player = new QMediaPlayer(this);
-	_player->setVolume(100);
+	/** Create Media Players */
+	_pool = new PlayerPool(POOL_SIZE, this);
 }
 
 media::AudioPlayer::~AudioPlayer()
 {
 	/** Stop Audio */
-	_player->stop();
+	stop();
+
+	size_t warm = 0, cold = 0;
+	_pool->getStatistics(warm, cold);
+	if ( warm + cold > 0 ) {
+		LOG_INFO("Played " << warm << " of " << warm + cold << " audio files from a preloaded player.");
+	}
 }
 
 void media::AudioPlayer::play(const QString& audioFile)
+{
+	play(audioFile, 0);
+}
+
+void media::AudioPlayer::play(const QString& audioFile, const size_t startTime)
 {
 	/** Sanity Check */
 	if ( audioFile.isEmpty() ) {
 		throw std::runtime_error("Video File Name is empty.");
 	}
 
-	/** Stop audio if any is playing and close file */
-	stop();
-
-	/** Set Audio File */
-	_player->setMedia(QUrl::fromLocalFile(audioFile));
-
-	/** Play Video */
-	_player->play();
-
-	/** Set State */
-	_state = AudioPlayState::PLAYING;
+	play(MediaSource::fromFile(audioFile), startTime);
 }
 
-void media::AudioPlayer::play(const QString& audioFile, const size_t startTime)
+void media::AudioPlayer::play(const MediaSource& audio, const size_t startTime)
 {
 	/** Sanity Check */
-	if ( audioFile.isEmpty() ) {
-		throw std::runtime_error("Video File Name is empty.");
+	if ( !audio.isValid() ) {
+		throw std::runtime_error("Audio source is empty.");
 	}
 
 	/** Stop audio if any is playing and close file */
 	stop();
 
-	/** Set Audio File */
-	_player->setMedia(QUrl::fromLocalFile(audioFile));
-
-	/** Set Start Time */
-	_player->setPosition(startTime);
+	/** Take a player positioned at the start time, preloaded if the audio was expected */
+	_player = _pool->acquire(audio, startTime);
+	if ( _player == nullptr ) {
+		return;
+	}
 
 	/** Play Audio */
 	_player->play();
@@ -65,6 +70,11 @@ void media::AudioPlayer::play(const QString& audioFile, const size_t startTime)
 	_state = AudioPlayState::PLAYING;
 }
 
+void media::AudioPlayer::preload(const MediaSource& audio, const size_t startTime)
+{
+	_pool->preload(audio, startTime);
+}
+
 void media::AudioPlayer::pause()
 {
 	/** Check State */
@@ -95,9 +105,11 @@ void media::AudioPlayer::resume()
 
 void media::AudioPlayer::stop()
 {
-	/** Stop Video */
-	_player->stop();
-	_player->setMedia(QMediaContent());
+	/** Return the player to the pool, which closes the file */
+	if ( _player != nullptr ) {
+		_pool->release(_player);
+		_player = nullptr;
+	}
 
 	/** Set State */
 	_state = AudioPlayState::IDLE;
@@ -10,6 +10,9 @@
 #include <QMediaPlayer>
 #include <QVideoWidget>
 
+#include "media/PlayerPool.hpp"
+#include "media/MediaSource.hpp"
+
 
 namespace media {
 	class AudioPlayer : public QWidget
@@ -61,6 +64,22 @@ namespace media {
 		 */
 		void play(const QString& audioFile, size_t startTime);
 
+		/**
+		 * @brief Plays audio from a media source.
+		 *
+		 * @param[in] audio The audio to play.
+		 * @param[in] startTime The time at which to start playing the audio file from.
+		 */
+		void play(const MediaSource& audio, size_t startTime);
+
+		/**
+		 * @brief Opens audio that is likely to be played next in an idle player, so playing it only has to start the player.
+		 *
+		 * @param[in] audio The audio.
+		 * @param[in] startTime The time the audio will be played from.
+		 */
+		void preload(const MediaSource& audio, size_t startTime);
+
 		/**
 		 * @brief Pauses the audio that is currently playing.
 		 */
@@ -78,7 +97,10 @@ namespace media {
 	protected:
 
 		/** Variables */
-		QMediaPlayer* _player = nullptr;
+		PlayerPool* _pool = nullptr;
 		AudioPlayState _state = AudioPlayState::IDLE;
+
+		/** The player taken from the pool, nullptr when no audio is playing */
+		QMediaPlayer* _player = nullptr;
 	};
 }
\ No newline at end of file
@@ -0,0 +1,44 @@
+#include "MappedRegionDevice.hpp"
+
+#include <cstring>
+#include <algorithm>
+
+
+media::MappedRegionDevice::MappedRegionDevice(const char* data, const qint64 size, const std::shared_ptr<const void>& owner, QObject* parent) :
+	QIODevice(parent), _data(data), _size(size), _owner(owner)
+{
+}
+
+bool media::MappedRegionDevice::open(const OpenMode mode)
+{
+	if ( mode.testFlag(QIODevice::WriteOnly) ) {
+		return false;
+	}
+	return QIODevice::open(mode | QIODevice::Unbuffered);
+}
+
+bool media::MappedRegionDevice::isSequential() const
+{
+	return false;
+}
+
+qint64 media::MappedRegionDevice::size() const
+{
+	return _size;
+}
+
+qint64 media::MappedRegionDevice::readData(char* data, const qint64 maxSize)
+{
+	const qint64 count = std::min(maxSize, _size - pos());
+	if ( count <= 0 ) {
+		return 0;
+	}
+
+	std::memcpy(data, _data + pos(), static_cast<size_t>(count));
+	return count;
+}
+
+qint64 media::MappedRegionDevice::writeData(const char*, const qint64)
+{
+	return -1;
+}
\ No newline at end of file
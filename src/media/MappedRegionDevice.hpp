@@ -0,0 +1,87 @@
+#pragma once
+
+#include <memory>
+
+#include <QObject>
+#include <QIODevice>
+
+
+namespace media {
+	/**
+	 * @brief Read-only, random access QIODevice over a region of mapped memory.
+	 *
+	 * The device reads straight from the mapping, so players reading the same file share the pages in the OS page cache
+	 * and nothing is copied to a temporary file. The owner of the mapping is kept alive for as long as the device.
+	 */
+	class MappedRegionDevice : public QIODevice
+	{
+		Q_OBJECT
+	public:
+		/**
+		 * @brief Constructor
+		 *
+		 * @param[in] data The first byte of the region.
+		 * @param[in] size The size of the region in bytes.
+		 * @param[in] owner The owner of the mapping.
+		 * @param[in] parent The parent object.
+		 */
+		explicit MappedRegionDevice(const char* data, qint64 size, const std::shared_ptr<const void>& owner, QObject* parent = nullptr);
+
+		/**
+		 * @brief Default destructor
+		 */
+		virtual ~MappedRegionDevice() = default;
+
+		/**
+		 * @brief Deleted the copy and assignment constructor.
+		 */
+		MappedRegionDevice(const MappedRegionDevice&) = delete;
+		MappedRegionDevice& operator=(const MappedRegionDevice&) = delete;
+
+		/**
+		 * @brief Opens the device. Only reading is supported, the device is always unbuffered as the data is in memory already.
+		 *
+		 * @param[in] mode The open mode.
+		 *
+		 * @return False if the mode includes writing.
+		 */
+		bool open(OpenMode mode) override;
+
+		/**
+		 * @brief The device supports seeking.
+		 *
+		 * @return False.
+		 */
+		bool isSequential() const override;
+
+		/**
+		 * @brief Returns the size of the region.
+		 *
+		 * @return The size in bytes.
+		 */
+		qint64 size() const override;
+
+	protected:
+		/**
+		 * @brief Copies data from the current position.
+		 *
+		 * @param[out] data The destination.
+		 * @param[in] maxSize The maximum number of bytes to copy.
+		 *
+		 * @return The number of bytes copied.
+		 */
+		qint64 readData(char* data, qint64 maxSize) override;
+
+		/**
+		 * @brief Writing is not supported.
+		 *
+		 * @return -1.
+		 */
+		qint64 writeData(const char* data, qint64 maxSize) override;
+
+		/** Variables */
+		const char* _data = nullptr;
+		const qint64 _size = 0;
+		std::shared_ptr<const void> _owner = nullptr;
+	};
+}
\ No newline at end of file
@@ -0,0 +1,158 @@
+#include "MediaSource.hpp"
+
+#include <mutex>
+#include <string>
+#include <stdexcept>
+#include <unordered_map>
+
+#include <QUrl>
+
+#include "media/MappedRegionDevice.hpp"
+#include "util/MappedFile.hpp"
+
+
+namespace {
+	std::mutex& getMappedFilesMutex()
+	{
+		static std::mutex mutex;
+		return mutex;
+	}
+
+	/**
+	 * @brief Maps a file, or returns the mapping of the file if it is mapped already.
+	 *
+	 * @param[in] path The path of the file.
+	 *
+	 * @return The mapped file.
+	 */
+	MusicQuiz::util::MappedFile::CPtr mapFile(const std::string& path)
+	{
+		static std::unordered_map< std::string, std::weak_ptr<const MusicQuiz::util::MappedFile> > mappedFiles;
+
+		std::lock_guard<std::mutex> lock(getMappedFilesMutex());
+		const auto it = mappedFiles.find(path);
+		if ( it != mappedFiles.end() ) {
+			const MusicQuiz::util::MappedFile::CPtr mapping = it->second.lock();
+			if ( mapping != nullptr ) {
+				return mapping;
+			}
+		}
+
+		/** Map the file, forgetting the files that are no longer played */
+		const MusicQuiz::util::MappedFile::CPtr mapping = std::make_shared<const MusicQuiz::util::MappedFile>(path);
+		for ( auto jt = mappedFiles.begin(); jt != mappedFiles.end(); ) {
+			if ( jt->second.expired() ) {
+				jt = mappedFiles.erase(jt);
+			} else {
+				++jt;
+			}
+		}
+		mappedFiles[path] = mapping;
+
+		return mapping;
+	}
+}
+
+
+media::MediaSource media::MediaSource::fromFile(const QString& path)
+{
+	MediaSource source;
+	if ( !path.isEmpty() ) {
+		source._type = Type::FILE;
+		source._name = path;
+	}
+	return source;
+}
+
+media::MediaSource media::MediaSource::fromRange(const MusicQuiz::util::QuizPackage::Range& range, const QString& name)
+{
+	MediaSource source;
+	if ( range.isValid() ) {
+		source._type = Type::REGION;
+		source._name = name;
+		source._owner = range.package;
+		source._data = range.getData();
+		source._size = range.size;
+	}
+	return source;
+}
+
+media::MediaSource media::MediaSource::fromMappedFile(const QString& path)
+{
+	MediaSource source;
+	if ( !path.isEmpty() ) {
+		source._type = Type::MAPPED_FILE;
+		source._name = path;
+	}
+	return source;
+}
+
+media::MediaSource::Type media::MediaSource::getType() const
+{
+	return _type;
+}
+
+bool media::MediaSource::isValid() const
+{
+	return _type != Type::NONE;
+}
+
+const QString& media::MediaSource::getName() const
+{
+	return _name;
+}
+
+QMediaContent media::MediaSource::getContent() const
+{
+	switch ( _type )
+	{
+	case Type::FILE:
+	case Type::MAPPED_FILE:
+		return QMediaContent(QUrl::fromLocalFile(_name));
+	case Type::REGION:
+		return QMediaContent(QUrl(_name));
+	default:
+		return QMediaContent();
+	}
+}
+
+QIODevice* media::MediaSource::openDevice(QObject* parent) const
+{
+	/** Region */
+	const char* data = _data;
+	std::uint64_t size = _size;
+	std::shared_ptr<const void> owner = _owner;
+
+	if ( _type == Type::FILE || _type == Type::NONE ) {
+		return nullptr;
+	} else if ( _type == Type::MAPPED_FILE ) {
+		const MusicQuiz::util::MappedFile::CPtr mapping = mapFile(_name.toStdString());
+		data = mapping->getData();
+		size = mapping->getSize();
+		owner = mapping;
+	}
+
+	MappedRegionDevice* device = new MappedRegionDevice(data, static_cast<qint64>(size), owner, parent);
+	if ( !device->open(QIODevice::ReadOnly) ) {
+		delete device;
+		throw std::runtime_error("Failed to open media '" + _name.toStdString() + "'.");
+	}
+	return device;
+}
+
+bool media::MediaSource::operator==(const MediaSource& other) const
+{
+	if ( _type != other._type ) {
+		return false;
+	}
+
+	if ( _type == Type::REGION ) {
+		return _data == other._data && _size == other._size;
+	}
+	return _name == other._name;
+}
+
+bool media::MediaSource::operator!=(const MediaSource& other) const
+{
+	return !(*this == other);
+}
\ No newline at end of file
@@ -0,0 +1,125 @@
+#pragma once
+
+#include <memory>
+#include <cstdint>
+
+#include <QString>
+#include <QObject>
+#include <QIODevice>
+#include <QMediaContent>
+
+#include "util/QuizPackage.hpp"
+
+
+namespace media {
+	/**
+	 * @brief The media a player plays: a local file, a byte range of a mapped quiz package or a mapped file such as a file in the media store.
+	 *
+	 * Mapped media is handed to the player as a MappedRegionDevice, so it is played from memory without extracting it to a file.
+	 * A source is a small value that can be copied, mapped files are only mapped when the source is opened.
+	 */
+	class MediaSource
+	{
+	public:
+		enum class Type
+		{
+			NONE, FILE, REGION, MAPPED_FILE
+		};
+
+		/**
+		 * @brief Default constructor. Creates an empty source.
+		 */
+		MediaSource() = default;
+
+		/**
+		 * @brief Default destructor
+		 */
+		virtual ~MediaSource() = default;
+
+		/**
+		 * @brief Creates a source that plays a local file through its path.
+		 *
+		 * @param[in] path The path of the file.
+		 *
+		 * @return The media source.
+		 */
+		static MediaSource fromFile(const QString& path);
+
+		/**
+		 * @brief Creates a source that plays a media file stored in a quiz package.
+		 *
+		 * @param[in] range The byte range of the file in the package.
+		 * @param[in] name The name of the file, used as a hint of the format.
+		 *
+		 * @return The media source. Empty if the range is invalid.
+		 */
+		static MediaSource fromRange(const MusicQuiz::util::QuizPackage::Range& range, const QString& name);
+
+		/**
+		 * @brief Creates a source that maps a local file when it is played.
+		 *        Mappings are shared, a file played by several players is mapped once.
+		 *
+		 * @param[in] path The path of the file.
+		 *
+		 * @return The media source.
+		 */
+		static MediaSource fromMappedFile(const QString& path);
+
+		/**
+		 * @brief Returns the type of the source.
+		 *
+		 * @return The type.
+		 */
+		Type getType() const;
+
+		/**
+		 * @brief Checks if the source refers to any media.
+		 *
+		 * @return False if the source is empty.
+		 */
+		bool isValid() const;
+
+		/**
+		 * @brief Returns the path or name of the media.
+		 *
+		 * @return The name.
+		 */
+		const QString& getName() const;
+
+		/**
+		 * @brief Returns the media content to pass to the player. For mapped media the content is only a hint of the format.
+		 *
+		 * @return The media content.
+		 */
+		QMediaContent getContent() const;
+
+		/**
+		 * @brief Opens a device that reads the mapped media.
+		 *
+		 * @param[in] parent The parent of the device.
+		 *
+		 * @return The opened device, or nullptr if the media is played through its path.
+		 */
+		QIODevice* openDevice(QObject* parent) const;
+
+		/**
+		 * @brief Checks if two sources refer to the same media.
+		 *
+		 * @param[in] other The other source.
+		 *
+		 * @return True if the sources are equal.
+		 */
+		bool operator==(const MediaSource& other) const;
+		bool operator!=(const MediaSource& other) const;
+
+	protected:
+		/** Variables */
+		Type _type = Type::NONE;
+		QString _name = "";
+
+		/** Mapped region and the object that keeps it mapped */
+		std::shared_ptr<const void> _owner = nullptr;
+		const char* _data = nullptr;
+		std::uint64_t _size = 0;
+	};
+}
\ No newline at end of file
@@ -0,0 +1,156 @@
+#include "PlayerPool.hpp"
+
+#include <algorithm>
+#include <stdexcept>
+
+#include <QMediaContent>
+
+#include "common/Log.hpp"
+
+
+media::PlayerPool::PlayerPool(const size_t size, QObject* parent) :
+	QObject(parent)
+{
+	/** Sanity Check */
+	if ( size < 2 ) {
+		throw std::runtime_error("Player pool needs at least two players.");
+	}
+
+	/** Create Media Players */
+	_slots.resize(size);
+	for ( size_t i = 0; i < _slots.size(); ++i ) {
+		_slots[i].player = new QMediaPlayer(this);
+		_slots[i].player->setVolume(100);
+	}
+}
+
+media::PlayerPool::~PlayerPool()
+{
+	/** Stop Players */
+	for ( size_t i = 0; i < _slots.size(); ++i ) {
+		_slots[i].player->stop();
+	}
+}
+
+void media::PlayerPool::preload(const MediaSource& source, const size_t startTime)
+{
+	/** Sanity Check */
+	if ( !source.isValid() ) {
+		return;
+	}
+
+	/** Keep warm media at the front of the queue */
+	Slot* slot = findWarm(source, startTime);
+	if ( slot != nullptr ) {
+		slot->lastUsed = ++_clock;
+		return;
+	}
+
+	slot = findIdle();
+	if ( slot != nullptr ) {
+		load(*slot, source, startTime);
+	}
+}
+
+QMediaPlayer* media::PlayerPool::acquire(const MediaSource& source, const size_t startTime)
+{
+	/** Warm Player */
+	Slot* slot = findWarm(source, startTime);
+	if ( slot != nullptr && slot->player->error() == QMediaPlayer::NoError ) {
+		++_warm;
+	} else {
+		/** Cold Player */
+		slot = findIdle();
+		if ( slot == nullptr ) {
+			LOG_ERROR("All media players are in use.");
+			return nullptr;
+		}
+
+		if ( !load(*slot, source, startTime) ) {
+			return nullptr;
+		}
+		++_cold;
+	}
+
+	slot->inUse = true;
+	slot->lastUsed = ++_clock;
+	return slot->player;
+}
+
+void media::PlayerPool::release(QMediaPlayer* player)
+{
+	for ( size_t i = 0; i < _slots.size(); ++i ) {
+		if ( _slots[i].player == player ) {
+			unload(_slots[i]);
+			_slots[i].inUse = false;
+			return;
+		}
+	}
+}
+
+void media::PlayerPool::getStatistics(size_t& warm, size_t& cold) const
+{
+	warm = _warm;
+	cold = _cold;
+}
+
+bool media::PlayerPool::load(Slot& slot, const MediaSource& source, const size_t startTime)
+{
+	unload(slot);
+
+	/** Open Media, mapped media is read through a device */
+	try {
+		slot.device = source.openDevice(this);
+	} catch ( const std::exception& err ) {
+		LOG_ERROR("Failed to open '" << source.getName().toStdString() << "'. " << err.what());
+		return false;
+	}
+
+	slot.player->setMedia(source.getContent(), slot.device);
+	slot.source = source;
+	slot.startTime = startTime;
+	slot.lastUsed = ++_clock;
+
+	/** Pausing makes the player load the media and buffer it at the start time without playing */
+	slot.player->setPosition(startTime);
+	slot.player->pause();
+
+	return true;
+}
+
+void media::PlayerPool::unload(Slot& slot)
+{
+	if ( !slot.source.isValid() ) {
+		return;
+	}
+
+	slot.player->stop();
+	slot.player->setMedia(QMediaContent());
+	if ( slot.device != nullptr ) {
+		slot.device->deleteLater();
+		slot.device = nullptr;
+	}
+	slot.source = MediaSource();
+	slot.startTime = 0;
+}
+
+media::PlayerPool::Slot* media::PlayerPool::findWarm(const MediaSource& source, const size_t startTime)
+{
+	for ( size_t i = 0; i < _slots.size(); ++i ) {
+		if ( !_slots[i].inUse && _slots[i].startTime == startTime && _slots[i].source.isValid() && _slots[i].source == source ) {
+			return &_slots[i];
+		}
+	}
+	return nullptr;
+}
+
+media::PlayerPool::Slot* media::PlayerPool::findIdle()
+{
+	Slot* idle = nullptr;
+	for ( size_t i = 0; i < _slots.size(); ++i ) {
+		if ( !_slots[i].inUse && (idle == nullptr || _slots[i].lastUsed < idle->lastUsed) ) {
+			idle = &_slots[i];
+		}
+	}
+	return idle;
+}
\ No newline at end of file
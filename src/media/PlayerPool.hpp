@@ -0,0 +1,133 @@
+#pragma once
+
+#include <vector>
+#include <cstdint>
+
+#include <QObject>
+#include <QIODevice>
+#include <QMediaPlayer>
+
+#include "media/MediaSource.hpp"
+
+
+namespace media {
+	/**
+	 * @brief Pool of media players that are opened and positioned before they are played.
+	 *
+	 * Opening a media file, probing it and seeking to the start time takes long enough to be heard when a tile is clicked.
+	 * Media that is likely to be played next is preloaded into an idle player of the pool, which is paused at the start time.
+	 * Playing that media then only has to start the warm player. Idle players are reused in least recently used order.
+	 */
+	class PlayerPool : public QObject
+	{
+		Q_OBJECT
+	public:
+		/**
+		 * @brief Constructor
+		 *
+		 * @param[in] size The number of players. At least two, one playing and one warm.
+		 * @param[in] parent The parent object.
+		 */
+		explicit PlayerPool(size_t size, QObject* parent = nullptr);
+
+		/**
+		 * @brief Destructor. Stops all players.
+		 */
+		virtual ~PlayerPool();
+
+		/**
+		 * @brief Deleted the copy and assignment constructor.
+		 */
+		PlayerPool(const PlayerPool&) = delete;
+		PlayerPool& operator=(const PlayerPool&) = delete;
+
+		/**
+		 * @brief Opens media in an idle player and pauses it at the start time. Does nothing if the media is warm already.
+		 *
+		 * @param[in] source The media.
+		 * @param[in] startTime The start time in [ms].
+		 */
+		void preload(const MediaSource& source, size_t startTime);
+
+		/**
+		 * @brief Takes a player that is positioned at the start time of the media. A warm player is used if there is one,
+		 *        otherwise the media is opened in the least recently used idle player.
+		 *
+		 * @param[in] source The media.
+		 * @param[in] startTime The start time in [ms].
+		 *
+		 * @return The player, ready to play. nullptr if the media could not be opened or all players are in use.
+		 */
+		QMediaPlayer* acquire(const MediaSource& source, size_t startTime);
+
+		/**
+		 * @brief Stops a player taken by acquire and returns it to the pool.
+		 *
+		 * @param[in] player The player.
+		 */
+		void release(QMediaPlayer* player);
+
+		/**
+		 * @brief Returns the number of acquired players that were warm and cold.
+		 *
+		 * @param[out] warm The number of warm players.
+		 * @param[out] cold The number of players that had to open the media.
+		 */
+		void getStatistics(size_t& warm, size_t& cold) const;
+
+	protected:
+		struct Slot
+		{
+			QMediaPlayer* player = nullptr;
+			QIODevice* device = nullptr;
+
+			MediaSource source;
+			size_t startTime = 0;
+
+			bool inUse = false;
+			std::uint64_t lastUsed = 0;
+		};
+
+		/**
+		 * @brief Opens media in a slot and positions it at the start time.
+		 *
+		 * @param[in,out] slot The slot.
+		 * @param[in] source The media.
+		 * @param[in] startTime The start time in [ms].
+		 *
+		 * @return False if the media could not be opened.
+		 */
+		bool load(Slot& slot, const MediaSource& source, size_t startTime);
+
+		/**
+		 * @brief Stops the player of a slot and closes its media.
+		 *
+		 * @param[in,out] slot The slot.
+		 */
+		void unload(Slot& slot);
+
+		/**
+		 * @brief Finds the idle slot that holds media at a start time.
+		 *
+		 * @param[in] source The media.
+		 * @param[in] startTime The start time in [ms].
+		 *
+		 * @return The slot, or nullptr if the media is not warm.
+		 */
+		Slot* findWarm(const MediaSource& source, size_t startTime);
+
+		/**
+		 * @brief Finds the idle slot that was used least recently.
+		 *
+		 * @return The slot, or nullptr if all players are in use.
+		 */
+		Slot* findIdle();
+
+		/** Variables */
+		std::vector<Slot> _slots;
+		std::uint64_t _clock = 0;
+
+		size_t _warm = 0;
+		size_t _cold = 0;
+	};
+}
\ No newline at end of file
@@ -86,6 +86,42 @@ void media::VideoPlayer::play(const QString& videoFile, const size_t startTime,
 	_state = VideoPlayState::PLAYING;
 }
 
+void media::VideoPlayer::play(const MediaSource& video, const size_t startTime, bool muted)
+{
+	/** Sanity Check */
+	if ( !video.isValid() ) {
+		throw std::runtime_error("Video source is empty.");
+	}
+
+	/** Stop video if any is playing and close file */
+	stop();
+
+	/** Set Video Source, mapped media is read through a device */
+	try {
+		_device = video.openDevice(this);
+	} catch ( const std::exception& err ) {
+		LOG_ERROR("Failed to play '" << video.getName().toStdString() << "'. " << err.what());
+		return;
+	}
+	_player->setMedia(video.getContent(), _device);
+
+	/** Set Volume */
+	if ( muted ) {
+		_player->setVolume(0);
+	} else {
+		_player->setVolume(100);
+	}
+
+	/** Set Start Time */
+	_player->setPosition(startTime);
+
+	/** Play Video */
+	_player->play();
+
+	/** Set State */
+	_state = VideoPlayState::PLAYING;
+}
+
 void media::VideoPlayer::pause()
 {
 	/** Check State */
@@ -120,6 +156,12 @@ void media::VideoPlayer::stop()
 	_player->stop();
 	_player->setMedia(QMediaContent());
 
+	/** Release the mapped media */
+	if ( _device != nullptr ) {
+		_device->deleteLater();
+		_device = nullptr;
+	}
+
 	/** Set State */
 	_state = VideoPlayState::IDLE;
 }
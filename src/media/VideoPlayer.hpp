@@ -10,6 +10,8 @@
 #include <QMediaPlayer>
 #include <QVideoWidget>
 
+#include "media/MediaSource.hpp"
+
 
 
 namespace media {
@@ -64,6 +66,15 @@ namespace media {
 		 */
 		void play(const QString& videoFile, size_t startTime, bool muted = false);
 
+		/**
+		 * @brief Plays a video from a media source.
+		 *
+		 * @param[in] video The video to play.
+		 * @param[in] startTime The time at which to start playing the video file from.
+		 * @param[in] muted True if the audio should be muted.
+		 */
+		void play(const MediaSource& video, size_t startTime, bool muted = false);
+
 		/**
 		 * @brief Pauses the video that is currently playing.
 		 */
@@ -112,6 +123,9 @@ namespace media {
 		QVideoWidget* _videoWidget = nullptr;
 		VideoPlayState _state = VideoPlayState::IDLE;
 
+		/** Device reading mapped media, nullptr when a file is played */
+		QIODevice* _device = nullptr;
+
 		std::function< void(QMouseEvent*) > _mouseEventCallback;
 	};
 }
\ No newline at end of file
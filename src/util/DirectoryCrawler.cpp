@@ -0,0 +1,128 @@
+#include "DirectoryCrawler.hpp"
+
+#include <thread>
+#include <vector>
+#include <algorithm>
+
+#include <boost/filesystem.hpp>
+
+
+double MusicQuiz::util::DirectoryCrawler::Statistics::getDirectoriesPerSecond() const
+{
+	if ( elapsed.count() <= 0 ) {
+		return 0.0;
+	}
+	return static_cast<double>(directories) * 1e6 / static_cast<double>(elapsed.count());
+}
+
+MusicQuiz::util::DirectoryCrawler::DirectoryCrawler(const size_t maxConcurrency) :
+	_maxConcurrency(std::max(maxConcurrency, static_cast<size_t>(1)))
+{
+}
+
+void MusicQuiz::util::DirectoryCrawler::setFolderFilter(const FolderFilter& filter)
+{
+	_folderFilter = filter;
+}
+
+void MusicQuiz::util::DirectoryCrawler::setFileFilter(const FileFilter& filter)
+{
+	_fileFilter = filter;
+}
+
+MusicQuiz::util::DirectoryCrawler::Statistics MusicQuiz::util::DirectoryCrawler::crawl(const std::string& root, const FileCallback& callback)
+{
+	const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+
+	/** Reset */
+	{
+		std::lock_guard<std::mutex> lock(_mutex);
+		_queue.clear();
+		_queue.push_back(root);
+		_active = 0;
+		_statistics = Statistics();
+	}
+
+	/** Crawl */
+	std::vector<std::thread> threads;
+	for ( size_t i = 1; i < _maxConcurrency; ++i ) {
+		threads.emplace_back(&DirectoryCrawler::worker, this, std::cref(callback));
+	}
+	worker(callback);
+
+	for ( size_t i = 0; i < threads.size(); ++i ) {
+		threads[i].join();
+	}
+
+	std::lock_guard<std::mutex> lock(_mutex);
+	_statistics.elapsed = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start);
+	return _statistics;
+}
+
+void MusicQuiz::util::DirectoryCrawler::worker(const FileCallback& callback)
+{
+	std::unique_lock<std::mutex> lock(_mutex);
+	while ( true ) {
+		/** Wait for a folder, the crawl is done when the queue is empty and no folder is being read */
+		_condition.wait(lock, [this]() {
+			return !_queue.empty() || _active == 0;
+		});
+		if ( _queue.empty() ) {
+			break;
+		}
+
+		const std::string folder = _queue.front();
+		_queue.pop_front();
+		++_active;
+
+		lock.unlock();
+		listFolder(folder, callback);
+		lock.lock();
+
+		--_active;
+		_condition.notify_all();
+	}
+}
+
+void MusicQuiz::util::DirectoryCrawler::listFolder(const std::string& folder, const FileCallback& callback)
+{
+	std::vector<std::string> folders;
+	size_t files = 0, matches = 0;
+
+	boost::system::error_code err;
+	boost::filesystem::directory_iterator it(folder, err), end;
+	const bool failed = static_cast<bool>(err);
+	for ( ; !err && it != end; it.increment(err) ) {
+		const std::string name = it->path().filename().string();
+		const std::string path = (folder.empty() || folder.back() == '/') ? folder + name : folder + "/" + name;
+
+		/** Links to folders are not followed, a link to a parent folder would make the crawl loop forever */
+		boost::system::error_code statusErr;
+		const boost::filesystem::file_status status = it->symlink_status(statusErr);
+		if ( boost::filesystem::is_directory(status) ) {
+			if ( !_folderFilter || _folderFilter(name) ) {
+				folders.push_back(path);
+			}
+			continue;
+		} else if ( boost::filesystem::is_symlink(status) && boost::filesystem::is_directory(it->status(statusErr)) ) {
+			continue;
+		}
+
+		++files;
+		if ( !_fileFilter || _fileFilter(path) ) {
+			++matches;
+			callback(path);
+		}
+	}
+
+	/** Queue Sub Folders */
+	std::lock_guard<std::mutex> lock(_mutex);
+	++_statistics.directories;
+	_statistics.files += files;
+	_statistics.matches += matches;
+	if ( failed || err ) {
+		++_statistics.errors;
+	}
+	_queue.insert(_queue.end(), folders.begin(), folders.end());
+	_condition.notify_all();
+}
\ No newline at end of file
@@ -0,0 +1,128 @@
+#pragma once
+
+#include <deque>
+#include <mutex>
+#include <string>
+#include <chrono>
+#include <functional>
+#include <condition_variable>
+
+
+namespace MusicQuiz {
+	namespace util {
+		/**
+		 * @brief Lists a directory tree with a bounded number of directories read in parallel.
+		 *
+		 * Reading a directory on a network filesystem is a round trip, so the sub folders are read concurrently.
+		 * Folders rejected by the folder filter are not entered, and neither are symbolic links to folders, which could form a cycle.
+		 * Matching files are passed to the callback as they are found.
+		 */
+		class DirectoryCrawler
+		{
+		public:
+			struct Statistics
+			{
+				size_t directories = 0;
+				size_t files = 0;
+				size_t matches = 0;
+				size_t errors = 0;
+				std::chrono::microseconds elapsed = std::chrono::microseconds(0);
+
+				/**
+				 * @brief Returns the number of directories read per second.
+				 *
+				 * @return The directories per second.
+				 */
+				double getDirectoriesPerSecond() const;
+			};
+
+			/**
+			 * @brief Decides if a folder is entered, given the folder name.
+			 */
+			typedef std::function<bool(const std::string& folderName)> FolderFilter;
+
+			/**
+			 * @brief Decides if a file is passed to the callback, given the file path.
+			 */
+			typedef std::function<bool(const std::string& path)> FileFilter;
+
+			/**
+			 * @brief Called with the path of each matching file. Called from the crawler threads concurrently,
+			 *        the callback must lock what it shares itself.
+			 */
+			typedef std::function<void(const std::string& path)> FileCallback;
+
+			/**
+			 * @brief Constructor
+			 *
+			 * @param[in] maxConcurrency The maximum number of directories read at the same time.
+			 */
+			explicit DirectoryCrawler(size_t maxConcurrency = DEFAULT_CONCURRENCY);
+
+			/**
+			 * @brief Default destructor
+			 */
+			virtual ~DirectoryCrawler() = default;
+
+			/**
+			 * @brief Deleted the copy and assignment constructor.
+			 */
+			DirectoryCrawler(const DirectoryCrawler&) = delete;
+			DirectoryCrawler& operator=(const DirectoryCrawler&) = delete;
+
+			/**
+			 * @brief Sets the filter deciding which folders are entered. All folders are entered by default.
+			 *
+			 * @param[in] filter The folder filter.
+			 */
+			void setFolderFilter(const FolderFilter& filter);
+
+			/**
+			 * @brief Sets the filter deciding which files are passed to the callback. All files are passed by default.
+			 *
+			 * @param[in] filter The file filter.
+			 */
+			void setFileFilter(const FileFilter& filter);
+
+			/**
+			 * @brief Crawls a directory tree. Returns when the whole tree has been listed.
+			 *
+			 * @param[in] root The folder to start in. File paths are formed by appending '/' and the names to it.
+			 * @param[in] callback Called with each matching file.
+			 *
+			 * @return The crawl statistics.
+			 */
+			Statistics crawl(const std::string& root, const FileCallback& callback);
+
+			/** Default number of directories read at the same time */
+			static const size_t DEFAULT_CONCURRENCY = 8;
+
+		protected:
+			/**
+			 * @brief Takes folders from the queue and lists them until the whole tree is done.
+			 *
+			 * @param[in] callback Called with each matching file.
+			 */
+			void worker(const FileCallback& callback);
+
+			/**
+			 * @brief Lists a single folder.
+			 *
+			 * @param[in] folder The folder.
+			 * @param[in] callback Called with each matching file.
+			 */
+			void listFolder(const std::string& folder, const FileCallback& callback);
+
+			/** Variables */
+			const size_t _maxConcurrency;
+			FolderFilter _folderFilter = nullptr;
+			FileFilter _fileFilter = nullptr;
+
+			std::mutex _mutex;
+			std::condition_variable _condition;
+			std::deque<std::string> _queue;
+			size_t _active = 0;
+			Statistics _statistics;
+		};
+	}
+}
\ No newline at end of file
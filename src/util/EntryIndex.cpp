@@ -0,0 +1,437 @@
+#include "EntryIndex.hpp"
+
+#include <cctype>
+#include <fstream>
+#include <algorithm>
+#include <stdexcept>
+#include <unordered_set>
+
+#include "common/Log.hpp"
+
+
+namespace {
+	/** Version of the play history file format. Bump when the layout changes. */
+	const std::string HISTORY_HEADER = "MusicQuizPlayHistory";
+	const size_t HISTORY_VERSION = 1;
+
+	/** 64-bit FNV-1a parameters */
+	const std::uint64_t FNV_OFFSET_BASIS = 14695981039346656037ULL;
+	const std::uint64_t FNV_PRIME = 1099511628211ULL;
+
+	std::uint64_t hashBytes(std::uint64_t hash, const char* data, const size_t size)
+	{
+		for ( size_t i = 0; i < size; ++i ) {
+			hash ^= static_cast<unsigned char>(data[i]);
+			hash *= FNV_PRIME;
+		}
+		return hash;
+	}
+
+	std::string toLower(const std::string_view str)
+	{
+		std::string lower(str);
+		for ( size_t i = 0; i < lower.size(); ++i ) {
+			lower[i] = static_cast<char>(std::tolower(static_cast<unsigned char>(lower[i])));
+		}
+		return lower;
+	}
+
+	/**
+	 * @brief Removes the rows from the selection whose string does not contain the pattern.
+	 *        Each distinct string is only matched once.
+	 *
+	 * @param[in,out] selection The selected rows.
+	 * @param[in] column The string column.
+	 * @param[in] strings The string pool.
+	 * @param[in] pattern The lower case pattern.
+	 */
+	void filterText(std::vector<size_t>& selection, const std::vector<std::uint32_t>& column, const std::vector<std::string_view>& strings, const std::string& pattern)
+	{
+		/** Match result per string id */
+		std::unordered_map<std::uint32_t, bool> matches;
+
+		size_t count = 0;
+		for ( size_t i = 0; i < selection.size(); ++i ) {
+			const std::uint32_t stringId = column[selection[i]];
+			std::unordered_map<std::uint32_t, bool>::const_iterator it = matches.find(stringId);
+			if ( it == matches.end() ) {
+				it = matches.emplace(stringId, toLower(strings[stringId]).find(pattern) != std::string::npos).first;
+			}
+			if ( it->second ) {
+				selection[count++] = selection[i];
+			}
+		}
+		selection.resize(count);
+	}
+}
+
+
+MusicQuiz::util::EntryIndex::EntryIndex(const boost::filesystem::path& historyFile) :
+	_historyFile(historyFile), _arena(std::make_unique<StringArena>())
+{
+}
+
+MusicQuiz::util::EntryIndex::~EntryIndex()
+{
+	saveHistory();
+}
+
+size_t MusicQuiz::util::EntryIndex::update(const QuizCatalog& catalog, const DocumentReader& reader, const ProgressCallback& progress)
+{
+	std::lock_guard<std::mutex> updateLock(_updateMutex);
+
+	/** Compare the catalog with the indexed file versions */
+	std::unordered_map<QuizId, Segment> keep;
+	std::vector<QuizCatalog::Entry> changed;
+	{
+		std::lock_guard<std::mutex> lock(_mutex);
+		const std::vector<std::string> quizList = catalog.getQuizList();
+		for ( size_t i = 0; i < quizList.size(); ++i ) {
+			const QuizId quizId = QuizCatalog::getQuizId(quizList[i]);
+			QuizCatalog::Entry entry;
+			try {
+				entry = catalog.getEntry(quizId);
+			} catch ( const std::exception& ) {
+				continue;
+			}
+
+			const std::unordered_map<QuizId, Segment>::const_iterator it = _segments.find(quizId);
+			if ( it != _segments.end() && it->second.lastWriteTime == entry.lastWriteTime && it->second.fileSize == entry.fileSize ) {
+				keep.emplace(quizId, it->second);
+			} else {
+				changed.push_back(std::move(entry));
+			}
+		}
+
+		if ( changed.empty() && keep.size() == _segments.size() ) {
+			return 0;
+		}
+	}
+
+	/** Read the changed quizzes without blocking queries */
+	std::vector<QuizDocument::CPtr> documents(changed.size());
+	for ( size_t i = 0; i < changed.size(); ++i ) {
+		if ( progress && !progress(i, changed.size()) ) {
+			return 0;
+		}
+
+		try {
+			documents[i] = changed[i].document != nullptr ? changed[i].document : reader(changed[i].path);
+		} catch ( const std::exception& err ) {
+			LOG_WARN("Failed to index quiz '" << changed[i].path << "'. " << err.what());
+		}
+	}
+
+	/** Replace the entries of the changed quizzes */
+	std::lock_guard<std::mutex> lock(_mutex);
+	compact(keep);
+	for ( size_t i = 0; i < changed.size(); ++i ) {
+		/** Quizzes that fail to load are remembered as empty, such that they are only read again when the file changes */
+		Segment segment;
+		segment.lastWriteTime = changed[i].lastWriteTime;
+		segment.fileSize = changed[i].fileSize;
+		_segments[changed[i].id] = segment;
+
+		if ( documents[i] != nullptr ) {
+			append(changed[i].id, *documents[i]);
+		}
+	}
+	compactStrings();
+
+	return changed.size();
+}
+
+std::vector<MusicQuiz::util::EntryIndex::Row> MusicQuiz::util::EntryIndex::query(const Query& query) const
+{
+	std::lock_guard<std::mutex> lock(_mutex);
+
+	/** Numeric columns first, they are the cheapest to filter on */
+	std::vector<size_t> selection;
+	for ( size_t i = 0; i < _points.size(); ++i ) {
+		const bool video = _types[i] == static_cast<std::uint8_t>(EntryType::Video);
+		if ( _points[i] >= query.minPoints && _points[i] <= query.maxPoints && (video ? query.includeVideos : query.includeSongs) ) {
+			selection.push_back(i);
+		}
+	}
+
+	/** Quizzes */
+	if ( !query.quizzes.empty() ) {
+		const std::unordered_set<QuizId> quizzes(query.quizzes.begin(), query.quizzes.end());
+		size_t count = 0;
+		for ( size_t i = 0; i < selection.size(); ++i ) {
+			if ( quizzes.count(_quizIds[selection[i]]) > 0 ) {
+				selection[count++] = selection[i];
+			}
+		}
+		selection.resize(count);
+	}
+
+	/** Play History */
+	if ( query.notPlayedSince != 0 ) {
+		size_t count = 0;
+		for ( size_t i = 0; i < selection.size(); ++i ) {
+			if ( _lastPlayed[selection[i]] < query.notPlayedSince ) {
+				selection[count++] = selection[i];
+			}
+		}
+		selection.resize(count);
+	}
+
+	/** Text */
+	if ( !query.category.empty() ) {
+		filterText(selection, _categories, _strings, toLower(query.category));
+	}
+	if ( !query.answer.empty() ) {
+		filterText(selection, _answers, _strings, toLower(query.answer));
+	}
+
+	/** Results */
+	std::vector<Row> rows(std::min(selection.size(), query.limit));
+	for ( size_t i = 0; i < rows.size(); ++i ) {
+		const size_t idx = selection[i];
+		Row& row = rows[i];
+		row.key = _keys[idx];
+		row.quizId = _quizIds[idx];
+		row.category = std::string(_strings[_categories[idx]]);
+		row.name = std::string(_strings[_names[idx]]);
+		row.answer = std::string(_strings[_answers[idx]]);
+		row.type = static_cast<EntryType>(_types[idx]);
+		row.points = _points[idx];
+		row.startTime = _startTimes[idx];
+		row.answerStartTime = _answerStartTimes[idx];
+		row.videoSongStartTime = _videoSongStartTimes[idx];
+		row.songFile = std::string(_strings[_songFiles[idx]]);
+		row.videoFile = std::string(_strings[_videoFiles[idx]]);
+		row.lastPlayed = _lastPlayed[idx];
+	}
+
+	return rows;
+}
+
+size_t MusicQuiz::util::EntryIndex::size() const
+{
+	std::lock_guard<std::mutex> lock(_mutex);
+	return _keys.size();
+}
+
+void MusicQuiz::util::EntryIndex::markPlayed(const EntryKey key, const std::time_t time)
+{
+	std::lock_guard<std::mutex> lock(_mutex);
+	_history[key] = time;
+	_historyDirty = true;
+
+	for ( size_t i = 0; i < _keys.size(); ++i ) {
+		if ( _keys[i] == key ) {
+			_lastPlayed[i] = time;
+		}
+	}
+}
+
+void MusicQuiz::util::EntryIndex::loadHistory()
+{
+	std::lock_guard<std::mutex> lock(_mutex);
+	_history.clear();
+	_historyDirty = false;
+
+	std::ifstream in(_historyFile.string(), std::ios::binary);
+	if ( in.is_open() ) {
+		std::string header;
+		size_t version = 0, count = 0;
+		if ( !(in >> header >> version >> count) || header != HISTORY_HEADER || version != HISTORY_VERSION ) {
+			LOG_INFO("Ignoring play history '" << _historyFile.string() << "' with unknown format.");
+		} else {
+			for ( size_t i = 0; i < count; ++i ) {
+				EntryKey key = 0;
+				std::time_t time = 0;
+				if ( !(in >> key >> time) ) {
+					LOG_ERROR("Failed to load play history. Truncated file.");
+					_history.clear();
+					break;
+				}
+				_history[key] = time;
+			}
+		}
+	}
+
+	for ( size_t i = 0; i < _keys.size(); ++i ) {
+		const std::unordered_map<EntryKey, std::time_t>::const_iterator it = _history.find(_keys[i]);
+		_lastPlayed[i] = it != _history.end() ? it->second : 0;
+	}
+}
+
+void MusicQuiz::util::EntryIndex::saveHistory()
+{
+	std::lock_guard<std::mutex> lock(_mutex);
+	if ( !_historyDirty ) {
+		return;
+	}
+
+	/** Write to a temporary file and replace the history when done */
+	const std::string tmpFile = _historyFile.string() + ".tmp";
+	{
+		std::ofstream out(tmpFile, std::ios::binary | std::ios::trunc);
+		if ( !out.is_open() ) {
+			LOG_ERROR("Failed to write play history '" << tmpFile << "'.");
+			return;
+		}
+
+		out << HISTORY_HEADER << ' ' << HISTORY_VERSION << '\n' << _history.size() << '\n';
+		for ( std::unordered_map<EntryKey, std::time_t>::const_iterator it = _history.begin(); it != _history.end(); ++it ) {
+			out << it->first << ' ' << it->second << '\n';
+		}
+
+		out.flush();
+		if ( !out ) {
+			LOG_ERROR("Failed to write play history '" << tmpFile << "'.");
+			return;
+		}
+	}
+
+	boost::system::error_code err;
+	boost::filesystem::rename(tmpFile, _historyFile, err);
+	if ( err ) {
+		LOG_ERROR("Failed to replace play history. " << err.message());
+		return;
+	}
+	_historyDirty = false;
+}
+
+MusicQuiz::util::EntryIndex::EntryKey MusicQuiz::util::EntryIndex::getEntryKey(const QuizId quizId, const std::string_view category, const std::string_view answer)
+{
+	const char separator = '\0';
+	std::uint64_t hash = FNV_OFFSET_BASIS;
+	for ( size_t i = 0; i < sizeof(quizId); ++i ) {
+		const char byte = static_cast<char>((quizId >> (8 * i)) & 0xFF);
+		hash = hashBytes(hash, &byte, 1);
+	}
+	hash = hashBytes(hash, category.data(), category.size());
+	hash = hashBytes(hash, &separator, 1);
+	hash = hashBytes(hash, answer.data(), answer.size());
+	return hash;
+}
+
+std::uint32_t MusicQuiz::util::EntryIndex::intern(const std::string_view str)
+{
+	const std::unordered_map<std::string_view, std::uint32_t>::const_iterator it = _stringIds.find(str);
+	if ( it != _stringIds.end() ) {
+		return it->second;
+	}
+
+	const std::string_view stored = _arena->store(str);
+	const std::uint32_t stringId = static_cast<std::uint32_t>(_strings.size());
+	_strings.push_back(stored);
+	_stringIds.emplace(stored, stringId);
+	return stringId;
+}
+
+void MusicQuiz::util::EntryIndex::compact(const std::unordered_map<QuizId, Segment>& keep)
+{
+	size_t count = 0;
+	for ( size_t i = 0; i < _quizIds.size(); ++i ) {
+		if ( keep.count(_quizIds[i]) == 0 ) {
+			continue;
+		}
+
+		_quizIds[count] = _quizIds[i];
+		_keys[count] = _keys[i];
+		_categories[count] = _categories[i];
+		_names[count] = _names[i];
+		_answers[count] = _answers[i];
+		_types[count] = _types[i];
+		_points[count] = _points[i];
+		_startTimes[count] = _startTimes[i];
+		_answerStartTimes[count] = _answerStartTimes[i];
+		_videoSongStartTimes[count] = _videoSongStartTimes[i];
+		_songFiles[count] = _songFiles[i];
+		_videoFiles[count] = _videoFiles[i];
+		_lastPlayed[count] = _lastPlayed[i];
+		++count;
+	}
+
+	_quizIds.resize(count);
+	_keys.resize(count);
+	_categories.resize(count);
+	_names.resize(count);
+	_answers.resize(count);
+	_types.resize(count);
+	_points.resize(count);
+	_startTimes.resize(count);
+	_answerStartTimes.resize(count);
+	_videoSongStartTimes.resize(count);
+	_songFiles.resize(count);
+	_videoFiles.resize(count);
+	_lastPlayed.resize(count);
+
+	_segments = keep;
+}
+
+void MusicQuiz::util::EntryIndex::compactStrings()
+{
+	std::vector<std::uint32_t>* const columns[] = { &_categories, &_names, &_answers, &_songFiles, &_videoFiles };
+
+	/** Count the strings still in use, the pool is only rebuilt if at least half of it is unused */
+	std::vector<std::uint32_t> remap(_strings.size(), UINT32_MAX);
+	size_t used = 0;
+	for ( std::vector<std::uint32_t>* column : columns ) {
+		for ( size_t i = 0; i < column->size(); ++i ) {
+			std::uint32_t& stringId = remap[(*column)[i]];
+			if ( stringId == UINT32_MAX ) {
+				stringId = static_cast<std::uint32_t>(used++);
+			}
+		}
+	}
+
+	if ( _strings.empty() || used * 2 > _strings.size() ) {
+		return;
+	}
+
+	/** Copy the strings in use into a new pool, in the order of their new ids */
+	std::unique_ptr<StringArena> arena = std::make_unique<StringArena>();
+	std::vector<std::string_view> strings(used);
+	std::unordered_map<std::string_view, std::uint32_t> stringIds;
+	stringIds.reserve(used);
+	for ( size_t i = 0; i < remap.size(); ++i ) {
+		if ( remap[i] != UINT32_MAX ) {
+			strings[remap[i]] = arena->store(_strings[i]);
+			stringIds.emplace(strings[remap[i]], remap[i]);
+		}
+	}
+
+	for ( std::vector<std::uint32_t>* column : columns ) {
+		for ( size_t i = 0; i < column->size(); ++i ) {
+			(*column)[i] = remap[(*column)[i]];
+		}
+	}
+
+	_arena = std::move(arena);
+	_strings = std::move(strings);
+	_stringIds = std::move(stringIds);
+}
+
+void MusicQuiz::util::EntryIndex::append(const QuizId quizId, const QuizDocument& document)
+{
+	for ( size_t i = 0; i < document.categories.size(); ++i ) {
+		const QuizDocument::Category& category = document.categories[i];
+		const std::uint32_t categoryId = intern(category.name);
+
+		for ( size_t j = 0; j < category.entries.size(); ++j ) {
+			const QuizDocument::Entry& entry = category.entries[j];
+			const EntryKey key = getEntryKey(quizId, category.name, entry.answer);
+			const std::unordered_map<EntryKey, std::time_t>::const_iterator it = _history.find(key);
+
+			_quizIds.push_back(quizId);
+			_keys.push_back(key);
+			_categories.push_back(categoryId);
+			_names.push_back(intern(entry.name));
+			_answers.push_back(intern(entry.answer));
+			_types.push_back(static_cast<std::uint8_t>(entry.type));
+			_points.push_back(static_cast<std::uint32_t>(entry.points));
+			_startTimes.push_back(static_cast<std::uint32_t>(entry.startTime));
+			_answerStartTimes.push_back(static_cast<std::uint32_t>(entry.answerStartTime));
+			_videoSongStartTimes.push_back(static_cast<std::uint32_t>(entry.videoSongStartTime));
+			_songFiles.push_back(intern(entry.songFile));
+			_videoFiles.push_back(intern(entry.videoFile));
+			_lastPlayed.push_back(it != _history.end() ? it->second : 0);
+		}
+	}
+}
\ No newline at end of file
@@ -0,0 +1,247 @@
+#pragma once
+
+#include <ctime>
+#include <mutex>
+#include <string>
+#include <vector>
+#include <memory>
+#include <cstdint>
+#include <functional>
+#include <string_view>
+#include <unordered_map>
+
+#include <boost/filesystem.hpp>
+
+#include "util/QuizId.hpp"
+#include "util/QuizCatalog.hpp"
+#include "util/QuizDocument.hpp"
+#include "util/StringArena.hpp"
+
+
+namespace MusicQuiz {
+	namespace util {
+		/**
+		 * @brief Index of the entries of all quizzes in the catalog.
+		 *
+		 * The entries are stored column by column, with strings interned in a shared pool, such that a query only
+		 * touches the columns it filters on. The index is updated from the catalog, and only the quizzes that changed
+		 * since the last update are read again. The index also keeps the time each entry was last played.
+		 */
+		class EntryIndex
+		{
+		public:
+			typedef MusicQuiz::util::QuizDocument::EntryType EntryType;
+
+			/**
+			 * @brief Identifies an entry across index updates. See getEntryKey.
+			 */
+			typedef std::uint64_t EntryKey;
+
+			/**
+			 * @brief Reads the document of a quiz file.
+			 */
+			typedef std::function<MusicQuiz::util::QuizDocument::CPtr(const std::string& path)> DocumentReader;
+
+			/**
+			 * @brief Called with the number of quizzes read and the number of quizzes to read. Returning false cancels the update.
+			 */
+			typedef std::function<bool(size_t done, size_t total)> ProgressCallback;
+
+			struct Query
+			{
+				/** Points range, inclusive */
+				size_t minPoints = 0;
+				size_t maxPoints = SIZE_MAX;
+
+				bool includeSongs = true;
+				bool includeVideos = true;
+
+				/** Case insensitive text the category name or answer must contain. Ignored if empty */
+				std::string category = "";
+				std::string answer = "";
+
+				/** The quizzes to search. All quizzes if empty */
+				std::vector<MusicQuiz::util::QuizId> quizzes;
+
+				/** Excludes the entries played at or after this time. Ignored if 0 */
+				std::time_t notPlayedSince = 0;
+
+				/** Maximum number of results */
+				size_t limit = SIZE_MAX;
+			};
+
+			struct Row
+			{
+				EntryKey key = 0;
+				MusicQuiz::util::QuizId quizId = 0;
+				std::string category = "";
+
+				std::string name = "";
+				std::string answer = "";
+				EntryType type = EntryType::Song;
+
+				size_t points = 0;
+				size_t startTime = 0;
+				size_t answerStartTime = 0;
+				size_t videoSongStartTime = 0;
+
+				/** Media paths as written in the quiz file */
+				std::string songFile = "";
+				std::string videoFile = "";
+
+				/** 0 if the entry has not been played */
+				std::time_t lastPlayed = 0;
+			};
+
+			/**
+			 * @brief Constructor
+			 *
+			 * @param[in] historyFile The file the play history is persisted in.
+			 */
+			explicit EntryIndex(const boost::filesystem::path& historyFile);
+
+			/**
+			 * @brief Destructor. Writes pending changes to the play history.
+			 */
+			virtual ~EntryIndex();
+
+			/**
+			 * @brief Shared Pointer
+			 */
+			typedef std::shared_ptr< EntryIndex > Ptr;
+			typedef std::shared_ptr< const EntryIndex > CPtr;
+
+			/**
+			 * @brief Deleted the copy and assignment constructor.
+			 */
+			EntryIndex(const EntryIndex&) = delete;
+			EntryIndex& operator=(const EntryIndex&) = delete;
+
+			/**
+			 * @brief Brings the index up to date with the catalog. Quizzes that were added or changed are read,
+			 *        the entries of removed quizzes are dropped.
+			 *
+			 * @param[in] catalog The quiz catalog.
+			 * @param[in] reader Reads the quiz documents.
+			 * @param[in] progress Called before each quiz is read. A cancelled update leaves the index unchanged.
+			 *
+			 * @return The number of quizzes that were read.
+			 */
+			size_t update(const MusicQuiz::util::QuizCatalog& catalog, const DocumentReader& reader, const ProgressCallback& progress = nullptr);
+
+			/**
+			 * @brief Returns the entries matching a query, in catalog order.
+			 *
+			 * @param[in] query The query.
+			 *
+			 * @return The matching entries.
+			 */
+			std::vector<Row> query(const Query& query) const;
+
+			/**
+			 * @brief Returns the number of entries in the index.
+			 *
+			 * @return The number of entries.
+			 */
+			size_t size() const;
+
+			/**
+			 * @brief Records that an entry was played.
+			 *
+			 * @param[in] key The key of the entry.
+			 * @param[in] time The time the entry was played.
+			 */
+			void markPlayed(EntryKey key, std::time_t time);
+
+			/**
+			 * @brief Loads the play history. A missing or corrupt file results in an empty history.
+			 */
+			void loadHistory();
+
+			/**
+			 * @brief Writes the play history if it has changed since it was last written.
+			 */
+			void saveHistory();
+
+			/**
+			 * @brief Returns the key of an entry. The key is the 64-bit FNV-1a hash of the quiz id, the category name and the answer,
+			 *        so it stays the same when the quiz is edited without changing the entry.
+			 *
+			 * @param[in] quizId The id of the quiz.
+			 * @param[in] category The name of the category.
+			 * @param[in] answer The answer of the entry.
+			 *
+			 * @return The entry key.
+			 */
+			static EntryKey getEntryKey(MusicQuiz::util::QuizId quizId, std::string_view category, std::string_view answer);
+
+		protected:
+			struct Segment
+			{
+				std::time_t lastWriteTime = 0;
+				std::uintmax_t fileSize = 0;
+			};
+
+			/**
+			 * @brief Returns the id of a string in the pool, adding it if needed. Must be called with the mutex locked.
+			 *
+			 * @param[in] str The string.
+			 *
+			 * @return The string id.
+			 */
+			std::uint32_t intern(std::string_view str);
+
+			/**
+			 * @brief Removes the entries of the quizzes that are not in the set. Must be called with the mutex locked.
+			 *
+			 * @param[in] keep The quizzes to keep.
+			 */
+			void compact(const std::unordered_map<MusicQuiz::util::QuizId, Segment>& keep);
+
+			/**
+			 * @brief Rebuilds the string pool from the strings still in use, once most of the pool belongs to entries that were removed.
+			 *        Must be called with the mutex locked.
+			 */
+			void compactStrings();
+
+			/**
+			 * @brief Appends the entries of a quiz. Must be called with the mutex locked.
+			 *
+			 * @param[in] quizId The id of the quiz.
+			 * @param[in] document The quiz document.
+			 */
+			void append(MusicQuiz::util::QuizId quizId, const MusicQuiz::util::QuizDocument& document);
+
+			/** Variables */
+			const boost::filesystem::path _historyFile;
+			bool _historyDirty = false;
+			std::unordered_map<EntryKey, std::time_t> _history;
+
+			/** Quizzes in the index and the file version they were read from */
+			std::unordered_map<MusicQuiz::util::QuizId, Segment> _segments;
+
+			/** Columns */
+			std::vector<MusicQuiz::util::QuizId> _quizIds;
+			std::vector<EntryKey> _keys;
+			std::vector<std::uint32_t> _categories;
+			std::vector<std::uint32_t> _names;
+			std::vector<std::uint32_t> _answers;
+			std::vector<std::uint8_t> _types;
+			std::vector<std::uint32_t> _points;
+			std::vector<std::uint32_t> _startTimes;
+			std::vector<std::uint32_t> _answerStartTimes;
+			std::vector<std::uint32_t> _videoSongStartTimes;
+			std::vector<std::uint32_t> _songFiles;
+			std::vector<std::uint32_t> _videoFiles;
+			std::vector<std::time_t> _lastPlayed;
+
+			/** String pool. Strings of removed entries stay in the pool until compactStrings rebuilds it */
+			std::unique_ptr< MusicQuiz::util::StringArena > _arena;
+			std::vector<std::string_view> _strings;
+			std::unordered_map<std::string_view, std::uint32_t> _stringIds;
+
+			mutable std::mutex _mutex;
+			std::mutex _updateMutex;
+		};
+	}
+}
\ No newline at end of file
@@ -0,0 +1,280 @@
+#include "FileCopier.hpp"
+
+#include <vector>
+#include <fstream>
+#include <algorithm>
+#include <stdexcept>
+
+#if defined(__linux__)
+#include <cerrno>
+#include <cstring>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/stat.h>
+#include <sys/ioctl.h>
+#include <sys/sendfile.h>
+#include <linux/fs.h>
+#endif
+
+
+namespace {
+	/** Size of the chunks copied through a buffer */
+	constexpr size_t BUFFER_SIZE = 1 << 20;
+
+#if defined(__linux__)
+	/** Size of the chunks copied by the kernel. Small enough to report progress and cancel during large files */
+	constexpr size_t KERNEL_CHUNK_SIZE = 8 << 20;
+
+	/**
+	 * @brief Closes a file descriptor when it goes out of scope.
+	 */
+	struct FileDescriptor
+	{
+		explicit FileDescriptor(const int descriptor) :
+			fd(descriptor)
+		{
+		}
+
+		~FileDescriptor()
+		{
+			if ( fd >= 0 ) {
+				close(fd);
+			}
+		}
+
+		FileDescriptor(const FileDescriptor&) = delete;
+		FileDescriptor& operator=(const FileDescriptor&) = delete;
+
+		int fd;
+	};
+
+	enum class KernelCopy
+	{
+		/** The file was copied */
+		DONE,
+
+		/** The copy was cancelled */
+		CANCELLED,
+
+		/** The method is not supported for these files, nothing was copied */
+		UNSUPPORTED
+	};
+
+	/**
+	 * @brief Copies a file in chunks with copy_file_range or sendfile.
+	 *
+	 * @param[in] in The source file.
+	 * @param[in] out The destination file.
+	 * @param[in] size The size of the source file.
+	 * @param[in] backend The method to use.
+	 * @param[in] progress Called after each chunk.
+	 * @param[in] destination The path of the destination, for error messages.
+	 *
+	 * @return The result of the copy.
+	 */
+	KernelCopy copyInKernel(const int in, const int out, const off_t size, const MusicQuiz::util::FileCopier::Backend backend,
+		const MusicQuiz::util::FileCopier::ProgressCallback& progress, const std::string& destination)
+	{
+		off_t offset = 0;
+		while ( offset < size ) {
+			const size_t count = static_cast<size_t>(std::min<off_t>(size - offset, static_cast<off_t>(KERNEL_CHUNK_SIZE)));
+			ssize_t copied;
+			if ( backend == MusicQuiz::util::FileCopier::Backend::COPY_FILE_RANGE ) {
+				copied = copy_file_range(in, nullptr, out, nullptr, count, 0);
+			} else {
+				copied = sendfile(out, in, nullptr, count);
+			}
+
+			if ( copied < 0 && errno == EINTR ) {
+				continue;
+			}
+
+			/** Some file systems report success without copying anything, those are treated as unsupported as well */
+			if ( copied <= 0 && offset == 0 ) {
+				return KernelCopy::UNSUPPORTED;
+			}
+
+			if ( copied < 0 ) {
+				throw std::runtime_error("Failed to write '" + destination + "'. " + std::strerror(errno));
+			}
+
+			/** The source got shorter while it was copied */
+			if ( copied == 0 ) {
+				break;
+			}
+
+			offset += copied;
+			if ( progress != nullptr && !progress(static_cast<std::uintmax_t>(copied)) ) {
+				return KernelCopy::CANCELLED;
+			}
+		}
+		return KernelCopy::DONE;
+	}
+#endif
+
+	/**
+	 * @brief Flushes a file that has been written to disk.
+	 *
+	 * @param[in] path The file.
+	 */
+	void syncFile(const std::string& path)
+	{
+#if defined(__linux__)
+		const int fd = open(path.c_str(), O_WRONLY | O_CLOEXEC);
+		if ( fd < 0 || fsync(fd) != 0 ) {
+			const std::string error = std::strerror(errno);
+			if ( fd >= 0 ) {
+				close(fd);
+			}
+			throw std::runtime_error("Failed to sync '" + path + "'. " + error);
+		}
+		close(fd);
+#else
+		(void)path;
+#endif
+	}
+
+	/**
+	 * @brief Copies a file through a buffer.
+	 *
+	 * @param[in] source The file to copy.
+	 * @param[in] destination The file to write.
+	 * @param[in] progress Called after each chunk.
+	 *
+	 * @return False if the copy was cancelled.
+	 */
+	bool copyBuffered(const std::string& source, const std::string& destination, const MusicQuiz::util::FileCopier::ProgressCallback& progress)
+	{
+		std::ifstream in(source, std::ios::binary);
+		if ( !in.is_open() ) {
+			throw std::runtime_error("Failed to open '" + source + "'.");
+		}
+
+		std::ofstream out(destination, std::ios::binary | std::ios::trunc);
+		if ( !out.is_open() ) {
+			throw std::runtime_error("Failed to create '" + destination + "'.");
+		}
+
+		std::vector<char> buffer(BUFFER_SIZE);
+		while ( in ) {
+			in.read(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+			const std::streamsize count = in.gcount();
+			if ( count <= 0 ) {
+				break;
+			}
+
+			out.write(buffer.data(), count);
+			if ( !out ) {
+				throw std::runtime_error("Failed to write '" + destination + "'.");
+			}
+
+			if ( progress != nullptr && !progress(static_cast<std::uintmax_t>(count)) ) {
+				return false;
+			}
+		}
+
+		if ( in.bad() ) {
+			throw std::runtime_error("Failed to read '" + source + "'.");
+		}
+
+		out.close();
+		if ( out.fail() ) {
+			throw std::runtime_error("Failed to write '" + destination + "'.");
+		}
+		return true;
+	}
+}
+
+
+bool MusicQuiz::util::FileCopier::copy(const std::string& source, const std::string& destination, Backend& backend, const ProgressCallback& progress, const bool sync)
+{
+#if defined(__linux__)
+	{
+		FileDescriptor in(open(source.c_str(), O_RDONLY | O_CLOEXEC));
+		if ( in.fd < 0 ) {
+			throw std::runtime_error("Failed to open '" + source + "'. " + std::strerror(errno));
+		}
+
+		struct stat status;
+		if ( fstat(in.fd, &status) != 0 ) {
+			throw std::runtime_error("Failed to read '" + source + "'. " + std::strerror(errno));
+		}
+
+		FileDescriptor out(open(destination.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, status.st_mode & 0777));
+		if ( out.fd < 0 ) {
+			throw std::runtime_error("Failed to create '" + destination + "'. " + std::strerror(errno));
+		}
+
+		/** Reflink. Fails without side effects if the files are not on the same btrfs or xfs file system */
+#if defined(FICLONE)
+		if ( ioctl(out.fd, FICLONE, in.fd) == 0 ) {
+			if ( sync && fsync(out.fd) != 0 ) {
+				throw std::runtime_error("Failed to sync '" + destination + "'. " + std::strerror(errno));
+			}
+			backend = Backend::REFLINK;
+			return progress == nullptr || progress(static_cast<std::uintmax_t>(status.st_size));
+		}
+#endif
+
+		/** Copy in the kernel, files that are empty or can not be copied this way (e.g. in /proc) go through the buffer */
+		if ( status.st_size > 0 ) {
+			const Backend kernelBackends[] = { Backend::COPY_FILE_RANGE, Backend::SENDFILE };
+			for ( const Backend kernelBackend : kernelBackends ) {
+				const KernelCopy result = copyInKernel(in.fd, out.fd, status.st_size, kernelBackend, progress, destination);
+				if ( result == KernelCopy::UNSUPPORTED ) {
+					continue;
+				}
+
+				if ( sync && result == KernelCopy::DONE && fsync(out.fd) != 0 ) {
+					throw std::runtime_error("Failed to sync '" + destination + "'. " + std::strerror(errno));
+				}
+
+				if ( close(out.fd) != 0 ) {
+					out.fd = -1;
+					throw std::runtime_error("Failed to write '" + destination + "'. " + std::strerror(errno));
+				}
+				out.fd = -1;
+				backend = kernelBackend;
+				return result == KernelCopy::DONE;
+			}
+		}
+	}
+#endif
+
+	backend = Backend::BUFFERED;
+	if ( !copyBuffered(source, destination, progress) ) {
+		return false;
+	}
+
+	if ( sync ) {
+		syncFile(destination);
+	}
+	return true;
+}
+
+void MusicQuiz::util::FileCopier::syncFolder(const std::string& folder)
+{
+#if defined(__linux__)
+	const int fd = open(folder.c_str(), O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+	if ( fd >= 0 ) {
+		fsync(fd);
+		close(fd);
+	}
+#else
+	(void)folder;
+#endif
+}
+
+std::string MusicQuiz::util::FileCopier::getBackendName(const Backend backend)
+{
+	switch ( backend ) {
+	case Backend::REFLINK:
+		return "reflink";
+	case Backend::COPY_FILE_RANGE:
+		return "copy_file_range";
+	case Backend::SENDFILE:
+		return "sendfile";
+	default:
+		return "buffered";
+	}
+}
\ No newline at end of file
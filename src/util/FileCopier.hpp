@@ -0,0 +1,66 @@
+#pragma once
+
+#include <string>
+#include <cstdint>
+#include <functional>
+
+
+namespace MusicQuiz {
+	namespace util {
+		/**
+		 * @brief Copies files with the fastest method the file systems support.
+		 *
+		 * On Linux the copy is first tried as a reflink, which shares the data blocks on btrfs and xfs and finishes instantly.
+		 * Otherwise the kernel copies the data with copy_file_range or sendfile, without passing it through user space.
+		 * The file is copied through a buffer only if none of these work, which is also the method used on other platforms.
+		 */
+		class FileCopier
+		{
+		public:
+			enum class Backend
+			{
+				REFLINK, COPY_FILE_RANGE, SENDFILE, BUFFERED
+			};
+
+			/**
+			 * @brief Called with the number of bytes copied since the last call. Returning false cancels the copy.
+			 */
+			typedef std::function<bool(std::uintmax_t bytes)> ProgressCallback;
+
+			/**
+			 * @brief Deleted constructor and destructor.
+			 */
+			FileCopier() = delete;
+			~FileCopier() = delete;
+
+			/**
+			 * @brief Copies a file, replacing the destination if it exists. Throws if the file can not be copied.
+			 *
+			 * @param[in] source The file to copy.
+			 * @param[in] destination The file to write.
+			 * @param[out] backend The method the file was copied with.
+			 * @param[in] progress Called after each chunk that is copied.
+			 * @param[in] sync If true the destination is flushed to disk before returning, e.g. before it is committed by a rename.
+			 *
+			 * @return False if the copy was cancelled. The destination is then incomplete.
+			 */
+			static bool copy(const std::string& source, const std::string& destination, Backend& backend, const ProgressCallback& progress = nullptr, bool sync = false);
+
+			/**
+			 * @brief Syncs the entries of a folder to disk, so files created or renamed in it survive a crash.
+			 *
+			 * @param[in] folder The folder.
+			 */
+			static void syncFolder(const std::string& folder);
+
+			/**
+			 * @brief Returns the name of a backend.
+			 *
+			 * @param[in] backend The backend.
+			 *
+			 * @return The name.
+			 */
+			static std::string getBackendName(Backend backend);
+		};
+	}
+}
\ No newline at end of file
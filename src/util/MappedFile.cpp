@@ -0,0 +1,48 @@
+#include "MappedFile.hpp"
+
+#include <stdexcept>
+
+#include <boost/filesystem.hpp>
+#include <boost/interprocess/file_mapping.hpp>
+#include <boost/interprocess/mapped_region.hpp>
+
+
+MusicQuiz::util::MappedFile::MappedFile(const std::string& path)
+{
+	/** Sanity Check */
+	if ( !boost::filesystem::is_regular_file(path) ) {
+		throw std::runtime_error("File '" + path + "' does not exists.");
+	}
+
+	/** Empty files can not be mapped, they are represented by an empty view instead */
+	if ( boost::filesystem::file_size(path) == 0 ) {
+		return;
+	}
+
+	_mapping = std::make_unique<boost::interprocess::file_mapping>(path.c_str(), boost::interprocess::read_only);
+	_region = std::make_unique<boost::interprocess::mapped_region>(*_mapping, boost::interprocess::read_only);
+	_region->advise(boost::interprocess::mapped_region::advice_sequential);
+}
+
+MusicQuiz::util::MappedFile::~MappedFile() = default;
+
+const char* MusicQuiz::util::MappedFile::getData() const
+{
+	if ( _region == nullptr ) {
+		return nullptr;
+	}
+	return static_cast<const char*>(_region->get_address());
+}
+
+size_t MusicQuiz::util::MappedFile::getSize() const
+{
+	if ( _region == nullptr ) {
+		return 0;
+	}
+	return _region->get_size();
+}
+
+std::string_view MusicQuiz::util::MappedFile::getView() const
+{
+	return std::string_view(getData(), getSize());
+}
\ No newline at end of file
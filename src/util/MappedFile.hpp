@@ -0,0 +1,75 @@
+#pragma once
+
+#include <string>
+#include <memory>
+#include <cstddef>
+#include <string_view>
+
+
+namespace boost {
+	namespace interprocess {
+		class file_mapping;
+		class mapped_region;
+	}
+}
+
+namespace MusicQuiz {
+	namespace util {
+		/**
+		 * @brief Read-only memory mapping of a file.
+		 */
+		class MappedFile
+		{
+		public:
+			/**
+			 * @brief Constructor. Maps the whole file.
+			 *
+			 * @param[in] path The path of the file to map.
+			 */
+			explicit MappedFile(const std::string& path);
+
+			/**
+			 * @brief Destructor. Unmaps the file.
+			 */
+			virtual ~MappedFile();
+
+			/**
+			 * @brief Shared Pointer
+			 */
+			typedef std::shared_ptr< MappedFile > Ptr;
+			typedef std::shared_ptr< const MappedFile > CPtr;
+
+			/**
+			 * @brief Deleted the copy and assignment constructor.
+			 */
+			MappedFile(const MappedFile&) = delete;
+			MappedFile& operator=(const MappedFile&) = delete;
+
+			/**
+			 * @brief Returns the mapped data.
+			 *
+			 * @return Pointer to the first byte of the file.
+			 */
+			const char* getData() const;
+
+			/**
+			 * @brief Returns the size of the mapping.
+			 *
+			 * @return The size of the file in bytes.
+			 */
+			size_t getSize() const;
+
+			/**
+			 * @brief Returns the mapped data as a string.
+			 *
+			 * @return View of the whole file.
+			 */
+			std::string_view getView() const;
+
+		protected:
+			/** Variables */
+			std::unique_ptr< boost::interprocess::file_mapping > _mapping;
+			std::unique_ptr< boost::interprocess::mapped_region > _region;
+		};
+	}
+}
\ No newline at end of file
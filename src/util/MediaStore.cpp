@@ -0,0 +1,485 @@
+#include "MediaStore.hpp"
+
+#include <atomic>
+#include <cctype>
+#include <thread>
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+#include <algorithm>
+#include <exception>
+#include <stdexcept>
+
+#include "common/Log.hpp"
+#include "util/FileCopier.hpp"
+#include "util/XxHash64.hpp"
+
+
+namespace {
+	/** Version of the references file format. Bump when the layout changes. */
+	const std::string REFERENCES_HEADER = "MusicQuizMediaReferences";
+	const size_t REFERENCES_VERSION = 1;
+
+	/** Size of the chunks files are read in */
+	constexpr size_t READ_CHUNK_SIZE = 1 << 20;
+
+	/** Number of hex digits of the hash in a file name */
+	constexpr size_t HASH_DIGITS = 16;
+
+	/**
+	 * @brief Checks if a file name is the name of a stored file, <hash> or <hash>.<ext>.
+	 *
+	 * @param[in] name The file name.
+	 *
+	 * @return True if the name is the name of a stored file.
+	 */
+	bool isStoredName(const std::string& name)
+	{
+		if ( name.size() < HASH_DIGITS ) {
+			return false;
+		}
+
+		for ( size_t i = 0; i < HASH_DIGITS; ++i ) {
+			if ( !std::isxdigit(static_cast<unsigned char>(name[i])) || std::isupper(static_cast<unsigned char>(name[i])) ) {
+				return false;
+			}
+		}
+		if ( name.size() == HASH_DIGITS ) {
+			return true;
+		}
+
+		/** Optional extension of letters and digits */
+		if ( name[HASH_DIGITS] != '.' ) {
+			return false;
+		}
+
+		for ( size_t i = HASH_DIGITS + 1; i < name.size(); ++i ) {
+			if ( !std::isalnum(static_cast<unsigned char>(name[i])) ) {
+				return false;
+			}
+		}
+		return true;
+	}
+
+	/**
+	 * @brief Returns the extension of a file as used for stored files, lower case and without characters other than letters and digits.
+	 *
+	 * @param[in] path The path of the file.
+	 *
+	 * @return The extension including the dot, or an empty string.
+	 */
+	std::string getExtension(const std::string& path)
+	{
+		std::string extension = "";
+		const std::string original = boost::filesystem::path(path).extension().string();
+		for ( size_t i = 1; i < original.size(); ++i ) {
+			if ( std::isalnum(static_cast<unsigned char>(original[i])) ) {
+				extension.push_back(static_cast<char>(std::tolower(static_cast<unsigned char>(original[i]))));
+			}
+		}
+		return extension.empty() ? "" : "." + extension;
+	}
+}
+
+
+MusicQuiz::util::MediaStore::MediaStore(const std::string& folder) :
+	_folder(folder), _referencesFile(folder + "/.references")
+{
+}
+
+MusicQuiz::util::MediaStore::~MediaStore()
+{
+	saveReferences();
+}
+
+bool MusicQuiz::util::MediaStore::add(const std::vector<std::string>& files, std::vector<std::string>& paths, size_t numberOfThreads, const ProgressCallback& progress)
+{
+	paths.assign(files.size(), "");
+	if ( files.empty() ) {
+		return true;
+	}
+	boost::filesystem::create_directories(_folder);
+
+	if ( numberOfThreads == 0 ) {
+		numberOfThreads = std::max<size_t>(1, std::thread::hardware_concurrency());
+	}
+	numberOfThreads = std::min(numberOfThreads, files.size());
+
+	/** Each thread takes the next file, so a few large videos do not leave the other threads idle */
+	std::atomic<size_t> next(0);
+	std::atomic<bool> cancelled(false);
+	std::mutex errorMutex;
+	std::exception_ptr error = nullptr;
+	const ProgressCallback report = [&progress, &cancelled](const std::uintmax_t bytes, const size_t done) {
+		if ( progress != nullptr && !progress(bytes, done) ) {
+			cancelled = true;
+		}
+		return !cancelled;
+	};
+
+	const auto worker = [&]() {
+		for ( size_t i = next++; i < files.size() && !cancelled; i = next++ ) {
+			try {
+				if ( contains(files[i]) ) {
+					paths[i] = getPath(files[i]);
+					report(0, 1);
+					continue;
+				}
+
+				const std::uint64_t hash = hashFile(files[i], report);
+				if ( cancelled ) {
+					break;
+				}
+
+				const std::string name = getFileName(hash, getExtension(files[i]));
+				store(files[i], name);
+				paths[i] = _folder + "/" + name;
+				report(0, 1);
+			} catch ( ... ) {
+				std::lock_guard<std::mutex> lock(errorMutex);
+				if ( error == nullptr ) {
+					error = std::current_exception();
+				}
+				cancelled = true;
+			}
+		}
+	};
+
+	std::vector<std::thread> threads;
+	for ( size_t i = 1; i < numberOfThreads; ++i ) {
+		threads.emplace_back(worker);
+	}
+	worker();
+	for ( size_t i = 0; i < threads.size(); ++i ) {
+		threads[i].join();
+	}
+
+	if ( error != nullptr ) {
+		std::rethrow_exception(error);
+	}
+	return !cancelled;
+}
+
+bool MusicQuiz::util::MediaStore::contains(const std::string& path) const
+{
+	return !getStoredName(path).empty();
+}
+
+std::string MusicQuiz::util::MediaStore::getPath(const std::string& path) const
+{
+	const std::string name = getStoredName(path);
+	if ( name.empty() ) {
+		throw std::runtime_error("'" + path + "' is not in the media store.");
+	}
+	return _folder + "/" + name;
+}
+
+void MusicQuiz::util::MediaStore::setReferences(const QuizId quizId, const std::vector<std::string>& paths)
+{
+	std::vector<std::string> names;
+	for ( size_t i = 0; i < paths.size(); ++i ) {
+		const std::string name = getStoredName(paths[i]);
+		if ( !name.empty() ) {
+			names.push_back(name);
+		}
+	}
+	std::sort(names.begin(), names.end());
+	names.erase(std::unique(names.begin(), names.end()), names.end());
+
+	std::lock_guard<std::mutex> lock(_mutex);
+	const std::unordered_map< QuizId, std::vector<std::string> >::iterator it = _references.find(quizId);
+	if ( it != _references.end() ) {
+		if ( it->second == names ) {
+			return;
+		}
+
+		for ( size_t i = 0; i < it->second.size(); ++i ) {
+			if ( --_referenceCounts[it->second[i]] == 0 ) {
+				_referenceCounts.erase(it->second[i]);
+			}
+		}
+		_references.erase(it);
+	}
+
+	for ( size_t i = 0; i < names.size(); ++i ) {
+		++_referenceCounts[names[i]];
+		_pending.erase(names[i]);
+	}
+
+	if ( !names.empty() ) {
+		_references.emplace(quizId, std::move(names));
+	}
+	_referencesDirty = true;
+}
+
+size_t MusicQuiz::util::MediaStore::getReferenceCount(const std::string& path) const
+{
+	const std::string name = getStoredName(path);
+
+	std::lock_guard<std::mutex> lock(_mutex);
+	const std::unordered_map<std::string, size_t>::const_iterator it = _referenceCounts.find(name);
+	return it != _referenceCounts.end() ? it->second : 0;
+}
+
+MusicQuiz::util::MediaStore::GarbageReport MusicQuiz::util::MediaStore::collectGarbage(const QuizCatalog& catalog, const DocumentReader& reader)
+{
+	GarbageReport report;
+	if ( !boost::filesystem::is_directory(_folder) ) {
+		return report;
+	}
+
+	/** Read the media files of every quiz. Quizzes that can not be read keep their previous references */
+	std::unordered_map< QuizId, std::vector<std::string> > references;
+	const std::vector<std::string> quizList = catalog.getQuizList();
+	for ( size_t i = 0; i < quizList.size(); ++i ) {
+		const QuizId quizId = QuizCatalog::getQuizId(quizList[i]);
+		try {
+			const QuizDocument::CPtr document = reader(quizList[i]);
+			std::vector<std::string>& names = references[quizId];
+			for ( size_t j = 0; j < document->categories.size(); ++j ) {
+				const std::vector<QuizDocument::Entry>& entries = document->categories[j].entries;
+				for ( size_t k = 0; k < entries.size(); ++k ) {
+					const std::string songName = getStoredName(std::string(entries[k].songFile));
+					const std::string videoName = getStoredName(std::string(entries[k].videoFile));
+					if ( !songName.empty() ) {
+						names.push_back(songName);
+					}
+					if ( !videoName.empty() ) {
+						names.push_back(videoName);
+					}
+				}
+			}
+			std::sort(names.begin(), names.end());
+			names.erase(std::unique(names.begin(), names.end()), names.end());
+		} catch ( const std::exception& err ) {
+			LOG_WARN("Failed to read the media of quiz '" << quizList[i] << "'. " << err.what());
+
+			std::lock_guard<std::mutex> lock(_mutex);
+			const std::unordered_map< QuizId, std::vector<std::string> >::const_iterator it = _references.find(quizId);
+			if ( it != _references.end() ) {
+				references[quizId] = it->second;
+			}
+		}
+	}
+
+	/** Replace the references, then remove the files nothing refers to */
+	std::lock_guard<std::mutex> lock(_mutex);
+	_references.clear();
+	_referenceCounts.clear();
+	for ( std::unordered_map< QuizId, std::vector<std::string> >::iterator it = references.begin(); it != references.end(); ++it ) {
+		if ( it->second.empty() ) {
+			continue;
+		}
+
+		for ( size_t i = 0; i < it->second.size(); ++i ) {
+			++_referenceCounts[it->second[i]];
+		}
+		_references.emplace(it->first, std::move(it->second));
+	}
+	_referencesDirty = true;
+
+	std::vector<boost::filesystem::path> unused;
+	boost::filesystem::directory_iterator file(_folder), end;
+	for ( ; file != end; ++file ) {
+		const std::string name = file->path().filename().string();
+		if ( isStoredName(name) && _referenceCounts.count(name) == 0 && _pending.count(name) == 0 && boost::filesystem::is_regular_file(file->path()) ) {
+			unused.push_back(file->path());
+		}
+	}
+
+	for ( size_t i = 0; i < unused.size(); ++i ) {
+		boost::system::error_code err;
+		const std::uintmax_t size = boost::filesystem::file_size(unused[i], err);
+		if ( boost::filesystem::remove(unused[i], err) ) {
+			++report.files;
+			report.bytes += err ? 0 : size;
+		} else {
+			LOG_ERROR("Failed to remove unused media file '" << unused[i].string() << "'. " << err.message());
+		}
+	}
+	return report;
+}
+
+void MusicQuiz::util::MediaStore::loadReferences()
+{
+	std::lock_guard<std::mutex> lock(_mutex);
+	_references.clear();
+	_referenceCounts.clear();
+	_referencesDirty = false;
+
+	std::ifstream in(_referencesFile, std::ios::binary);
+	if ( !in.is_open() ) {
+		return;
+	}
+
+	std::string header;
+	size_t version = 0, numberOfQuizzes = 0;
+	if ( !(in >> header >> version >> numberOfQuizzes) || header != REFERENCES_HEADER || version != REFERENCES_VERSION ) {
+		LOG_INFO("Ignoring media references '" << _referencesFile << "' with unknown format.");
+		return;
+	}
+
+	for ( size_t i = 0; i < numberOfQuizzes; ++i ) {
+		QuizId quizId = 0;
+		size_t numberOfFiles = 0;
+		if ( !(in >> quizId >> numberOfFiles) ) {
+			LOG_ERROR("Failed to load media references. Truncated file.");
+			_references.clear();
+			_referenceCounts.clear();
+			return;
+		}
+
+		std::vector<std::string>& names = _references[quizId];
+		names.resize(numberOfFiles);
+		for ( size_t j = 0; j < numberOfFiles; ++j ) {
+			in >> names[j];
+			++_referenceCounts[names[j]];
+		}
+	}
+
+	if ( !in ) {
+		LOG_ERROR("Failed to load media references. Truncated file.");
+		_references.clear();
+		_referenceCounts.clear();
+	}
+}
+
+void MusicQuiz::util::MediaStore::saveReferences()
+{
+	std::lock_guard<std::mutex> lock(_mutex);
+	if ( !_referencesDirty ) {
+		return;
+	}
+
+	/** Nothing to write before the store is used */
+	boost::system::error_code err;
+	if ( _references.empty() && !boost::filesystem::exists(_referencesFile, err) ) {
+		_referencesDirty = false;
+		return;
+	}
+	boost::filesystem::create_directories(_folder, err);
+
+	/** Write to a temporary file and replace the references when done */
+	const std::string tmpFile = _referencesFile + ".tmp";
+	{
+		std::ofstream out(tmpFile, std::ios::binary | std::ios::trunc);
+		if ( !out.is_open() ) {
+			LOG_ERROR("Failed to write media references '" << tmpFile << "'.");
+			return;
+		}
+
+		out << REFERENCES_HEADER << ' ' << REFERENCES_VERSION << '\n' << _references.size() << '\n';
+		for ( std::unordered_map< QuizId, std::vector<std::string> >::const_iterator it = _references.begin(); it != _references.end(); ++it ) {
+			out << it->first << ' ' << it->second.size() << '\n';
+			for ( size_t i = 0; i < it->second.size(); ++i ) {
+				out << it->second[i] << '\n';
+			}
+		}
+
+		out.flush();
+		if ( !out ) {
+			LOG_ERROR("Failed to write media references '" << tmpFile << "'.");
+			return;
+		}
+	}
+
+	boost::filesystem::rename(tmpFile, _referencesFile, err);
+	if ( err ) {
+		LOG_ERROR("Failed to replace media references. " << err.message());
+		return;
+	}
+	_referencesDirty = false;
+}
+
+std::uint64_t MusicQuiz::util::MediaStore::hashFile(const std::string& path, const ProgressCallback& progress)
+{
+	std::ifstream in(path, std::ios::binary);
+	if ( !in.is_open() ) {
+		throw std::runtime_error("Failed to open '" + path + "'.");
+	}
+
+	XxHash64 hash;
+	std::vector<char> buffer(READ_CHUNK_SIZE);
+	while ( in ) {
+		in.read(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+		const std::streamsize count = in.gcount();
+		if ( count <= 0 ) {
+			break;
+		}
+
+		hash.update(buffer.data(), static_cast<size_t>(count));
+		if ( progress != nullptr && !progress(static_cast<std::uintmax_t>(count), 0) ) {
+			break;
+		}
+	}
+
+	if ( in.bad() ) {
+		throw std::runtime_error("Failed to read '" + path + "'.");
+	}
+	return hash.digest();
+}
+
+std::string MusicQuiz::util::MediaStore::getFileName(const std::uint64_t hash, const std::string& extension)
+{
+	std::ostringstream name;
+	name << std::hex << std::setw(HASH_DIGITS) << std::setfill('0') << hash << extension;
+	return name.str();
+}
+
+std::string MusicQuiz::util::MediaStore::getStoredName(const std::string& path) const
+{
+	const boost::filesystem::path file(path);
+	const std::string name = file.filename().string();
+	if ( !isStoredName(name) ) {
+		return "";
+	}
+
+	/** Paths written by the store are compared as they are, other paths by their canonical folder */
+	if ( file.parent_path().generic_string() == boost::filesystem::path(_folder).generic_string() ) {
+		return name;
+	}
+
+	boost::system::error_code err;
+	const boost::filesystem::path folder = boost::filesystem::canonical(file.parent_path(), err);
+	if ( err ) {
+		return "";
+	}
+
+	std::lock_guard<std::mutex> lock(_folderMutex);
+	if ( _canonicalFolder.empty() ) {
+		_canonicalFolder = boost::filesystem::canonical(_folder, err);
+		if ( err ) {
+			_canonicalFolder.clear();
+			return "";
+		}
+	}
+	return folder == _canonicalFolder ? name : "";
+}
+
+void MusicQuiz::util::MediaStore::store(const std::string& source, const std::string& name)
+{
+	/** Keep the file from being collected before the quiz using it is saved */
+	{
+		std::lock_guard<std::mutex> lock(_mutex);
+		_pending.insert(name);
+	}
+
+	/** Files with the same hash and size are taken to be the same file */
+	const boost::filesystem::path destination(_folder + "/" + name);
+	boost::system::error_code err;
+	if ( boost::filesystem::is_regular_file(destination, err) && boost::filesystem::file_size(destination, err) == boost::filesystem::file_size(source) ) {
+		return;
+	}
+
+	/** Copy under a temporary name and sync it before the rename, so a stored file is always complete, also after a crash */
+	const boost::filesystem::path tmpFile = boost::filesystem::path(_folder) / boost::filesystem::unique_path(".tmp-%%%%-%%%%-%%%%-%%%%");
+	try {
+		FileCopier::Backend backend;
+		FileCopier::copy(source, tmpFile.string(), backend, nullptr, true);
+		boost::filesystem::rename(tmpFile, destination);
+		FileCopier::syncFolder(_folder);
+	} catch ( ... ) {
+		boost::filesystem::remove(tmpFile, err);
+		throw;
+	}
+}
\ No newline at end of file
@@ -0,0 +1,196 @@
+#pragma once
+
+#include <mutex>
+#include <string>
+#include <vector>
+#include <memory>
+#include <cstdint>
+#include <functional>
+#include <unordered_map>
+#include <unordered_set>
+
+#include <boost/filesystem.hpp>
+
+#include "util/QuizId.hpp"
+#include "util/QuizCatalog.hpp"
+#include "util/QuizDocument.hpp"
+
+
+namespace MusicQuiz {
+	namespace util {
+		/**
+		 * @brief Content addressed store for media files shared between quizzes.
+		 *
+		 * Each file is stored once as <hash>.<ext> in the store folder, where the hash is the 64-bit xxHash of its content.
+		 * Quizzes refer to the stored files by path, so the same song used in several quizzes takes up space once.
+		 * The store counts the quizzes referring to each file, files no quiz refers to are removed by collectGarbage.
+		 */
+		class MediaStore
+		{
+		public:
+			/**
+			 * @brief Reads the document of a quiz file.
+			 */
+			typedef std::function<MusicQuiz::util::QuizDocument::CPtr(const std::string& path)> DocumentReader;
+
+			/**
+			 * @brief Called with the number of bytes read and files finished since the last call. May be called from several threads.
+			 *        Returning false cancels the import.
+			 */
+			typedef std::function<bool(std::uintmax_t bytes, size_t files)> ProgressCallback;
+
+			struct GarbageReport
+			{
+				size_t files = 0;
+				std::uintmax_t bytes = 0;
+			};
+
+			/**
+			 * @brief Constructor
+			 *
+			 * @param[in] folder The store folder. Created when the first file is added.
+			 */
+			explicit MediaStore(const std::string& folder);
+
+			/**
+			 * @brief Destructor. Writes pending changes to the references.
+			 */
+			virtual ~MediaStore();
+
+			/**
+			 * @brief Shared Pointer
+			 */
+			typedef std::shared_ptr< MediaStore > Ptr;
+			typedef std::shared_ptr< const MediaStore > CPtr;
+
+			/**
+			 * @brief Deleted the copy and assignment constructor.
+			 */
+			MediaStore(const MediaStore&) = delete;
+			MediaStore& operator=(const MediaStore&) = delete;
+
+			/**
+			 * @brief Adds files to the store. The files are hashed in parallel, files already in the store are not copied.
+			 *
+			 * @param[in] files The files to add.
+			 * @param[out] paths The paths of the stored files, in the order of the files.
+			 * @param[in] numberOfThreads The number of threads hashing files. Zero uses one thread per core.
+			 * @param[in] progress Called while the files are read.
+			 *
+			 * @return False if the import was cancelled.
+			 */
+			bool add(const std::vector<std::string>& files, std::vector<std::string>& paths, size_t numberOfThreads = 0, const ProgressCallback& progress = nullptr);
+
+			/**
+			 * @brief Checks if a file is in the store.
+			 *
+			 * @param[in] path The path of the file.
+			 *
+			 * @return True if the file is a stored file.
+			 */
+			bool contains(const std::string& path) const;
+
+			/**
+			 * @brief Returns the path of a stored file, as it is written in the quiz files.
+			 *
+			 * @param[in] path Any path of the stored file.
+			 *
+			 * @return The path in the store.
+			 */
+			std::string getPath(const std::string& path) const;
+
+			/**
+			 * @brief Sets the stored files a quiz refers to, replacing the previous references of the quiz.
+			 *
+			 * @param[in] quizId The id of the quiz.
+			 * @param[in] paths The paths of the stored files. Paths outside the store are ignored.
+			 */
+			void setReferences(MusicQuiz::util::QuizId quizId, const std::vector<std::string>& paths);
+
+			/**
+			 * @brief Returns the number of quizzes referring to a stored file.
+			 *
+			 * @param[in] path The path of the stored file.
+			 *
+			 * @return The reference count.
+			 */
+			size_t getReferenceCount(const std::string& path) const;
+
+			/**
+			 * @brief Brings the references up to date with the quizzes in the catalog and removes the stored files no quiz refers to.
+			 *
+			 * @param[in] catalog The quiz catalog.
+			 * @param[in] reader Reads the quiz documents.
+			 *
+			 * @return The number of files and bytes removed.
+			 */
+			GarbageReport collectGarbage(const MusicQuiz::util::QuizCatalog& catalog, const DocumentReader& reader);
+
+			/**
+			 * @brief Loads the references. A missing or corrupt file results in no references.
+			 */
+			void loadReferences();
+
+			/**
+			 * @brief Writes the references if they have changed since they were last written.
+			 */
+			void saveReferences();
+
+			/**
+			 * @brief Hashes the content of a file.
+			 *
+			 * @param[in] path The path of the file.
+			 * @param[in] progress Called after each chunk that is read. Reading stops when it returns false, the hash is then incomplete.
+			 *
+			 * @return The hash.
+			 */
+			static std::uint64_t hashFile(const std::string& path, const ProgressCallback& progress = nullptr);
+
+		protected:
+			/**
+			 * @brief Returns the name of a stored file.
+			 *
+			 * @param[in] hash The hash of the content.
+			 * @param[in] extension The extension of the file, including the dot.
+			 *
+			 * @return The file name.
+			 */
+			static std::string getFileName(std::uint64_t hash, const std::string& extension);
+
+			/**
+			 * @brief Returns the name of a file if it is in the store folder and named like a stored file.
+			 *
+			 * @param[in] path The path of the file.
+			 *
+			 * @return The file name, or an empty string.
+			 */
+			std::string getStoredName(const std::string& path) const;
+
+			/**
+			 * @brief Copies a file into the store, unless a file with the same content is already stored.
+			 *
+			 * @param[in] source The file to copy.
+			 * @param[in] name The name of the stored file.
+			 */
+			void store(const std::string& source, const std::string& name);
+
+			/** Variables */
+			const std::string _folder;
+			const std::string _referencesFile;
+
+			/** Canonical path of the store folder, empty until the folder exists */
+			mutable std::mutex _folderMutex;
+			mutable boost::filesystem::path _canonicalFolder;
+
+			/** Stored file names per quiz */
+			std::unordered_map< MusicQuiz::util::QuizId, std::vector<std::string> > _references;
+			std::unordered_map<std::string, size_t> _referenceCounts;
+			bool _referencesDirty = false;
+
+			/** Files added since the last call to setReferences. They are kept by collectGarbage until a quiz refers to them */
+			std::unordered_set<std::string> _pending;
+
+			mutable std::mutex _mutex;
+		};
+	}
+}
\ No newline at end of file
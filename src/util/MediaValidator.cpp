@@ -0,0 +1,193 @@
+#include "MediaValidator.hpp"
+
+#include <atomic>
+#include <thread>
+#include <fstream>
+#include <algorithm>
+
+#include <boost/filesystem.hpp>
+
+#include "util/QuizPackage.hpp"
+
+
+namespace {
+	/** Upper limit on the number of threads used to check the files */
+	const size_t MAX_THREADS = 8;
+
+	/** Minimum number of files per thread, fewer files are not worth starting a thread for */
+	const size_t FILES_PER_THREAD = 16;
+
+	/**
+	 * @brief Resolves a media path relative to the root folder, using '/' as folder separator.
+	 *
+	 * @param[in] rootFolder The root folder, ending with a separator.
+	 * @param[in] file The media path as stored in the document.
+	 *
+	 * @return The full media path.
+	 */
+	std::string resolvePath(const std::string& rootFolder, const std::string_view& file)
+	{
+		std::string path;
+		path.reserve(rootFolder.size() + file.size());
+		path.append(rootFolder).append(file.data(), file.size());
+		std::replace(path.begin(), path.end(), '\\', '/');
+		return path;
+	}
+}
+
+
+bool MusicQuiz::util::MediaValidator::Report::ok() const
+{
+	return issueCount == 0;
+}
+
+std::vector<MusicQuiz::util::MediaValidator::MediaFile> MusicQuiz::util::MediaValidator::Report::getIssues() const
+{
+	std::vector<MediaFile> issues;
+	for ( size_t i = 0; i < files.size(); ++i ) {
+		if ( files[i].problem != Problem::NONE ) {
+			issues.push_back(files[i]);
+		}
+	}
+	return issues;
+}
+
+std::string MusicQuiz::util::MediaValidator::Report::toString() const
+{
+	std::string err;
+	for ( size_t i = 0; i < files.size(); ++i ) {
+		const MediaFile& file = files[i];
+		if ( file.problem == Problem::NONE ) {
+			continue;
+		}
+
+		err += file.problem == Problem::UNREADABLE ? "Unreadable " : "Missing ";
+		err += file.type == FileType::VIDEO ? "video file '" : "song file '";
+		err += file.path + "'\n";
+	}
+	return err;
+}
+
+std::vector<MusicQuiz::util::MediaValidator::MediaFile> MusicQuiz::util::MediaValidator::resolve(const MusicQuiz::util::QuizDocument& document, const std::string& rootFolder)
+{
+	std::string root = rootFolder;
+	if ( !root.empty() && root.back() != '/' && root.back() != '\\' ) {
+		root += "/";
+	}
+
+	std::vector<MediaFile> files;
+	for ( size_t i = 0; i < document.categories.size(); ++i ) {
+		const QuizDocument::Category& category = document.categories[i];
+		for ( size_t j = 0; j < category.entries.size(); ++j ) {
+			const QuizDocument::Entry& entry = category.entries[j];
+
+			MediaFile file;
+			file.category = i;
+			file.entry = j;
+
+			/** Song, entries without media are reported by the QuizValidator and are not checked here */
+			if ( !entry.songFile.empty() ) {
+				file.type = FileType::SONG;
+				file.path = resolvePath(root, entry.songFile);
+				files.push_back(file);
+			}
+
+			/** Video */
+			if ( entry.type == QuizDocument::EntryType::Video && !entry.videoFile.empty() ) {
+				file.type = FileType::VIDEO;
+				file.path = resolvePath(root, entry.videoFile);
+				files.push_back(file);
+			}
+		}
+	}
+
+	return files;
+}
+
+bool MusicQuiz::util::MediaValidator::check(std::vector<MediaFile>& files, const size_t maxThreads, const ProgressCallback& progress)
+{
+	/** Thread Count */
+	size_t threadCount = maxThreads;
+	if ( threadCount == 0 ) {
+		threadCount = std::min(static_cast<size_t>(std::max(std::thread::hardware_concurrency(), 1u)), MAX_THREADS);
+	}
+	threadCount = std::max(std::min(threadCount, files.size() / FILES_PER_THREAD), static_cast<size_t>(1));
+
+	/** Each thread takes the next unchecked file until all files are checked or the check is cancelled */
+	std::atomic<size_t> next(0);
+	std::atomic<size_t> done(0);
+	std::atomic<bool> cancelled(false);
+	const auto worker = [&files, &next, &done, &cancelled](const ProgressCallback& callback) {
+		for ( size_t i = next++; i < files.size() && !cancelled; i = next++ ) {
+			files[i].problem = checkFile(files[i].path);
+			const size_t checked = ++done;
+			if ( callback && !callback(checked, files.size()) ) {
+				cancelled = true;
+			}
+		}
+	};
+
+	std::vector<std::thread> threads;
+	for ( size_t i = 1; i < threadCount; ++i ) {
+		threads.emplace_back(worker, nullptr);
+	}
+	worker(progress);
+
+	for ( size_t i = 0; i < threads.size(); ++i ) {
+		threads[i].join();
+	}
+
+	return !cancelled;
+}
+
+MusicQuiz::util::MediaValidator::Report MusicQuiz::util::MediaValidator::validate(const MusicQuiz::util::QuizDocument& document, const std::string& rootFolder, const ProgressCallback& progress)
+{
+	const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+
+	Report report;
+	report.files = resolve(document, rootFolder);
+	if ( !check(report.files, 0, progress) ) {
+		report.cancelled = true;
+		return report;
+	}
+
+	for ( size_t i = 0; i < report.files.size(); ++i ) {
+		if ( report.files[i].problem != Problem::NONE ) {
+			++report.issueCount;
+		}
+	}
+	report.elapsed = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start);
+
+	return report;
+}
+
+MusicQuiz::util::MediaValidator::Problem MusicQuiz::util::MediaValidator::checkFile(const std::string& path)
+{
+	/** Media files in a quiz package are looked up in its table of contents */
+	std::string packagePath, member;
+	if ( QuizPackage::splitPath(path, packagePath, member) ) {
+		try {
+			return QuizPackage::open(packagePath)->find(member) != nullptr ? Problem::NONE : Problem::MISSING;
+		} catch ( const std::exception& ) {
+			return Problem::UNREADABLE;
+		}
+	}
+
+	boost::system::error_code err;
+	const boost::filesystem::file_status status = boost::filesystem::status(path, err);
+	if ( !boost::filesystem::exists(status) ) {
+		return Problem::MISSING;
+	}
+
+	if ( !boost::filesystem::is_regular_file(status) ) {
+		return Problem::UNREADABLE;
+	}
+
+	/** Opening the file is the only portable way to check the permissions */
+	std::ifstream file(path, std::ios::in | std::ios::binary);
+	if ( !file.is_open() ) {
+		return Problem::UNREADABLE;
+	}
+
+	return Problem::NONE;
+}
\ No newline at end of file
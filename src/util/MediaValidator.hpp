@@ -0,0 +1,127 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include <memory>
+#include <chrono>
+#include <functional>
+
+#include "util/QuizDocument.hpp"
+
+
+namespace MusicQuiz {
+	namespace util {
+		/**
+		 * @brief Checks that the media files of a quiz exist and can be read before the quiz is loaded.
+		 *
+		 * All media paths of the quiz are resolved up front and stat'ed concurrently by a small pool of threads.
+		 * The result is a report of the files that are missing or unreadable.
+		 */
+		class MediaValidator
+		{
+		public:
+			enum class FileType
+			{
+				SONG, VIDEO
+			};
+
+			enum class Problem
+			{
+				NONE, MISSING, UNREADABLE
+			};
+
+			struct MediaFile
+			{
+				size_t category = 0;
+				size_t entry = 0;
+				FileType type = FileType::SONG;
+				std::string path = "";
+				Problem problem = Problem::NONE;
+			};
+
+			/**
+			 * @brief Called with the number of files checked and the total number of files. Returning false cancels the check.
+			 */
+			typedef std::function<bool(size_t done, size_t total)> ProgressCallback;
+
+			struct Report
+			{
+				bool cancelled = false;
+				size_t issueCount = 0;
+				std::chrono::microseconds elapsed = std::chrono::microseconds(0);
+
+				/** All media files of the quiz, in document order */
+				std::vector<MediaFile> files;
+
+				/**
+				 * @brief Returns the files with a problem.
+				 *
+				 * @return The files that are missing or unreadable, in document order.
+				 */
+				std::vector<MediaFile> getIssues() const;
+
+				/**
+				 * @brief Checks if all media files are available.
+				 *
+				 * @return True if there are no issues.
+				 */
+				bool ok() const;
+
+				/**
+				 * @brief Formats the issues as an error message, one line per file.
+				 *
+				 * @return The error message. Empty if there are no issues.
+				 */
+				std::string toString() const;
+			};
+
+			/**
+			 * @brief Deleted constructor and destructor.
+			 */
+			MediaValidator() = delete;
+			~MediaValidator() = delete;
+
+			/**
+			 * @brief Resolves the media paths of all entries in a document.
+			 *
+			 * @param[in] document The quiz document.
+			 * @param[in] rootFolder The folder the media paths in the document are relative to.
+			 *
+			 * @return The media files in document order. Video entries yield the song file followed by the video file.
+			 *         Empty media paths are skipped.
+			 */
+			static std::vector<MediaFile> resolve(const MusicQuiz::util::QuizDocument& document, const std::string& rootFolder);
+
+			/**
+			 * @brief Checks the media files concurrently and stores the result in each file.
+			 *
+			 * @param[in,out] files The files to check.
+			 * @param[in] maxThreads The maximum number of threads. Zero uses the hardware concurrency.
+			 * @param[in] progress Called on the calling thread after each file it checked. The other threads stop at their next file when it returns false.
+			 *
+			 * @return False if the check was cancelled.
+			 */
+			static bool check(std::vector<MediaFile>& files, size_t maxThreads = 0, const ProgressCallback& progress = nullptr);
+
+			/**
+			 * @brief Resolves and checks the media files of a document.
+			 *
+			 * @param[in] document The quiz document.
+			 * @param[in] rootFolder The folder the media paths in the document are relative to.
+			 * @param[in] progress Called as the files are checked, see check.
+			 *
+			 * @return The validation report.
+			 */
+			static Report validate(const MusicQuiz::util::QuizDocument& document, const std::string& rootFolder, const ProgressCallback& progress = nullptr);
+
+			/**
+			 * @brief Checks a single media file.
+			 *
+			 * @param[in] path The path of the file.
+			 *
+			 * @return The problem with the file, if any.
+			 */
+			static Problem checkFile(const std::string& path);
+		};
+	}
+}
\ No newline at end of file
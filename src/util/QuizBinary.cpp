@@ -0,0 +1,319 @@
+#include "QuizBinary.hpp"
+
+#include <cstdint>
+#include <vector>
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+#include <type_traits>
+
+#include <boost/filesystem.hpp>
+
+#include "util/MappedFile.hpp"
+
+
+namespace {
+	/** File Format */
+	const char MAGIC[4] = { 'M', 'Q', 'Z', 'B' };
+	const uint32_t VERSION = 1;
+	const uint32_t BYTE_ORDER_MARK = 0x01020304;
+	const uint32_t FLAG_GUESS_THE_CATEGORY = 1;
+
+	struct StringRef
+	{
+		uint32_t offset;
+		uint32_t size;
+	};
+
+	struct Header
+	{
+		char magic[4];
+		uint32_t version;
+		uint32_t byteOrder;
+		uint32_t flags;
+
+		int64_t sourceLastWriteTime;
+		uint64_t sourceFileSize;
+
+		StringRef quizName;
+		StringRef quizAuthor;
+		StringRef quizDescription;
+
+		uint32_t numberOfCategories;
+		uint32_t numberOfEntries;
+		uint32_t numberOfRowCategories;
+		uint32_t stringTableSize;
+	};
+
+	struct CategoryRecord
+	{
+		StringRef name;
+		uint32_t firstEntry;
+		uint32_t numberOfEntries;
+	};
+
+	struct EntryRecord
+	{
+		StringRef name;
+		StringRef answer;
+		StringRef songFile;
+		StringRef videoFile;
+
+		uint32_t type;
+		uint32_t reserved;
+
+		uint64_t points;
+		uint64_t startTime;
+		uint64_t answerStartTime;
+		uint64_t videoSongStartTime;
+	};
+
+	/** The records are written and read as is, their layout must not depend on the compiler */
+	static_assert(sizeof(StringRef) == 8, "Unexpected size of StringRef.");
+	static_assert(sizeof(Header) == 72, "Unexpected size of Header.");
+	static_assert(sizeof(CategoryRecord) == 16, "Unexpected size of CategoryRecord.");
+	static_assert(sizeof(EntryRecord) == 72, "Unexpected size of EntryRecord.");
+	static_assert(std::is_trivially_copyable<EntryRecord>::value, "Records must be trivially copyable.");
+
+	/**
+	 * @brief Appends a string to the string table.
+	 *
+	 * @param[in] table The string table.
+	 * @param[in] str The string.
+	 *
+	 * @return The reference to the string.
+	 */
+	StringRef addString(std::string& table, const std::string_view str)
+	{
+		if ( table.size() + str.size() > UINT32_MAX ) {
+			throw std::runtime_error("Quiz is too large for the binary format.");
+		}
+
+		StringRef ref;
+		ref.offset = static_cast<uint32_t>(table.size());
+		ref.size = static_cast<uint32_t>(str.size());
+		table.append(str.data(), str.size());
+		return ref;
+	}
+
+	/**
+	 * @brief Copies a record out of the mapped file.
+	 *
+	 * @param[in] data The mapped file.
+	 * @param[in] offset The offset of the record.
+	 *
+	 * @return The record.
+	 */
+	template<typename T>
+	T readRecord(const std::string_view data, const uint64_t offset)
+	{
+		T record;
+		std::memcpy(&record, data.data() + offset, sizeof(T));
+		return record;
+	}
+}
+
+
+std::string MusicQuiz::util::QuizBinary::getBinaryPath(const std::string& quizPath)
+{
+	const std::string extension = ".xml";
+	if ( quizPath.size() >= extension.size() && quizPath.compare(quizPath.size() - extension.size(), extension.size(), extension) == 0 ) {
+		return quizPath.substr(0, quizPath.size() - extension.size()) + ".bin";
+	}
+	return quizPath + ".bin";
+}
+
+bool MusicQuiz::util::QuizBinary::isUpToDate(const std::string& quizPath)
+{
+	const std::string binaryPath = getBinaryPath(quizPath);
+
+	boost::system::error_code err;
+	if ( !boost::filesystem::is_regular_file(binaryPath, err) ) {
+		return false;
+	}
+
+	const std::time_t binaryLastWriteTime = boost::filesystem::last_write_time(binaryPath, err);
+	if ( err ) {
+		return false;
+	}
+
+	const std::time_t quizLastWriteTime = boost::filesystem::last_write_time(quizPath, err);
+	if ( err ) {
+		return false;
+	}
+
+	return binaryLastWriteTime >= quizLastWriteTime;
+}
+
+void MusicQuiz::util::QuizBinary::write(const MusicQuiz::util::QuizDocument& document, const std::string& path)
+{
+	std::string strings;
+	std::vector<CategoryRecord> categoryRecords;
+	std::vector<EntryRecord> entryRecords;
+	std::vector<StringRef> rowCategoryRecords;
+
+	/** Header */
+	Header header;
+	std::memset(&header, 0, sizeof(Header));
+	std::memcpy(header.magic, MAGIC, sizeof(MAGIC));
+	header.version = VERSION;
+	header.byteOrder = BYTE_ORDER_MARK;
+	header.flags = document.guessTheCategory ? FLAG_GUESS_THE_CATEGORY : 0;
+	header.sourceLastWriteTime = static_cast<int64_t>(document.lastWriteTime);
+	header.sourceFileSize = static_cast<uint64_t>(document.fileSize);
+	header.quizName = addString(strings, document.quizName);
+	header.quizAuthor = addString(strings, document.quizAuthor);
+	header.quizDescription = addString(strings, document.quizDescription);
+
+	/** Categories */
+	for ( size_t i = 0; i < document.categories.size(); ++i ) {
+		const MusicQuiz::util::QuizDocument::Category& category = document.categories[i];
+
+		CategoryRecord categoryRecord;
+		categoryRecord.name = addString(strings, category.name);
+		categoryRecord.firstEntry = static_cast<uint32_t>(entryRecords.size());
+		categoryRecord.numberOfEntries = static_cast<uint32_t>(category.entries.size());
+		categoryRecords.push_back(categoryRecord);
+
+		/** Entries */
+		for ( size_t j = 0; j < category.entries.size(); ++j ) {
+			const MusicQuiz::util::QuizDocument::Entry& entry = category.entries[j];
+
+			EntryRecord entryRecord;
+			std::memset(&entryRecord, 0, sizeof(EntryRecord));
+			entryRecord.name = addString(strings, entry.name);
+			entryRecord.answer = addString(strings, entry.answer);
+			entryRecord.songFile = addString(strings, entry.songFile);
+			entryRecord.videoFile = addString(strings, entry.videoFile);
+			entryRecord.type = static_cast<uint32_t>(entry.type);
+			entryRecord.points = entry.points;
+			entryRecord.startTime = entry.startTime;
+			entryRecord.answerStartTime = entry.answerStartTime;
+			entryRecord.videoSongStartTime = entry.videoSongStartTime;
+			entryRecords.push_back(entryRecord);
+		}
+	}
+
+	/** Row Categories */
+	for ( size_t i = 0; i < document.rowCategories.size(); ++i ) {
+		rowCategoryRecords.push_back(addString(strings, document.rowCategories[i]));
+	}
+
+	header.numberOfCategories = static_cast<uint32_t>(categoryRecords.size());
+	header.numberOfEntries = static_cast<uint32_t>(entryRecords.size());
+	header.numberOfRowCategories = static_cast<uint32_t>(rowCategoryRecords.size());
+	header.stringTableSize = static_cast<uint32_t>(strings.size());
+
+	/** Write File */
+	const std::string tmpPath = path + ".tmp";
+	std::ofstream out(tmpPath, std::ios::binary | std::ios::trunc);
+	if ( !out.is_open() ) {
+		throw std::runtime_error("Failed to open '" + tmpPath + "'.");
+	}
+
+	out.write(reinterpret_cast<const char*>(&header), sizeof(Header));
+	out.write(reinterpret_cast<const char*>(categoryRecords.data()), static_cast<std::streamsize>(categoryRecords.size() * sizeof(CategoryRecord)));
+	out.write(reinterpret_cast<const char*>(entryRecords.data()), static_cast<std::streamsize>(entryRecords.size() * sizeof(EntryRecord)));
+	out.write(reinterpret_cast<const char*>(rowCategoryRecords.data()), static_cast<std::streamsize>(rowCategoryRecords.size() * sizeof(StringRef)));
+	out.write(strings.data(), static_cast<std::streamsize>(strings.size()));
+	out.close();
+
+	if ( !out ) {
+		boost::system::error_code err;
+		boost::filesystem::remove(tmpPath, err);
+		throw std::runtime_error("Failed to write '" + tmpPath + "'.");
+	}
+
+	boost::filesystem::rename(tmpPath, path);
+}
+
+MusicQuiz::util::QuizDocument::Ptr MusicQuiz::util::QuizBinary::read(const std::string& path, const std::string& quizPath)
+{
+	/** Map File */
+	const MusicQuiz::util::MappedFile::CPtr file = std::make_shared<const MusicQuiz::util::MappedFile>(path);
+	const std::string_view data = file->getView();
+
+	/** Header */
+	if ( data.size() < sizeof(Header) ) {
+		throw std::runtime_error("Quiz binary '" + path + "' is truncated.");
+	}
+
+	const Header header = readRecord<Header>(data, 0);
+	if ( std::memcmp(header.magic, MAGIC, sizeof(MAGIC)) != 0 || header.byteOrder != BYTE_ORDER_MARK ) {
+		throw std::runtime_error("'" + path + "' is not a quiz binary.");
+	}
+
+	if ( header.version != VERSION ) {
+		throw std::runtime_error("Quiz binary '" + path + "' has unsupported version " + std::to_string(header.version) + ".");
+	}
+
+	/** Layout */
+	const uint64_t categoriesOffset = sizeof(Header);
+	const uint64_t entriesOffset = categoriesOffset + static_cast<uint64_t>(header.numberOfCategories) * sizeof(CategoryRecord);
+	const uint64_t rowCategoriesOffset = entriesOffset + static_cast<uint64_t>(header.numberOfEntries) * sizeof(EntryRecord);
+	const uint64_t stringsOffset = rowCategoriesOffset + static_cast<uint64_t>(header.numberOfRowCategories) * sizeof(StringRef);
+	if ( stringsOffset + header.stringTableSize != data.size() ) {
+		throw std::runtime_error("Quiz binary '" + path + "' has an invalid size.");
+	}
+
+	const std::string_view strings = data.substr(stringsOffset, header.stringTableSize);
+	auto getString = [&](const StringRef& ref) {
+		if ( static_cast<uint64_t>(ref.offset) + ref.size > strings.size() ) {
+			throw std::runtime_error("Quiz binary '" + path + "' has an invalid string reference.");
+		}
+		return strings.substr(ref.offset, ref.size);
+	};
+
+	/** Quiz */
+	QuizDocument::Ptr document = std::make_shared<QuizDocument>();
+	document->path = quizPath;
+	document->lastWriteTime = static_cast<std::time_t>(header.sourceLastWriteTime);
+	document->fileSize = static_cast<std::uintmax_t>(header.sourceFileSize);
+	document->quizName = getString(header.quizName);
+	document->quizAuthor = getString(header.quizAuthor);
+	document->quizDescription = getString(header.quizDescription);
+	document->guessTheCategory = (header.flags & FLAG_GUESS_THE_CATEGORY) != 0;
+
+	/** Categories */
+	document->categories.resize(header.numberOfCategories);
+	for ( size_t i = 0; i < header.numberOfCategories; ++i ) {
+		const CategoryRecord categoryRecord = readRecord<CategoryRecord>(data, categoriesOffset + i * sizeof(CategoryRecord));
+		if ( static_cast<uint64_t>(categoryRecord.firstEntry) + categoryRecord.numberOfEntries > header.numberOfEntries ) {
+			throw std::runtime_error("Quiz binary '" + path + "' has an invalid category.");
+		}
+
+		MusicQuiz::util::QuizDocument::Category& category = document->categories[i];
+		category.name = getString(categoryRecord.name);
+
+		/** Entries */
+		category.entries.resize(categoryRecord.numberOfEntries);
+		for ( size_t j = 0; j < categoryRecord.numberOfEntries; ++j ) {
+			const EntryRecord entryRecord = readRecord<EntryRecord>(data, entriesOffset + (categoryRecord.firstEntry + j) * sizeof(EntryRecord));
+			if ( entryRecord.type > static_cast<uint32_t>(QuizDocument::EntryType::Video) ) {
+				throw std::runtime_error("Quiz binary '" + path + "' has an invalid entry type.");
+			}
+
+			MusicQuiz::util::QuizDocument::Entry& entry = category.entries[j];
+			entry.name = getString(entryRecord.name);
+			entry.answer = getString(entryRecord.answer);
+			entry.type = static_cast<QuizDocument::EntryType>(entryRecord.type);
+			entry.points = static_cast<size_t>(entryRecord.points);
+			entry.startTime = static_cast<size_t>(entryRecord.startTime);
+			entry.answerStartTime = static_cast<size_t>(entryRecord.answerStartTime);
+			entry.videoSongStartTime = static_cast<size_t>(entryRecord.videoSongStartTime);
+			entry.songFile = getString(entryRecord.songFile);
+			entry.videoFile = getString(entryRecord.videoFile);
+		}
+	}
+
+	/** Row Categories */
+	document->rowCategories.resize(header.numberOfRowCategories);
+	for ( size_t i = 0; i < header.numberOfRowCategories; ++i ) {
+		document->rowCategories[i] = getString(readRecord<StringRef>(data, rowCategoriesOffset + i * sizeof(StringRef)));
+	}
+
+	/** The strings point into the mapping */
+	document->setMapping(file);
+
+	return document;
+}
\ No newline at end of file
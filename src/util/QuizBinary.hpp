@@ -0,0 +1,63 @@
+#pragma once
+
+#include <string>
+
+#include "util/QuizDocument.hpp"
+
+
+namespace MusicQuiz {
+	namespace util {
+		/**
+		 * @brief Compiled binary form of a quiz file (.quiz.bin).
+		 *
+		 * The binary is written next to the quiz XML when the quiz is saved and is only a cache, the XML stays the source.
+		 * It consists of a header, fixed size category, entry and row category records and a string table.
+		 * Documents read from a binary keep the file mapped and their strings point into the string table.
+		 */
+		class QuizBinary
+		{
+		public:
+			/**
+			 * @brief Deleted constructor and destructor.
+			 */
+			QuizBinary() = delete;
+			~QuizBinary() = delete;
+
+			/**
+			 * @brief Returns the path of the binary belonging to a quiz file.
+			 *
+			 * @param[in] quizPath The path of the quiz XML.
+			 *
+			 * @return The path of the binary.
+			 */
+			static std::string getBinaryPath(const std::string& quizPath);
+
+			/**
+			 * @brief Checks if the binary of a quiz file exists and is at least as new as the quiz file.
+			 *
+			 * @param[in] quizPath The path of the quiz XML.
+			 *
+			 * @return True if the binary can be used instead of the XML.
+			 */
+			static bool isUpToDate(const std::string& quizPath);
+
+			/**
+			 * @brief Writes a document as a binary. The file is written to a temporary file and renamed when complete.
+			 *
+			 * @param[in] document The document to write. The version of the document is stored in the binary.
+			 * @param[in] path The path of the binary.
+			 */
+			static void write(const MusicQuiz::util::QuizDocument& document, const std::string& path);
+
+			/**
+			 * @brief Reads a binary.
+			 *
+			 * @param[in] path The path of the binary.
+			 * @param[in] quizPath The path of the quiz XML the binary was compiled from.
+			 *
+			 * @return The quiz document with the version of the XML it was compiled from.
+			 */
+			static MusicQuiz::util::QuizDocument::Ptr read(const std::string& path, const std::string& quizPath);
+		};
+	}
+}
\ No newline at end of file
@@ -0,0 +1,465 @@
+#include "QuizCatalog.hpp"
+
+#include <fstream>
+#include <stdexcept>
+#include <algorithm>
+
+#include "common/Log.hpp"
+#include "util/QuizPackage.hpp"
+
+
+namespace {
+	/** Version of the index file format. Bump when the layout changes. */
+	const std::string CATALOG_HEADER = "MusicQuizCatalog";
+	const size_t CATALOG_VERSION = 2;
+
+	/** 64-bit FNV-1a parameters */
+	const std::uint64_t FNV_OFFSET_BASIS = 14695981039346656037ULL;
+	const std::uint64_t FNV_PRIME = 1099511628211ULL;
+
+	void writeString(std::ostream& out, const std::string& str)
+	{
+		out << str.size() << ' ' << str << '\n';
+	}
+
+	std::string readString(std::istream& in)
+	{
+		size_t length = 0;
+		if ( !(in >> length) || in.get() != ' ' ) {
+			throw std::runtime_error("Malformed string in catalog index.");
+		}
+
+		std::string str(length, '\0');
+		if ( !in.read(&str[0], length) || in.get() != '\n' ) {
+			throw std::runtime_error("Truncated string in catalog index.");
+		}
+		return str;
+	}
+
+	void writeStrings(std::ostream& out, const std::vector<std::string>& strings)
+	{
+		out << strings.size() << '\n';
+		for ( size_t i = 0; i < strings.size(); ++i ) {
+			writeString(out, strings[i]);
+		}
+	}
+
+	std::vector<std::string> readStrings(std::istream& in)
+	{
+		size_t count = 0;
+		if ( !(in >> count) ) {
+			throw std::runtime_error("Malformed list in catalog index.");
+		}
+
+		std::vector<std::string> strings;
+		strings.reserve(count);
+		for ( size_t i = 0; i < count; ++i ) {
+			strings.push_back(readString(in));
+		}
+		return strings;
+	}
+}
+
+
+MusicQuiz::util::QuizCatalog::QuizCatalog(const boost::filesystem::path& dataFolder, const boost::filesystem::path& indexFile) :
+	_dataFolder(dataFolder), _indexFile(indexFile)
+{
+}
+
+MusicQuiz::util::QuizCatalog::~QuizCatalog()
+{
+	save();
+}
+
+void MusicQuiz::util::QuizCatalog::load()
+{
+	std::lock_guard<std::mutex> lock(_mutex);
+	_entries.clear();
+	_paths.clear();
+	_index.clear();
+	_dirty = false;
+
+	std::ifstream in(_indexFile.string(), std::ios::binary);
+	if ( !in.is_open() ) {
+		return;
+	}
+
+	try {
+		/** Header */
+		std::string header;
+		size_t version = 0;
+		if ( !(in >> header >> version) || header != CATALOG_HEADER || version != CATALOG_VERSION ) {
+			LOG_INFO("Ignoring catalog index '" << _indexFile.string() << "' with unknown format.");
+			return;
+		}
+
+		/** Entries */
+		size_t count = 0;
+		in >> count;
+		std::vector<Entry> entries(count);
+		for ( size_t i = 0; i < count; ++i ) {
+			Entry& entry = entries[i];
+			entry.path = readString(in);
+			entry.id = getQuizId(entry.path);
+			in >> entry.lastWriteTime >> entry.fileSize >> entry.previewValid;
+
+			if ( entry.previewValid ) {
+				QuizPreview& preview = entry.preview;
+				preview.quizName = readString(in);
+				preview.quizAuthor = readString(in);
+				preview.quizDescription = readString(in);
+				in >> preview.includeSongs >> preview.includeVideos >> preview.numberOfSongs >> preview.numberOfVideos >> preview.guessTheCategory;
+				preview.categories = readStrings(in);
+				preview.rowCategories = readStrings(in);
+			}
+
+			if ( !in ) {
+				throw std::runtime_error("Truncated catalog index.");
+			}
+		}
+		_entries = std::move(entries);
+	} catch ( const std::exception& err ) {
+		LOG_ERROR("Failed to load catalog index. " << err.what());
+		_entries.clear();
+	}
+	rebuildIndex();
+}
+
+void MusicQuiz::util::QuizCatalog::save()
+{
+	std::lock_guard<std::mutex> lock(_mutex);
+	if ( !_dirty ) {
+		return;
+	}
+
+	/** Write to a temporary file and replace the index when done */
+	const std::string tmpFile = _indexFile.string() + ".tmp";
+	{
+		std::ofstream out(tmpFile, std::ios::binary | std::ios::trunc);
+		if ( !out.is_open() ) {
+			LOG_ERROR("Failed to write catalog index '" << tmpFile << "'.");
+			return;
+		}
+
+		out << CATALOG_HEADER << ' ' << CATALOG_VERSION << '\n';
+		out << _entries.size() << '\n';
+		for ( std::map<std::string, size_t>::const_iterator it = _paths.begin(); it != _paths.end(); ++it ) {
+			const Entry& entry = _entries[it->second];
+			writeString(out, entry.path);
+			out << entry.lastWriteTime << ' ' << entry.fileSize << ' ' << entry.previewValid << '\n';
+
+			if ( entry.previewValid ) {
+				const QuizPreview& preview = entry.preview;
+				writeString(out, preview.quizName);
+				writeString(out, preview.quizAuthor);
+				writeString(out, preview.quizDescription);
+				out << preview.includeSongs << ' ' << preview.includeVideos << ' ' << preview.numberOfSongs << ' ' << preview.numberOfVideos << ' ' << preview.guessTheCategory << '\n';
+				writeStrings(out, preview.categories);
+				writeStrings(out, preview.rowCategories);
+			}
+		}
+
+		out.flush();
+		if ( !out ) {
+			LOG_ERROR("Failed to write catalog index '" << tmpFile << "'.");
+			return;
+		}
+	}
+
+	boost::system::error_code err;
+	boost::filesystem::rename(tmpFile, _indexFile, err);
+	if ( err ) {
+		LOG_ERROR("Failed to replace catalog index. " << err.message());
+		return;
+	}
+	_dirty = false;
+}
+
+void MusicQuiz::util::QuizCatalog::refresh()
+{
+	/** Check if data folder exists */
+	if ( !boost::filesystem::is_directory(_dataFolder) ) {
+		throw std::runtime_error("Data folder does not exists.");
+	}
+
+	/** Find Quizzes, the files are stat'ed on the crawler threads as they are found, only adding the entry is locked */
+	std::vector<Entry> found;
+	std::mutex foundMutex;
+	DirectoryCrawler crawler(_crawlConcurrency);
+	crawler.setFolderFilter(&QuizCatalog::isLibraryFolder);
+	crawler.setFileFilter(&QuizCatalog::isQuizFile);
+	const DirectoryCrawler::Statistics statistics = crawler.crawl(normalizePath(_dataFolder.string()), [&found, &foundMutex](const std::string& path) {
+		boost::system::error_code err;
+		Entry entry;
+		entry.id = getQuizId(path);
+		entry.path = path;
+		entry.lastWriteTime = boost::filesystem::last_write_time(path, err);
+		if ( err ) {
+			return;
+		}
+
+		entry.fileSize = boost::filesystem::file_size(path, err);
+		if ( err ) {
+			return;
+		}
+
+		std::lock_guard<std::mutex> lock(foundMutex);
+		found.push_back(std::move(entry));
+	});
+	LOG_INFO("Crawled " << statistics.directories << " folders in " << statistics.elapsed.count() / 1000 << " ms (" << statistics.getDirectoriesPerSecond()
+		<< " folders/s), " << statistics.files << " files seen, " << statistics.matches << " quizzes found, " << statistics.errors << " errors.");
+
+	/** Merge with the known entries, keeping the previews of unchanged files */
+	std::lock_guard<std::mutex> lock(_mutex);
+	bool changed = found.size() != _entries.size();
+	for ( size_t i = 0; i < found.size(); ++i ) {
+		const std::map<std::string, size_t>::const_iterator it = _paths.find(found[i].path);
+		if ( it != _paths.end() ) {
+			const std::time_t lastWriteTime = found[i].lastWriteTime;
+			const std::uintmax_t fileSize = found[i].fileSize;
+			found[i] = _entries[it->second];
+			changed |= updateEntry(found[i], lastWriteTime, fileSize);
+		} else {
+			changed = true;
+		}
+	}
+
+	_entries = std::move(found);
+	_dirty |= changed;
+	_crawlStatistics = statistics;
+	rebuildIndex();
+}
+
+MusicQuiz::util::QuizCatalog::Change MusicQuiz::util::QuizCatalog::invalidate(const std::string& quizPath)
+{
+	const std::string path = normalizePath(quizPath);
+
+	/** Stat File */
+	boost::system::error_code err;
+	const bool exists = isQuizFile(path) && boost::filesystem::is_regular_file(path, err);
+	std::time_t lastWriteTime = 0;
+	std::uintmax_t fileSize = 0;
+	if ( exists ) {
+		/** A file that can not be stat'ed is left as it is in the catalog */
+		lastWriteTime = boost::filesystem::last_write_time(path, err);
+		if ( err ) {
+			return Change::NONE;
+		}
+
+		fileSize = boost::filesystem::file_size(path, err);
+		if ( err ) {
+			return Change::NONE;
+		}
+	}
+
+	/** Update Entry */
+	std::lock_guard<std::mutex> lock(_mutex);
+	const std::map<std::string, size_t>::const_iterator it = _paths.find(path);
+	const bool known = it != _paths.end();
+
+	if ( known && !exists ) {
+		removeEntry(it->second);
+		_dirty = true;
+		return Change::REMOVED;
+	} else if ( known ) {
+		if ( updateEntry(_entries[it->second], lastWriteTime, fileSize) ) {
+			_dirty = true;
+			return Change::MODIFIED;
+		}
+	} else if ( exists ) {
+		Entry entry;
+		entry.id = getQuizId(path);
+		entry.path = path;
+		entry.lastWriteTime = lastWriteTime;
+		entry.fileSize = fileSize;
+		addEntry(std::move(entry));
+		_dirty = true;
+		return Change::ADDED;
+	}
+
+	return Change::NONE;
+}
+
+void MusicQuiz::util::QuizCatalog::setPreview(const Entry& entry)
+{
+	std::lock_guard<std::mutex> lock(_mutex);
+	const std::map<std::string, size_t>::const_iterator it = _paths.find(entry.path);
+	if ( it == _paths.end() ) {
+		return;
+	}
+
+	/** Only keep the preview if it was read from the current file version */
+	Entry& known = _entries[it->second];
+	if ( known.lastWriteTime != entry.lastWriteTime || known.fileSize != entry.fileSize ) {
+		return;
+	}
+
+	known.preview = entry.preview;
+	known.previewValid = true;
+	_dirty = true;
+}
+
+void MusicQuiz::util::QuizCatalog::setDocument(const MusicQuiz::util::QuizDocument::CPtr& document)
+{
+	std::lock_guard<std::mutex> lock(_mutex);
+	const std::map<std::string, size_t>::const_iterator it = _paths.find(normalizePath(document->path));
+	if ( it == _paths.end() ) {
+		return;
+	}
+
+	Entry& entry = _entries[it->second];
+	_dirty |= updateEntry(entry, document->lastWriteTime, document->fileSize);
+	entry.document = document;
+}
+
+std::vector<std::string> MusicQuiz::util::QuizCatalog::getQuizList() const
+{
+	std::lock_guard<std::mutex> lock(_mutex);
+	std::vector<std::string> quizList;
+	quizList.reserve(_paths.size());
+	for ( std::map<std::string, size_t>::const_iterator it = _paths.begin(); it != _paths.end(); ++it ) {
+		quizList.push_back(it->first);
+	}
+	return quizList;
+}
+
+std::vector<std::string> MusicQuiz::util::QuizCatalog::getQuizzesInFolder(const std::string& folder) const
+{
+	std::string prefix = normalizePath(folder);
+	if ( prefix.empty() || prefix.back() != '/' ) {
+		prefix += '/';
+	}
+
+	/** The paths are sorted, so the quizzes in the folder are next to each other */
+	std::lock_guard<std::mutex> lock(_mutex);
+	std::vector<std::string> quizList;
+	std::map<std::string, size_t>::const_iterator it = _paths.lower_bound(prefix);
+	for ( ; it != _paths.end() && it->first.compare(0, prefix.size(), prefix) == 0; ++it ) {
+		quizList.push_back(it->first);
+	}
+	return quizList;
+}
+
+bool MusicQuiz::util::QuizCatalog::contains(const MusicQuiz::util::QuizId id) const
+{
+	std::lock_guard<std::mutex> lock(_mutex);
+	return _index.find(id) != _index.end();
+}
+
+MusicQuiz::util::QuizCatalog::Entry MusicQuiz::util::QuizCatalog::getEntry(const MusicQuiz::util::QuizId id) const
+{
+	std::lock_guard<std::mutex> lock(_mutex);
+	const std::unordered_map<QuizId, size_t>::const_iterator it = _index.find(id);
+	if ( it == _index.end() ) {
+		throw std::runtime_error("Quiz is not in the catalog.");
+	}
+	return _entries[it->second];
+}
+
+size_t MusicQuiz::util::QuizCatalog::size() const
+{
+	std::lock_guard<std::mutex> lock(_mutex);
+	return _entries.size();
+}
+
+std::string MusicQuiz::util::QuizCatalog::normalizePath(const std::string& path)
+{
+	std::string normalized = path;
+	std::replace(normalized.begin(), normalized.end(), '\\', '/');
+	return normalized;
+}
+
+void MusicQuiz::util::QuizCatalog::setCrawlConcurrency(const size_t concurrency)
+{
+	_crawlConcurrency = concurrency;
+}
+
+MusicQuiz::util::DirectoryCrawler::Statistics MusicQuiz::util::QuizCatalog::getCrawlStatistics() const
+{
+	std::lock_guard<std::mutex> lock(_mutex);
+	return _crawlStatistics;
+}
+
+MusicQuiz::util::QuizId MusicQuiz::util::QuizCatalog::getQuizId(const std::string& quizPath)
+{
+	const std::string path = normalizePath(quizPath);
+	std::uint64_t hash = FNV_OFFSET_BASIS;
+	for ( size_t i = 0; i < path.size(); ++i ) {
+		hash ^= static_cast<unsigned char>(path[i]);
+		hash *= FNV_PRIME;
+	}
+	return hash;
+}
+
+bool MusicQuiz::util::QuizCatalog::isQuizFile(const std::string& path)
+{
+	/** Only the end of the name counts, so the temporary files of a quiz being saved are not taken for quizzes */
+	const std::string extension = ".quiz.xml";
+	if ( path.size() >= extension.size() && path.compare(path.size() - extension.size(), extension.size(), extension) == 0 ) {
+		return true;
+	}
+	return QuizPackage::isPackageFile(path);
+}
+
+bool MusicQuiz::util::QuizCatalog::isLibraryFolder(const std::string& folderName)
+{
+	return !folderName.empty() && folderName[0] != '.' && folderName != "media" && folderName != "mediaTmp" && folderName != "mediaOld";
+}
+
+bool MusicQuiz::util::QuizCatalog::updateEntry(Entry& entry, const std::time_t lastWriteTime, const std::uintmax_t fileSize)
+{
+	if ( entry.lastWriteTime == lastWriteTime && entry.fileSize == fileSize ) {
+		return false;
+	}
+
+	entry.lastWriteTime = lastWriteTime;
+	entry.fileSize = fileSize;
+	entry.previewValid = false;
+	entry.preview = MusicQuiz::util::QuizPreview();
+	entry.document = nullptr;
+	return true;
+}
+
+void MusicQuiz::util::QuizCatalog::rebuildIndex()
+{
+	_paths.clear();
+	_index.clear();
+	_index.reserve(_entries.size());
+	for ( size_t i = 0; i < _entries.size(); ++i ) {
+		_paths.emplace(_entries[i].path, i);
+		if ( !_index.emplace(_entries[i].id, i).second ) {
+			LOG_ERROR("Quiz '" << _entries[i].path << "' has the same id as quiz '" << _entries[_index[_entries[i].id]].path << "'.");
+		}
+	}
+}
+
+void MusicQuiz::util::QuizCatalog::addEntry(Entry&& entry)
+{
+	const size_t row = _entries.size();
+	_paths.emplace(entry.path, row);
+	if ( !_index.emplace(entry.id, row).second ) {
+		LOG_ERROR("Quiz '" << entry.path << "' has the same id as quiz '" << _entries[_index[entry.id]].path << "'.");
+	}
+	_entries.push_back(std::move(entry));
+}
+
+void MusicQuiz::util::QuizCatalog::removeEntry(const size_t row)
+{
+	_paths.erase(_entries[row].path);
+	const std::unordered_map<QuizId, size_t>::iterator it = _index.find(_entries[row].id);
+	if ( it != _index.end() && it->second == row ) {
+		_index.erase(it);
+	}
+
+	/** Move the last entry into the free row */
+	const size_t last = _entries.size() - 1;
+	if ( row != last ) {
+		_entries[row] = std::move(_entries[last]);
+		_paths[_entries[row].path] = row;
+		const std::unordered_map<QuizId, size_t>::iterator moved = _index.find(_entries[row].id);
+		if ( moved != _index.end() && moved->second == last ) {
+			moved->second = row;
+		}
+	}
+	_entries.pop_back();
+}
\ No newline at end of file
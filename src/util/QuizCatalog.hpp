@@ -0,0 +1,249 @@
+#pragma once
+
+#include <map>
+#include <ctime>
+#include <mutex>
+#include <string>
+#include <vector>
+#include <memory>
+#include <cstdint>
+#include <unordered_map>
+
+#include <boost/filesystem.hpp>
+
+#include "util/QuizId.hpp"
+#include "util/QuizPreview.hpp"
+#include "util/DirectoryCrawler.hpp"
+#include "util/QuizDocument.hpp"
+
+
+namespace MusicQuiz {
+	namespace util {
+		/**
+		 * @brief Persistent index of the quizzes stored in the data folder.
+		 *
+		 * The catalog is keyed by the quiz file path, its last write time and its size.
+		 * It is stored on disk such that the quiz previews only have to be parsed again when a quiz file changes.
+		 */
+		class QuizCatalog
+		{
+		public:
+			enum class Change
+			{
+				NONE, ADDED, MODIFIED, REMOVED
+			};
+
+			struct Entry
+			{
+				MusicQuiz::util::QuizId id = 0;
+				std::string path = "";
+				std::time_t lastWriteTime = 0;
+				std::uintmax_t fileSize = 0;
+
+				bool previewValid = false;
+				MusicQuiz::util::QuizPreview preview;
+
+				MusicQuiz::util::QuizDocument::CPtr document = nullptr;
+			};
+
+			/**
+			 * @brief Constructor
+			 *
+			 * @param[in] dataFolder The folder containing the quizzes.
+			 * @param[in] indexFile The file the catalog is persisted in.
+			 */
+			explicit QuizCatalog(const boost::filesystem::path& dataFolder, const boost::filesystem::path& indexFile);
+
+			/**
+			 * @brief Destructor. Writes pending changes to the index file.
+			 */
+			virtual ~QuizCatalog();
+
+			/**
+			 * @brief Shared Pointer
+			 */
+			typedef std::shared_ptr< QuizCatalog > Ptr;
+			typedef std::shared_ptr< const QuizCatalog > CPtr;
+
+			/**
+			 * @brief Deleted the copy and assignment constructor.
+			 */
+			QuizCatalog(const QuizCatalog&) = delete;
+			QuizCatalog& operator=(const QuizCatalog&) = delete;
+
+			/**
+			 * @brief Loads the catalog from the index file. A missing or corrupt index results in an empty catalog.
+			 */
+			void load();
+
+			/**
+			 * @brief Writes the catalog to the index file if it has changed since it was last written.
+			 */
+			void save();
+
+			/**
+			 * @brief Scans the data folder and invalidates the entries whose file has been added, changed or removed.
+			 *        Media folders are not scanned.
+			 */
+			void refresh();
+
+			/**
+			 * @brief Sets the number of folders read at the same time when the data folder is scanned.
+			 *
+			 * @param[in] concurrency The number of folders.
+			 */
+			void setCrawlConcurrency(size_t concurrency);
+
+			/**
+			 * @brief Returns the statistics of the last scan of the data folder.
+			 *
+			 * @return The crawl statistics.
+			 */
+			MusicQuiz::util::DirectoryCrawler::Statistics getCrawlStatistics() const;
+
+			/**
+			 * @brief Re-stats a single quiz file and updates the catalog accordingly.
+			 *
+			 * @param[in] quizPath The path of the quiz file.
+			 *
+			 * @return How the catalog entry of the file changed.
+			 */
+			Change invalidate(const std::string& quizPath);
+
+			/**
+			 * @brief Stores the preview of a quiz. The preview is discarded if the file changed since the entry was read.
+			 *
+			 * @param[in] entry The entry holding the preview.
+			 */
+			void setPreview(const Entry& entry);
+
+			/**
+			 * @brief Stores the parsed document of a quiz. The entry is updated to the file version the document was read from.
+			 *
+			 * @param[in] document The quiz document.
+			 */
+			void setDocument(const MusicQuiz::util::QuizDocument::CPtr& document);
+
+			/**
+			 * @brief Returns the list of quiz files in the catalog.
+			 *
+			 * @return The list of quizzes.
+			 */
+			std::vector<std::string> getQuizList() const;
+
+			/**
+			 * @brief Returns the quiz files in the catalog that are located in a folder or its sub folders.
+			 *
+			 * @param[in] folder The folder.
+			 *
+			 * @return The list of quizzes.
+			 */
+			std::vector<std::string> getQuizzesInFolder(const std::string& folder) const;
+
+			/**
+			 * @brief Checks if a quiz is in the catalog.
+			 *
+			 * @param[in] id The id of the quiz.
+			 *
+			 * @return True if the quiz is in the catalog.
+			 */
+			bool contains(MusicQuiz::util::QuizId id) const;
+
+			/**
+			 * @brief Returns a copy of a catalog entry.
+			 *
+			 * @param[in] id The id of the quiz.
+			 *
+			 * @return The catalog entry.
+			 */
+			Entry getEntry(MusicQuiz::util::QuizId id) const;
+
+			/**
+			 * @brief Returns the number of quizzes in the catalog.
+			 *
+			 * @return The number of quizzes.
+			 */
+			size_t size() const;
+
+			/**
+			 * @brief Converts the path to use '/' as folder separator, which is how the catalog stores paths.
+			 *
+			 * @param[in] path The path to normalize.
+			 *
+			 * @return The normalized path.
+			 */
+			static std::string normalizePath(const std::string& path);
+
+			/**
+			 * @brief Returns the id of a quiz file. The id is the 64-bit FNV-1a hash of the normalized path.
+			 *
+			 * @param[in] quizPath The path of the quiz file.
+			 *
+			 * @return The quiz id.
+			 */
+			static MusicQuiz::util::QuizId getQuizId(const std::string& quizPath);
+
+			/**
+			 * @brief Checks if a folder can contain quizzes. Media folders and hidden folders are skipped.
+			 *
+			 * @param[in] folderName The name of the folder.
+			 *
+			 * @return True if the folder should be searched for quizzes.
+			 */
+			static bool isLibraryFolder(const std::string& folderName);
+
+			/**
+			 * @brief Checks if a path is a quiz file or a quiz package.
+			 *
+			 * @param[in] path The path to check.
+			 *
+			 * @return True if the path is a quiz file.
+			 */
+			static bool isQuizFile(const std::string& path);
+
+		protected:
+			/**
+			 * @brief Updates the entry with the file status. Keeps the preview if the file is unchanged.
+			 *
+			 * @param[in] entry The entry to update.
+			 * @param[in] lastWriteTime The last write time of the file.
+			 * @param[in] fileSize The size of the file.
+			 *
+			 * @return True if the entry was changed.
+			 */
+			static bool updateEntry(Entry& entry, std::time_t lastWriteTime, std::uintmax_t fileSize);
+
+			/**
+			 * @brief Rebuilds the path and id lookup tables from the entries. Must be called with the mutex locked after the entries are replaced.
+			 */
+			void rebuildIndex();
+
+			/**
+			 * @brief Appends an entry and adds it to the lookup tables. Must be called with the mutex locked.
+			 *
+			 * @param[in] entry The entry.
+			 */
+			void addEntry(Entry&& entry);
+
+			/**
+			 * @brief Removes an entry by moving the last entry into its row and updating the lookup tables. Must be called with the mutex locked.
+			 *
+			 * @param[in] row The row of the entry.
+			 */
+			void removeEntry(size_t row);
+
+			/** Variables */
+			const boost::filesystem::path _dataFolder;
+			const boost::filesystem::path _indexFile;
+
+			bool _dirty = false;
+			size_t _crawlConcurrency = MusicQuiz::util::DirectoryCrawler::DEFAULT_CONCURRENCY;
+			MusicQuiz::util::DirectoryCrawler::Statistics _crawlStatistics;
+			/** Entries in no particular order, the path table keeps them sorted by path */
+			std::vector<Entry> _entries;
+			std::map<std::string, size_t> _paths;
+			std::unordered_map<MusicQuiz::util::QuizId, size_t> _index;
+			mutable std::mutex _mutex;
+		};
+	}
+}
\ No newline at end of file
@@ -0,0 +1,509 @@
+#include "QuizDocument.hpp"
+
+#include <charconv>
+#include <stdexcept>
+
+#include <boost/filesystem.hpp>
+
+#include "util/MappedFile.hpp"
+#include "util/QuizXmlReader.hpp"
+
+#include "common/Log.hpp"
+
+
+namespace {
+	typedef MusicQuiz::util::QuizXmlReader::Token Token;
+
+	/**
+	 * @brief Calls a function with the text of the current element and moves past its end tag.
+	 *
+	 * @param[in] reader The reader positioned at a START_ELEMENT.
+	 * @param[in] function Function called with each text of the element. The text is only valid during the call.
+	 */
+	template<typename Function>
+	void readElementText(MusicQuiz::util::QuizXmlReader& reader, Function function)
+	{
+		const size_t depth = reader.getDepth();
+		while ( true ) {
+			const Token token = reader.next();
+			if ( token == Token::TEXT && reader.getDepth() == depth ) {
+				function(reader.getText());
+			} else if ( token == Token::END_ELEMENT && reader.getDepth() < depth ) {
+				break;
+			} else if ( token == Token::END_OF_DOCUMENT ) {
+				break;
+			}
+		}
+	}
+
+	/**
+	 * @brief Reads the text of the current element and moves past its end tag.
+	 *
+	 * @param[in] reader The reader positioned at a START_ELEMENT.
+	 * @param[in] document The document to store the text in.
+	 *
+	 * @return The stored text. Empty if the element has no text.
+	 */
+	std::string_view readText(MusicQuiz::util::QuizXmlReader& reader, MusicQuiz::util::QuizDocument& document)
+	{
+		std::string_view text = "";
+		readElementText(reader, [&](const std::string_view value) {
+			if ( text.empty() ) {
+				text = document.store(value);
+			}
+		});
+		return text;
+	}
+
+	/**
+	 * @brief Reads the text of the current element as a string and moves past its end tag.
+	 *
+	 * @param[in] reader The reader positioned at a START_ELEMENT.
+	 *
+	 * @return The text. Empty if the element has no text.
+	 */
+	std::string readString(MusicQuiz::util::QuizXmlReader& reader)
+	{
+		std::string text = "";
+		readElementText(reader, [&](const std::string_view value) {
+			if ( text.empty() ) {
+				text = std::string(value);
+			}
+		});
+		return text;
+	}
+
+	/**
+	 * @brief Parses a number.
+	 *
+	 * @param[in] text The text to parse.
+	 * @param[out] value The parsed number.
+	 *
+	 * @return False if the text is not a number.
+	 */
+	bool parseNumber(const std::string_view text, size_t& value)
+	{
+		const std::from_chars_result result = std::from_chars(text.data(), text.data() + text.size(), value);
+		return result.ec == std::errc() && result.ptr == text.data() + text.size();
+	}
+
+	/**
+	 * @brief Reads the text of the current element as a number and moves past its end tag.
+	 *
+	 * @param[in] reader The reader positioned at a START_ELEMENT.
+	 * @param[out] value The parsed number.
+	 *
+	 * @return False if the text is not a number.
+	 */
+	bool readNumber(MusicQuiz::util::QuizXmlReader& reader, size_t& value)
+	{
+		bool valid = true;
+		readElementText(reader, [&](const std::string_view text) {
+			valid = parseNumber(text, value);
+		});
+		return valid;
+	}
+
+	/**
+	 * @brief Reads a number attribute of the current element.
+	 *
+	 * @param[in] reader The reader positioned at a START_ELEMENT.
+	 * @param[in] name The attribute name.
+	 *
+	 * @return The value of the attribute. Zero if it does not exists or is not a number.
+	 */
+	size_t readNumberAttribute(const MusicQuiz::util::QuizXmlReader& reader, const std::string_view name)
+	{
+		size_t value = 0;
+		std::string_view text;
+		if ( !reader.getAttribute(name, text) || !parseNumber(text, value) ) {
+			return 0;
+		}
+		return value;
+	}
+
+	/**
+	 * @brief Reads a boolean attribute of the current element.
+	 *
+	 * @param[in] reader The reader positioned at a START_ELEMENT.
+	 * @param[in] name The attribute name.
+	 * @param[in] defaultValue The value used if the attribute does not exists.
+	 *
+	 * @return The value of the attribute.
+	 */
+	bool readBoolAttribute(const MusicQuiz::util::QuizXmlReader& reader, const std::string_view name, const bool defaultValue)
+	{
+		std::string_view value;
+		if ( !reader.getAttribute(name, value) ) {
+			return defaultValue;
+		}
+
+		if ( value == "true" || value == "1" ) {
+			return true;
+		} else if ( value == "false" || value == "0" ) {
+			return false;
+		}
+		return defaultValue;
+	}
+
+	/**
+	 * @brief Reads a QuizEntry element.
+	 *
+	 * @param[in] reader The reader positioned at the START_ELEMENT of the entry.
+	 * @param[in] document The document to store the strings in.
+	 * @param[out] entry The entry.
+	 * @param[out] err Description of the problem if the entry is invalid.
+	 *
+	 * @return False if the entry is invalid.
+	 */
+	bool readEntry(MusicQuiz::util::QuizXmlReader& reader, MusicQuiz::util::QuizDocument& document, MusicQuiz::util::QuizDocument::Entry& entry, std::string& err)
+	{
+		typedef MusicQuiz::util::QuizDocument::EntryType EntryType;
+		bool valid = true;
+
+		/** Media Type */
+		std::string_view value;
+		if ( !reader.getAttribute("type", value) ) {
+			valid = false;
+			err = "Entry has no type.";
+		} else if ( value == "song" ) {
+			entry.type = EntryType::Song;
+		} else if ( value == "video" ) {
+			entry.type = EntryType::Video;
+		} else {
+			valid = false;
+			err = "Unknown type '" + std::string(value) + "'.";
+		}
+
+		/** Name */
+		if ( reader.getAttribute("name", value) ) {
+			entry.name = document.store(value);
+		}
+
+		/** Settings */
+		const size_t depth = reader.getDepth();
+		while ( true ) {
+			const Token token = reader.next();
+			if ( token == Token::END_OF_DOCUMENT || (token == Token::END_ELEMENT && reader.getDepth() < depth) ) {
+				break;
+			} else if ( token != Token::START_ELEMENT ) {
+				continue;
+			}
+
+			bool number = true;
+			const std::string_view name = reader.getName();
+			if ( name == "Answer" ) {
+				entry.answer = readText(reader, document);
+			} else if ( name == "Points" ) {
+				number = readNumber(reader, entry.points);
+			} else if ( name == "StartTime" ) {
+				number = readNumber(reader, entry.startTime);
+			} else if ( name == "AnswerStartTime" ) {
+				number = readNumber(reader, entry.answerStartTime);
+			} else if ( name == "VideoSongStartTime" ) {
+				number = readNumber(reader, entry.videoSongStartTime);
+			} else if ( name != "Media" ) {
+				reader.skipElement();
+			}
+
+			if ( !number && valid ) {
+				valid = false;
+				err = "'" + std::string(name) + "' is not a number.";
+			}
+
+			/** Media Files */
+			if ( name == "Media" ) {
+				const size_t mediaDepth = reader.getDepth();
+				while ( true ) {
+					const Token mediaToken = reader.next();
+					if ( mediaToken == Token::END_OF_DOCUMENT || (mediaToken == Token::END_ELEMENT && reader.getDepth() < mediaDepth) ) {
+						break;
+					} else if ( mediaToken != Token::START_ELEMENT ) {
+						continue;
+					}
+
+					if ( reader.getName() == "SongFile" ) {
+						entry.songFile = readText(reader, document);
+					} else if ( reader.getName() == "VideoFile" ) {
+						entry.videoFile = readText(reader, document);
+					} else {
+						reader.skipElement();
+					}
+				}
+			}
+		}
+
+		return valid;
+	}
+}
+
+
+MusicQuiz::util::QuizDocument::Ptr MusicQuiz::util::QuizDocument::fromFile(const std::string& path)
+{
+	/** Sanity Check */
+	if ( !boost::filesystem::exists(path) ) {
+		throw std::runtime_error("Quiz file does not exists.");
+	}
+
+	/** Map File */
+	const MusicQuiz::util::MappedFile file(path);
+
+	/** Parse File */
+	QuizDocument::Ptr document = fromBuffer(file.getView(), path);
+	document->lastWriteTime = boost::filesystem::last_write_time(path);
+	document->fileSize = file.getSize();
+
+	return document;
+}
+
+MusicQuiz::util::QuizDocument::Ptr MusicQuiz::util::QuizDocument::fromBuffer(const std::string_view buffer, const std::string& path)
+{
+	QuizDocument::Ptr document = std::make_shared<QuizDocument>();
+	document->path = path;
+
+	/** Root */
+	MusicQuiz::util::QuizXmlReader reader(buffer);
+	Token token = reader.next();
+	while ( token != Token::START_ELEMENT && token != Token::END_OF_DOCUMENT ) {
+		token = reader.next();
+	}
+	if ( token != Token::START_ELEMENT || reader.getName() != "MusicQuiz" ) {
+		throw std::runtime_error("No such node (MusicQuiz)");
+	}
+
+	bool hasName = false, hasAuthor = false, hasDescription = false;
+	while ( (token = reader.next()) != Token::END_OF_DOCUMENT ) {
+		if ( token == Token::END_ELEMENT && reader.getDepth() == 0 ) {
+			break;
+		} else if ( token != Token::START_ELEMENT ) {
+			continue;
+		}
+
+		const std::string_view name = reader.getName();
+		if ( name == "QuizName" ) { // Name
+			document->quizName = readText(reader, *document);
+			hasName = true;
+		} else if ( name == "QuizAuthor" ) { // Author
+			document->quizAuthor = readText(reader, *document);
+			hasAuthor = true;
+		} else if ( name == "QuizDescription" ) { // Description
+			document->quizDescription = readText(reader, *document);
+			hasDescription = true;
+		} else if ( name == "QuizGuessTheCategory" ) { // Guess the Category
+			document->guessTheCategory = readBoolAttribute(reader, "enabled", false);
+			reader.skipElement();
+		} else if ( name == "QuizCategories" ) { // Load Categories
+			while ( (token = reader.next()) != Token::END_OF_DOCUMENT ) {
+				if ( token == Token::END_ELEMENT && reader.getDepth() == 1 ) {
+					break;
+				} else if ( token != Token::START_ELEMENT ) {
+					continue;
+				} else if ( reader.getName() != "Category" ) {
+					reader.skipElement();
+					continue;
+				}
+
+				/** Category Name */
+				Category category;
+				std::string_view value;
+				if ( !reader.getAttribute("name", value) ) {
+					throw std::runtime_error("No such node (<xmlattr>.name)");
+				}
+				category.name = document->store(value);
+
+				/** Category Entries */
+				while ( (token = reader.next()) != Token::END_OF_DOCUMENT ) {
+					if ( token == Token::END_ELEMENT && reader.getDepth() == 2 ) {
+						break;
+					} else if ( token != Token::START_ELEMENT ) {
+						continue;
+					} else if ( reader.getName() != "QuizEntry" ) {
+						reader.skipElement();
+						continue;
+					}
+
+					Entry entry;
+					std::string err = "";
+					if ( readEntry(reader, *document, entry, err) ) {
+						category.entries.push_back(entry);
+					} else {
+						LOG_ERROR("Failed to load entry in category '" << category.name << "' in '" << path << "'. " << err);
+					}
+				}
+
+				document->categories.push_back(std::move(category));
+			}
+		} else if ( name == "QuizRowCategories" ) { // Load Row Categories
+			while ( (token = reader.next()) != Token::END_OF_DOCUMENT ) {
+				if ( token == Token::END_ELEMENT && reader.getDepth() == 1 ) {
+					break;
+				} else if ( token != Token::START_ELEMENT ) {
+					continue;
+				}
+
+				if ( reader.getName() == "RowCategory" ) {
+					document->rowCategories.push_back(readText(reader, *document));
+				} else {
+					reader.skipElement();
+				}
+			}
+		} else {
+			reader.skipElement();
+		}
+	}
+
+	/** Required Fields */
+	if ( !hasName ) {
+		throw std::runtime_error("No such node (QuizName)");
+	} else if ( !hasAuthor ) {
+		throw std::runtime_error("No such node (QuizAuthor)");
+	} else if ( !hasDescription ) {
+		throw std::runtime_error("No such node (QuizDescription)");
+	}
+
+	return document;
+}
+
+MusicQuiz::util::QuizPreview MusicQuiz::util::QuizDocument::readPreview(const std::string& path)
+{
+	/** Sanity Check */
+	if ( !boost::filesystem::exists(path) ) {
+		throw std::runtime_error("Quiz file does not exists.");
+	}
+
+	/** Map File. Only the pages up to the summary are read */
+	const MusicQuiz::util::MappedFile file(path);
+	return previewFromBuffer(file.getView(), path);
+}
+
+MusicQuiz::util::QuizPreview MusicQuiz::util::QuizDocument::previewFromBuffer(const std::string_view buffer, const std::string& path)
+{
+	QuizPreview quizPreview;
+
+	/** Root */
+	MusicQuiz::util::QuizXmlReader reader(buffer);
+	Token token = reader.next();
+	while ( token != Token::START_ELEMENT && token != Token::END_OF_DOCUMENT ) {
+		token = reader.next();
+	}
+	if ( token != Token::START_ELEMENT || reader.getName() != "MusicQuiz" ) {
+		throw std::runtime_error("No such node (MusicQuiz)");
+	}
+
+	/** Header */
+	bool hasName = false, hasAuthor = false, hasDescription = false, hasSummary = false;
+	while ( !hasSummary && (token = reader.next()) != Token::END_OF_DOCUMENT ) {
+		if ( token == Token::END_ELEMENT && reader.getDepth() == 0 ) {
+			break;
+		} else if ( token != Token::START_ELEMENT ) {
+			continue;
+		}
+
+		const std::string_view name = reader.getName();
+		if ( name == "QuizName" ) { // Name
+			quizPreview.quizName = readString(reader);
+			hasName = true;
+		} else if ( name == "QuizAuthor" ) { // Author
+			quizPreview.quizAuthor = readString(reader);
+			hasAuthor = true;
+		} else if ( name == "QuizDescription" ) { // Description
+			quizPreview.quizDescription = readString(reader);
+			hasDescription = true;
+		} else if ( name == "QuizGuessTheCategory" ) { // Guess the Category
+			quizPreview.guessTheCategory = readBoolAttribute(reader, "enabled", false);
+			reader.skipElement();
+		} else if ( name == "QuizSummary" ) { // Summary
+			quizPreview.numberOfSongs = readNumberAttribute(reader, "songs");
+			quizPreview.numberOfVideos = readNumberAttribute(reader, "videos");
+			quizPreview.includeSongs = quizPreview.numberOfSongs > 0;
+			quizPreview.includeVideos = quizPreview.numberOfVideos > 0;
+
+			while ( (token = reader.next()) != Token::END_OF_DOCUMENT ) {
+				if ( token == Token::END_ELEMENT && reader.getDepth() == 1 ) {
+					break;
+				} else if ( token != Token::START_ELEMENT ) {
+					continue;
+				}
+
+				std::string_view value;
+				if ( reader.getName() == "Category" && reader.getAttribute("name", value) ) {
+					quizPreview.categories.push_back(std::string(value));
+					reader.skipElement();
+				} else if ( reader.getName() == "RowCategory" ) {
+					quizPreview.rowCategories.push_back(readString(reader));
+				} else {
+					reader.skipElement();
+				}
+			}
+			hasSummary = true;
+		} else { // The summary is written before the categories, older files do not have one
+			break;
+		}
+	}
+
+	/** Read the whole file if it has no summary */
+	if ( !hasSummary ) {
+		return fromBuffer(buffer, path)->toPreview();
+	}
+
+	/** Required Fields */
+	if ( !hasName ) {
+		throw std::runtime_error("No such node (QuizName)");
+	} else if ( !hasAuthor ) {
+		throw std::runtime_error("No such node (QuizAuthor)");
+	} else if ( !hasDescription ) {
+		throw std::runtime_error("No such node (QuizDescription)");
+	}
+
+	return quizPreview;
+}
+
+std::string_view MusicQuiz::util::QuizDocument::store(const std::string_view str)
+{
+	return _arena.store(str);
+}
+
+void MusicQuiz::util::QuizDocument::setMapping(const MusicQuiz::util::MappedFile::CPtr& mapping)
+{
+	_mapping = mapping;
+}
+
+size_t MusicQuiz::util::QuizDocument::getNumberOfEntries() const
+{
+	size_t numberOfEntries = 0;
+	for ( size_t i = 0; i < categories.size(); ++i ) {
+		numberOfEntries += categories[i].entries.size();
+	}
+	return numberOfEntries;
+}
+
+MusicQuiz::util::QuizPreview MusicQuiz::util::QuizDocument::toPreview() const
+{
+	QuizPreview quizPreview;
+	quizPreview.quizName = std::string(quizName);
+	quizPreview.quizAuthor = std::string(quizAuthor);
+	quizPreview.quizDescription = std::string(quizDescription);
+	quizPreview.guessTheCategory = guessTheCategory;
+
+	/** Categories */
+	for ( size_t i = 0; i < categories.size(); ++i ) {
+		quizPreview.categories.push_back(std::string(categories[i].name));
+		for ( size_t j = 0; j < categories[i].entries.size(); ++j ) {
+			if ( categories[i].entries[j].type == EntryType::Song ) {
+				++quizPreview.numberOfSongs;
+			} else if ( categories[i].entries[j].type == EntryType::Video ) {
+				++quizPreview.numberOfVideos;
+			}
+		}
+	}
+
+	quizPreview.includeSongs = quizPreview.numberOfSongs > 0;
+	quizPreview.includeVideos = quizPreview.numberOfVideos > 0;
+
+	/** Row Categories */
+	for ( size_t i = 0; i < rowCategories.size(); ++i ) {
+		quizPreview.rowCategories.push_back(std::string(rowCategories[i]));
+	}
+
+	return quizPreview;
+}
\ No newline at end of file
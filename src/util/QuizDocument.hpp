@@ -0,0 +1,164 @@
+#pragma once
+
+#include <ctime>
+#include <string>
+#include <vector>
+#include <memory>
+#include <cstdint>
+#include <string_view>
+
+#include "util/MappedFile.hpp"
+#include "util/QuizPreview.hpp"
+#include "util/StringArena.hpp"
+
+
+namespace MusicQuiz {
+	namespace util {
+		/**
+		 * @brief Parsed content of a quiz file.
+		 *
+		 * A document is produced once per file version and shared between its consumers as an immutable object.
+		 * All strings are views into the document's own storage.
+		 */
+		class QuizDocument
+		{
+		public:
+			enum class EntryType
+			{
+				Song = 0, Video = 1
+			};
+
+			struct Entry
+			{
+				std::string_view name;
+				std::string_view answer;
+				EntryType type = EntryType::Song;
+
+				size_t points = 0;
+				size_t startTime = 0;
+				size_t answerStartTime = 0;
+				size_t videoSongStartTime = 0;
+
+				std::string_view songFile;
+				std::string_view videoFile;
+			};
+
+			struct Category
+			{
+				std::string_view name;
+				std::vector<Entry> entries;
+			};
+
+			/**
+			 * @brief Default constructor
+			 */
+			QuizDocument() = default;
+
+			/**
+			 * @brief Default destructor
+			 */
+			virtual ~QuizDocument() = default;
+
+			/**
+			 * @brief Shared Pointer
+			 */
+			typedef std::shared_ptr< QuizDocument > Ptr;
+			typedef std::shared_ptr< const QuizDocument > CPtr;
+
+			/**
+			 * @brief Deleted the copy and assignment constructor.
+			 */
+			QuizDocument(const QuizDocument&) = delete;
+			QuizDocument& operator=(const QuizDocument&) = delete;
+
+			/**
+			 * @brief Parses a quiz file.
+			 *
+			 * @param[in] path The path of the quiz file.
+			 *
+			 * @return The quiz document.
+			 */
+			static Ptr fromFile(const std::string& path);
+
+			/**
+			 * @brief Parses a quiz from memory. The strings are copied into the document,
+			 *        so the buffer does not have to outlive it.
+			 *
+			 * @param[in] buffer The XML content of the quiz file.
+			 * @param[in] path The path the content was read from.
+			 *
+			 * @return The quiz document.
+			 */
+			static Ptr fromBuffer(std::string_view buffer, const std::string& path);
+
+			/**
+			 * @brief Reads the preview of a quiz file. Reading stops after the summary block
+			 *        written by the quiz creator. Files without a summary are parsed completely.
+			 *
+			 * @param[in] path The path of the quiz file.
+			 *
+			 * @return The quiz preview.
+			 */
+			static MusicQuiz::util::QuizPreview readPreview(const std::string& path);
+
+			/**
+			 * @brief Reads the preview of a quiz from memory.
+			 *
+			 * @param[in] buffer The XML content of the quiz file.
+			 * @param[in] path The path the content was read from.
+			 *
+			 * @return The quiz preview.
+			 */
+			static MusicQuiz::util::QuizPreview previewFromBuffer(std::string_view buffer, const std::string& path);
+
+			/**
+			 * @brief Copies a string into the document storage.
+			 *
+			 * @param[in] str The string to store.
+			 *
+			 * @return A view of the stored string that lives as long as the document.
+			 */
+			std::string_view store(std::string_view str);
+
+			/**
+			 * @brief Keeps a mapped file alive for as long as the document. Used when the strings point into the mapping.
+			 *
+			 * @param[in] mapping The mapped file.
+			 */
+			void setMapping(const MusicQuiz::util::MappedFile::CPtr& mapping);
+
+			/**
+			 * @brief Returns the number of entries in the quiz.
+			 *
+			 * @return The number of entries.
+			 */
+			size_t getNumberOfEntries() const;
+
+			/**
+			 * @brief Creates the quiz preview from the document.
+			 *
+			 * @return The quiz preview.
+			 */
+			MusicQuiz::util::QuizPreview toPreview() const;
+
+			/** Source File */
+			std::string path = "";
+			std::time_t lastWriteTime = 0;
+			std::uintmax_t fileSize = 0;
+
+			/** Quiz */
+			std::string_view quizName;
+			std::string_view quizAuthor;
+			std::string_view quizDescription;
+			bool guessTheCategory = false;
+
+			std::vector<Category> categories;
+			std::vector<std::string_view> rowCategories;
+
+		protected:
+			/** Variables */
+			MusicQuiz::util::StringArena _arena;
+			MusicQuiz::util::MappedFile::CPtr _mapping = nullptr;
+		};
+	}
+}
\ No newline at end of file
@@ -0,0 +1,16 @@
+#pragma once
+
+#include <cstdint>
+
+
+namespace MusicQuiz {
+	namespace util {
+		/**
+		 * @brief Identifier of a quiz in the catalog.
+		 *
+		 * The id is a hash of the normalized quiz file path, see QuizCatalog::getQuizId. Unlike the position in the catalog
+		 * it stays the same while quizzes are added to or removed from the data folder.
+		 */
+		typedef std::uint64_t QuizId;
+	}
+}
\ No newline at end of file
@@ -0,0 +1,344 @@
+#include "QuizLibraryWatcher.hpp"
+
+#include <vector>
+
+#include <QStringList>
+#include <QSocketNotifier>
+#include <QFileSystemWatcher>
+
+#include <boost/filesystem.hpp>
+
+#if defined(__linux__)
+#include <unistd.h>
+#include <sys/inotify.h>
+#endif
+
+#include "common/Log.hpp"
+
+
+namespace {
+	/** Time to wait for more changes before they are applied */
+	const int SETTLE_TIME_MS = 250;
+
+	/**
+	 * @brief Converts a folder to the form used by the catalog, with '/' as separator and without a trailing separator.
+	 *
+	 * @param[in] folder The folder.
+	 *
+	 * @return The folder path.
+	 */
+	std::string toFolderPath(const std::string& folder)
+	{
+		std::string path = MusicQuiz::util::QuizCatalog::normalizePath(folder);
+		while ( path.size() > 1 && path.back() == '/' ) {
+			path.pop_back();
+		}
+		return path;
+	}
+
+	/**
+	 * @brief Finds the quiz files in a folder and its watched sub folders.
+	 *
+	 * @param[in] folder The folder to search.
+	 * @param[out] quizzes The quiz files found.
+	 */
+	void findQuizzes(const std::string& folder, std::set<std::string>& quizzes)
+	{
+		boost::system::error_code err;
+		boost::filesystem::directory_iterator it(folder, err), end;
+		for ( ; !err && it != end; it.increment(err) ) {
+			const std::string name = it->path().filename().string();
+			const std::string path = folder + "/" + name;
+			if ( boost::filesystem::is_directory(it->symlink_status(err)) ) {
+				if ( MusicQuiz::util::QuizLibraryWatcher::isWatchedFolder(name) ) {
+					findQuizzes(path, quizzes);
+				}
+			} else if ( MusicQuiz::util::QuizCatalog::isQuizFile(path) ) {
+				quizzes.insert(path);
+			}
+		}
+	}
+}
+
+
+MusicQuiz::util::QuizLibraryWatcher::QuizLibraryWatcher(const std::string& dataFolder, const MusicQuiz::util::QuizCatalog::Ptr& catalog, QObject* parent) :
+	QObject(parent), _dataFolder(toFolderPath(dataFolder)), _catalog(catalog)
+{
+	/** Settle Timer */
+	_timer.setSingleShot(true);
+	_timer.setInterval(SETTLE_TIME_MS);
+	connect(&_timer, SIGNAL(timeout()), this, SLOT(applyChanges()));
+
+#if defined(__linux__)
+	/** inotify */
+	_inotifyFd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+	if ( _inotifyFd >= 0 ) {
+		_notifier = new QSocketNotifier(_inotifyFd, QSocketNotifier::Read, this);
+		connect(_notifier, SIGNAL(activated(int)), this, SLOT(readEvents()));
+	} else {
+		LOG_WARN("Failed to initialize inotify, falling back to QFileSystemWatcher.");
+	}
+#endif
+
+	/** QFileSystemWatcher */
+	if ( _inotifyFd < 0 ) {
+		_watcher = new QFileSystemWatcher(this);
+		connect(_watcher, SIGNAL(directoryChanged(const QString&)), this, SLOT(folderChanged(const QString&)));
+		connect(_watcher, SIGNAL(fileChanged(const QString&)), this, SLOT(fileChanged(const QString&)));
+	}
+
+	/** Watch Data Folder */
+	watchFolder(_dataFolder);
+}
+
+MusicQuiz::util::QuizLibraryWatcher::~QuizLibraryWatcher()
+{
+#if defined(__linux__)
+	if ( _inotifyFd >= 0 ) {
+		close(_inotifyFd);
+	}
+#endif
+}
+
+void MusicQuiz::util::QuizLibraryWatcher::invalidate(const std::string& path)
+{
+	addPending(toFolderPath(path));
+	applyChanges();
+}
+
+bool MusicQuiz::util::QuizLibraryWatcher::isWatchedFolder(const std::string& folderName)
+{
+	return MusicQuiz::util::QuizCatalog::isLibraryFolder(folderName);
+}
+
+void MusicQuiz::util::QuizLibraryWatcher::readEvents()
+{
+#if defined(__linux__)
+	alignas(struct inotify_event) char buffer[16 * 1024];
+	while ( true ) {
+		const ssize_t length = read(_inotifyFd, buffer, sizeof(buffer));
+		if ( length <= 0 ) {
+			break;
+		}
+
+		for ( ssize_t offset = 0; offset < length; ) {
+			const struct inotify_event* event = reinterpret_cast<const struct inotify_event*>(buffer + offset);
+			offset += sizeof(struct inotify_event) + event->len;
+
+			/** Events were lost, rescan everything */
+			if ( (event->mask & IN_Q_OVERFLOW) != 0 ) {
+				LOG_WARN("Quiz library event queue overflowed, rescanning the data folder.");
+				addPending(_dataFolder);
+				continue;
+			}
+
+			const std::unordered_map<int, std::string>::const_iterator it = _watches.find(event->wd);
+			if ( it == _watches.end() ) {
+				continue;
+			}
+
+			/** Watch was removed */
+			if ( (event->mask & IN_IGNORED) != 0 ) {
+				_watches.erase(it);
+				continue;
+			}
+
+			if ( event->len == 0 ) {
+				continue;
+			}
+
+			const std::string name(event->name);
+			const std::string path = it->second + "/" + name;
+			if ( (event->mask & IN_ISDIR) != 0 ) {
+				if ( !isWatchedFolder(name) ) {
+					continue;
+				}
+
+				if ( (event->mask & (IN_CREATE | IN_MOVED_TO)) != 0 ) {
+					watchFolder(path);
+				} else if ( (event->mask & IN_MOVED_FROM) != 0 ) {
+					unwatchFolder(path);
+				}
+				addPending(path);
+			} else if ( MusicQuiz::util::QuizCatalog::isQuizFile(path) ) {
+				addPending(path);
+			}
+		}
+	}
+#endif
+}
+
+void MusicQuiz::util::QuizLibraryWatcher::folderChanged(const QString& path)
+{
+	const std::string folder = toFolderPath(path.toStdString());
+
+	/** Folder was removed or renamed */
+	boost::system::error_code err;
+	if ( !boost::filesystem::is_directory(folder, err) ) {
+		addPending(folder);
+		return;
+	}
+
+	/** New sub folders and quiz files */
+	const QStringList watched = _watcher->directories() + _watcher->files();
+	boost::filesystem::directory_iterator it(folder, err), end;
+	for ( ; !err && it != end; it.increment(err) ) {
+		const std::string name = it->path().filename().string();
+		const std::string childPath = folder + "/" + name;
+		if ( watched.contains(QString::fromStdString(childPath)) ) {
+			continue;
+		}
+
+		if ( boost::filesystem::is_directory(it->symlink_status(err)) ) {
+			if ( isWatchedFolder(name) ) {
+				watchFolder(childPath);
+				addPending(childPath);
+			}
+		} else if ( MusicQuiz::util::QuizCatalog::isQuizFile(childPath) ) {
+			_watcher->addPath(QString::fromStdString(childPath));
+			addPending(childPath);
+		}
+	}
+
+	/** Removed quiz files */
+	const std::vector<std::string> quizzes = _catalog->getQuizzesInFolder(folder);
+	for ( size_t i = 0; i < quizzes.size(); ++i ) {
+		if ( !boost::filesystem::exists(quizzes[i], err) ) {
+			addPending(quizzes[i]);
+		}
+	}
+}
+
+void MusicQuiz::util::QuizLibraryWatcher::fileChanged(const QString& path)
+{
+	const std::string file = MusicQuiz::util::QuizCatalog::normalizePath(path.toStdString());
+
+	/** Files replaced by a rename are no longer watched */
+	boost::system::error_code err;
+	if ( boost::filesystem::exists(file, err) && !_watcher->files().contains(path) ) {
+		_watcher->addPath(path);
+	}
+	addPending(file);
+}
+
+void MusicQuiz::util::QuizLibraryWatcher::applyChanges()
+{
+	_timer.stop();
+
+	std::set<std::string> pending;
+	std::swap(pending, _pending);
+
+	/** Collect the affected quizzes, both the known ones and the ones on disk */
+	std::set<std::string> quizzes;
+	boost::system::error_code err;
+	for ( std::set<std::string>::const_iterator it = pending.begin(); it != pending.end(); ++it ) {
+		if ( MusicQuiz::util::QuizCatalog::isQuizFile(*it) ) {
+			quizzes.insert(*it);
+		}
+
+		const std::vector<std::string> known = _catalog->getQuizzesInFolder(*it);
+		quizzes.insert(known.begin(), known.end());
+
+		if ( boost::filesystem::is_directory(*it, err) ) {
+			findQuizzes(*it, quizzes);
+		}
+	}
+
+	/** Update Catalog */
+	bool changed = false;
+	for ( std::set<std::string>::const_iterator it = quizzes.begin(); it != quizzes.end(); ++it ) {
+		try {
+			const QuizCatalog::Change change = _catalog->invalidate(*it);
+			changed = changed || change != QuizCatalog::Change::NONE;
+			if ( change == QuizCatalog::Change::ADDED ) {
+				LOG_INFO("Quiz added '" << *it << "'.");
+				emit quizAdded(QString::fromStdString(*it));
+			} else if ( change == QuizCatalog::Change::MODIFIED ) {
+				LOG_INFO("Quiz modified '" << *it << "'.");
+				emit quizModified(QString::fromStdString(*it));
+			} else if ( change == QuizCatalog::Change::REMOVED ) {
+				LOG_INFO("Quiz removed '" << *it << "'.");
+				emit quizRemoved(QString::fromStdString(*it));
+			}
+		} catch ( const std::exception& error ) {
+			LOG_ERROR("Failed to update quiz '" << *it << "'. " << error.what());
+		}
+	}
+
+	/** The catalog is saved once per batch, listeners do their own batch work on changesApplied */
+	if ( changed ) {
+		_catalog->save();
+		emit changesApplied();
+	}
+}
+
+void MusicQuiz::util::QuizLibraryWatcher::watchFolder(const std::string& folder)
+{
+	boost::system::error_code err;
+	if ( !boost::filesystem::is_directory(folder, err) ) {
+		return;
+	}
+
+#if defined(__linux__)
+	if ( _inotifyFd >= 0 ) {
+		const uint32_t mask = IN_CREATE | IN_DELETE | IN_CLOSE_WRITE | IN_MOVED_FROM | IN_MOVED_TO | IN_ONLYDIR;
+		const int wd = inotify_add_watch(_inotifyFd, folder.c_str(), mask);
+		if ( wd < 0 ) {
+			LOG_ERROR("Failed to watch folder '" << folder << "'.");
+			return;
+		}
+		_watches[wd] = folder;
+	}
+#endif
+
+	if ( _watcher != nullptr ) {
+		_watcher->addPath(QString::fromStdString(folder));
+	}
+
+	/** Sub Folders and Quiz Files */
+	boost::filesystem::directory_iterator it(folder, err), end;
+	for ( ; !err && it != end; it.increment(err) ) {
+		const std::string name = it->path().filename().string();
+		const std::string path = folder + "/" + name;
+		if ( boost::filesystem::is_directory(it->symlink_status(err)) ) {
+			if ( isWatchedFolder(name) ) {
+				watchFolder(path);
+			}
+		} else if ( _watcher != nullptr && MusicQuiz::util::QuizCatalog::isQuizFile(path) ) {
+			_watcher->addPath(QString::fromStdString(path));
+		}
+	}
+}
+
+void MusicQuiz::util::QuizLibraryWatcher::unwatchFolder(const std::string& folder)
+{
+	const std::string prefix = folder + "/";
+
+#if defined(__linux__)
+	std::unordered_map<int, std::string>::iterator it = _watches.begin();
+	while ( it != _watches.end() ) {
+		if ( it->second == folder || it->second.compare(0, prefix.size(), prefix) == 0 ) {
+			inotify_rm_watch(_inotifyFd, it->first);
+			it = _watches.erase(it);
+		} else {
+			++it;
+		}
+	}
+#endif
+
+	if ( _watcher != nullptr ) {
+		const QStringList watched = _watcher->directories() + _watcher->files();
+		for ( int i = 0; i < watched.size(); ++i ) {
+			const std::string path = watched[i].toStdString();
+			if ( path == folder || path.compare(0, prefix.size(), prefix) == 0 ) {
+				_watcher->removePath(watched[i]);
+			}
+		}
+	}
+}
+
+void MusicQuiz::util::QuizLibraryWatcher::addPending(const std::string& path)
+{
+	_pending.insert(path);
+	_timer.start();
+}
\ No newline at end of file
@@ -0,0 +1,136 @@
+#pragma once
+
+#include <set>
+#include <string>
+#include <unordered_map>
+
+#include <QTimer>
+#include <QObject>
+#include <QString>
+
+#include "util/QuizCatalog.hpp"
+
+class QSocketNotifier;
+class QFileSystemWatcher;
+
+
+namespace MusicQuiz {
+	namespace util {
+		/**
+		 * @brief Watches the data folder and applies the changes to the quiz catalog as they happen.
+		 *
+		 * On Linux the folders are watched with inotify, on other platforms with a QFileSystemWatcher.
+		 * Changes are collected for a short while before they are applied, such that a quiz folder being copied
+		 * into the data folder results in one update. Media folders and links to folders are not watched, like the catalog does not crawl them.
+		 */
+		class QuizLibraryWatcher : public QObject
+		{
+			Q_OBJECT
+		public:
+			/**
+			 * @brief Constructor. Starts watching the data folder.
+			 *
+			 * @param[in] dataFolder The folder containing the quizzes.
+			 * @param[in] catalog The catalog to keep up to date.
+			 * @param[in] parent The parent object.
+			 */
+			explicit QuizLibraryWatcher(const std::string& dataFolder, const MusicQuiz::util::QuizCatalog::Ptr& catalog, QObject* parent = nullptr);
+
+			/**
+			 * @brief Destructor. Stops watching the data folder.
+			 */
+			virtual ~QuizLibraryWatcher();
+
+			/**
+			 * @brief Deleted the copy and assignment constructor.
+			 */
+			QuizLibraryWatcher(const QuizLibraryWatcher&) = delete;
+			QuizLibraryWatcher& operator=(const QuizLibraryWatcher&) = delete;
+
+			/**
+			 * @brief Applies the changes to a quiz file or folder immediately.
+			 *
+			 * @param[in] path The path of the quiz file or folder.
+			 */
+			void invalidate(const std::string& path);
+
+			/**
+			 * @brief Checks if a folder is watched. Media folders and hidden folders are skipped.
+			 *
+			 * @param[in] folderName The name of the folder.
+			 *
+			 * @return True if the folder should be watched.
+			 */
+			static bool isWatchedFolder(const std::string& folderName);
+
+		signals:
+			void quizAdded(const QString& quizPath);
+			void quizModified(const QString& quizPath);
+			void quizRemoved(const QString& quizPath);
+			void changesApplied();
+
+		private slots:
+			/**
+			 * @brief Reads the pending inotify events.
+			 */
+			void readEvents();
+
+			/**
+			 * @brief Handles a changed folder reported by the QFileSystemWatcher.
+			 *
+			 * @param[in] path The folder.
+			 */
+			void folderChanged(const QString& path);
+
+			/**
+			 * @brief Handles a changed file reported by the QFileSystemWatcher.
+			 *
+			 * @param[in] path The file.
+			 */
+			void fileChanged(const QString& path);
+
+			/**
+			 * @brief Applies the collected changes to the catalog and saves it.
+			 *        The quiz signals are emitted per quiz, changesApplied once after the catalog has been saved.
+			 */
+			void applyChanges();
+
+		protected:
+			/**
+			 * @brief Watches a folder and its sub folders.
+			 *
+			 * @param[in] folder The folder.
+			 */
+			void watchFolder(const std::string& folder);
+
+			/**
+			 * @brief Stops watching a folder and its sub folders.
+			 *
+			 * @param[in] folder The folder.
+			 */
+			void unwatchFolder(const std::string& folder);
+
+			/**
+			 * @brief Adds a changed path. The changes are applied once no new changes have arrived for a while.
+			 *
+			 * @param[in] path The changed path.
+			 */
+			void addPending(const std::string& path);
+
+			/** Variables */
+			const std::string _dataFolder;
+			const MusicQuiz::util::QuizCatalog::Ptr _catalog;
+
+			QTimer _timer;
+			std::set<std::string> _pending;
+
+			/** inotify */
+			int _inotifyFd = -1;
+			QSocketNotifier* _notifier = nullptr;
+			std::unordered_map<int, std::string> _watches;
+
+			/** QFileSystemWatcher */
+			QFileSystemWatcher* _watcher = nullptr;
+		};
+	}
+}
\ No newline at end of file
@@ -0,0 +1,140 @@
+#include "QuizLoadTask.hpp"
+
+#include <vector>
+#include <utility>
+
+#include "common/Log.hpp"
+
+
+namespace {
+	/**
+	 * @brief Worker threads of dropped tasks. A new task must not wait for the task it replaces, so the threads are joined
+	 *        here once they are done. The threads that are left are joined when the program exits, after they were cancelled.
+	 */
+	struct Reaper
+	{
+		std::mutex mutex;
+		std::vector< std::pair<std::shared_ptr<const void>, std::thread> > threads;
+
+		~Reaper()
+		{
+			std::lock_guard<std::mutex> lock(mutex);
+			for ( size_t i = 0; i < threads.size(); ++i ) {
+				threads[i].second.join();
+			}
+		}
+	};
+
+	Reaper& getReaper()
+	{
+		static Reaper reaper;
+		return reaper;
+	}
+}
+
+
+MusicQuiz::util::QuizLoadTask::Shared::Shared() :
+	state(State::RUNNING), cancelled(false), done(0), total(0)
+{
+}
+
+MusicQuiz::util::QuizLoadTask::QuizLoadTask(const Job& job) :
+	_shared(std::make_shared<Shared>())
+{
+	_thread = std::thread(&QuizLoadTask::run, _shared, job);
+}
+
+MusicQuiz::util::QuizLoadTask::~QuizLoadTask()
+{
+	cancel();
+	if ( _thread.joinable() ) {
+		reap(_shared, std::move(_thread));
+	}
+}
+
+void MusicQuiz::util::QuizLoadTask::cancel()
+{
+	_shared->cancelled = true;
+}
+
+void MusicQuiz::util::QuizLoadTask::wait()
+{
+	if ( _thread.joinable() ) {
+		_thread.join();
+	}
+}
+
+MusicQuiz::util::QuizLoadTask::State MusicQuiz::util::QuizLoadTask::getState() const
+{
+	return _shared->state;
+}
+
+void MusicQuiz::util::QuizLoadTask::getProgress(size_t& done, size_t& total) const
+{
+	done = _shared->done;
+	total = _shared->total;
+}
+
+MusicQuiz::util::QuizModel::CPtr MusicQuiz::util::QuizLoadTask::getModel() const
+{
+	std::lock_guard<std::mutex> lock(_shared->mutex);
+	return _shared->model;
+}
+
+std::string MusicQuiz::util::QuizLoadTask::getError() const
+{
+	std::lock_guard<std::mutex> lock(_shared->mutex);
+	return _shared->error;
+}
+
+void MusicQuiz::util::QuizLoadTask::run(const std::shared_ptr<Shared>& shared, const Job& job)
+{
+	const QuizModel::ProgressCallback progress = [&shared](const size_t done, const size_t total) {
+		shared->done = done;
+		shared->total = total;
+		return !shared->cancelled;
+	};
+
+	try {
+		const QuizModel::CPtr model = job(progress);
+
+		std::lock_guard<std::mutex> lock(shared->mutex);
+		if ( model == nullptr || shared->cancelled ) {
+			shared->state = State::CANCELLED;
+		} else {
+			shared->model = model;
+			shared->state = State::FINISHED;
+		}
+	} catch ( const std::exception& err ) {
+		LOG_ERROR("Failed to load quiz. " << err.what());
+
+		std::lock_guard<std::mutex> lock(shared->mutex);
+		shared->error = err.what();
+		shared->state = State::FAILED;
+	} catch ( ... ) {
+		LOG_ERROR("Failed to load quiz.");
+
+		std::lock_guard<std::mutex> lock(shared->mutex);
+		shared->error = "Unknown error.";
+		shared->state = State::FAILED;
+	}
+}
+
+void MusicQuiz::util::QuizLoadTask::reap(const std::shared_ptr<Shared>& shared, std::thread&& thread)
+{
+	Reaper& reaper = getReaper();
+	std::lock_guard<std::mutex> lock(reaper.mutex);
+
+	/** Join the workers that are done, they have returned or are about to */
+	for ( size_t i = 0; i < reaper.threads.size(); ) {
+		const std::shared_ptr<const Shared> done = std::static_pointer_cast<const Shared>(reaper.threads[i].first);
+		if ( done->state != State::RUNNING ) {
+			reaper.threads[i].second.join();
+			reaper.threads.erase(reaper.threads.begin() + i);
+		} else {
+			++i;
+		}
+	}
+
+	reaper.threads.emplace_back(shared, std::move(thread));
+}
\ No newline at end of file
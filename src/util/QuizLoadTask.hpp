@@ -0,0 +1,138 @@
+#pragma once
+
+#include <mutex>
+#include <atomic>
+#include <string>
+#include <thread>
+#include <memory>
+#include <functional>
+
+#include "util/QuizModel.hpp"
+
+
+namespace MusicQuiz {
+	namespace util {
+		/**
+		 * @brief Loads a quiz model on a worker thread.
+		 *
+		 * The task is started when it is created. The progress, state and result are polled from the GUI thread,
+		 * no callbacks are made on the worker thread. Cancelling is cooperative, the job stops at the next progress report.
+		 * The worker thread owns the state it writes, so a task can be dropped without waiting for the worker.
+		 */
+		class QuizLoadTask
+		{
+		public:
+			enum class State
+			{
+				RUNNING, FINISHED, FAILED, CANCELLED
+			};
+
+			/**
+			 * @brief The job run on the worker thread. It must report its progress to the callback and stop when it returns false.
+			 */
+			typedef std::function<MusicQuiz::util::QuizModel::CPtr(const MusicQuiz::util::QuizModel::ProgressCallback&)> Job;
+
+			/**
+			 * @brief Constructor. Starts the job on a worker thread.
+			 *
+			 * @param[in] job The job that loads the model.
+			 */
+			explicit QuizLoadTask(const Job& job);
+
+			/**
+			 * @brief Destructor. Cancels the job without waiting for it. A worker that is still running is joined by a
+			 *        background reaper, or when the program exits.
+			 */
+			virtual ~QuizLoadTask();
+
+			/**
+			 * @brief Shared Pointer
+			 */
+			typedef std::shared_ptr< QuizLoadTask > Ptr;
+			typedef std::shared_ptr< const QuizLoadTask > CPtr;
+
+			/**
+			 * @brief Deleted the copy and assignment constructor.
+			 */
+			QuizLoadTask(const QuizLoadTask&) = delete;
+			QuizLoadTask& operator=(const QuizLoadTask&) = delete;
+
+			/**
+			 * @brief Requests the job to stop.
+			 */
+			void cancel();
+
+			/**
+			 * @brief Blocks until the job is done.
+			 */
+			void wait();
+
+			/**
+			 * @brief Returns the state of the task.
+			 *
+			 * @return The state.
+			 */
+			State getState() const;
+
+			/**
+			 * @brief Returns the progress of the job.
+			 *
+			 * @param[out] done The number of media files checked and entries loaded.
+			 * @param[out] total The total number of media files and entries. Zero until the quiz file has been read.
+			 */
+			void getProgress(size_t& done, size_t& total) const;
+
+			/**
+			 * @brief Returns the loaded model.
+			 *
+			 * @return The model, or nullptr if the task is not finished.
+			 */
+			MusicQuiz::util::QuizModel::CPtr getModel() const;
+
+			/**
+			 * @brief Returns the reason the task failed.
+			 *
+			 * @return The error message.
+			 */
+			std::string getError() const;
+
+		protected:
+			/**
+			 * @brief The state shared by the task and its worker thread.
+			 */
+			struct Shared
+			{
+				std::atomic<State> state;
+				std::atomic<bool> cancelled;
+				std::atomic<size_t> done;
+				std::atomic<size_t> total;
+
+				mutable std::mutex mutex;
+				MusicQuiz::util::QuizModel::CPtr model = nullptr;
+				std::string error = "";
+
+				Shared();
+			};
+
+			/**
+			 * @brief Runs the job. Called on the worker thread.
+			 *
+			 * @param[in] shared The shared state.
+			 * @param[in] job The job.
+			 */
+			static void run(const std::shared_ptr<Shared>& shared, const Job& job);
+
+			/**
+			 * @brief Joins the worker thread of a dropped task once it is done.
+			 *
+			 * @param[in] shared The shared state of the task.
+			 * @param[in] thread The worker thread.
+			 */
+			static void reap(const std::shared_ptr<Shared>& shared, std::thread&& thread);
+
+			/** Variables */
+			const std::shared_ptr<Shared> _shared;
+			std::thread _thread;
+		};
+	}
+}
\ No newline at end of file
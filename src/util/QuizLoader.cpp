@@ -1,257 +1,481 @@
 #include "QuizLoader.hpp"
 
 #include <stdexcept>
+#include <mutex>
+#include <map>
+#include <random>
 #include <algorithm>
 
-#include <boost/property_tree/ptree.hpp>
-#include <boost/property_tree/xml_parser.hpp>
+#include <QCoreApplication>
 
 #include "common/Log.hpp"
 
+#include "util/QuizBinary.hpp"
+#include "util/QuizPackage.hpp"
+#include "util/QuizSaveTask.hpp"
+#include "util/MediaValidator.hpp"
+
 #include "gui_tools/widgets/QuizEntry.hpp"
 
 
+namespace {
+	/** Location of the quizzes and the catalog index */
+	const std::string DATA_FOLDER = "./data/";
+	const std::string CATALOG_INDEX_FILE = "./data/.quizcatalog";
+	const std::string PLAY_HISTORY_FILE = "./data/.playhistory";
+	const std::string MEDIA_STORE_FOLDER = "./data/.media";
+
+	std::mutex& getCatalogMutex()
+	{
+		static std::mutex mutex;
+		return mutex;
+	}
+
+	MusicQuiz::util::QuizCatalog::Ptr& getCatalogInstance()
+	{
+		static MusicQuiz::util::QuizCatalog::Ptr catalog = nullptr;
+		return catalog;
+	}
+
+	std::string getQuizPath(const MusicQuiz::util::QuizId id)
+	{
+		/** Get Quiz from the Catalog */
+		const std::string path = MusicQuiz::util::QuizLoader::getCatalog()->getEntry(id).path;
+		if ( !boost::filesystem::exists(path) ) {
+			throw std::runtime_error("Quiz file does not exists.");
+		}
+
+		return path;
+	}
+
+	/**
+	 * @brief Returns the media source of a media file. Media in a quiz package or in the media store is played from memory.
+	 *
+	 * @param[in] path The full media path.
+	 * @param[in] range The byte range of the media if the quiz is a package.
+	 *
+	 * @return The media source.
+	 */
+	media::MediaSource getMediaSource(const std::string& path, const MusicQuiz::util::QuizPackage::Range& range)
+	{
+		const QString name = QString::fromStdString(path);
+		if ( range.isValid() ) {
+			return media::MediaSource::fromRange(range, name);
+		}
+
+		if ( !path.empty() && MusicQuiz::util::QuizLoader::getMediaStore()->contains(path) ) {
+			return media::MediaSource::fromMappedFile(name);
+		}
+
+		return media::MediaSource::fromFile(name);
+	}
+
+	/**
+	 * @brief Finishes the saves that were interrupted after they were committed, and updates the catalog entries of those quizzes.
+	 *        Done when the catalog is refreshed, such that loading a quiz does not have to check for it.
+	 *
+	 * @param[in] catalog The catalog.
+	 */
+	void recoverInterruptedSaves(MusicQuiz::util::QuizCatalog& catalog)
+	{
+		const std::vector<std::string> quizzes = catalog.getQuizList();
+		for ( size_t i = 0; i < quizzes.size(); ++i ) {
+			if ( MusicQuiz::util::QuizPackage::isPackageFile(quizzes[i]) ) {
+				continue;
+			}
+
+			try {
+				if ( MusicQuiz::util::QuizSaveTask::recover(quizzes[i]) ) {
+					catalog.invalidate(quizzes[i]);
+				}
+			} catch ( const std::exception& err ) {
+				LOG_ERROR("Failed to finish the interrupted save of '" << quizzes[i] << "'. " << err.what());
+			}
+		}
+	}
+}
+
+
+const MusicQuiz::util::QuizCatalog::Ptr& MusicQuiz::util::QuizLoader::getCatalog()
+{
+	std::lock_guard<std::mutex> lock(getCatalogMutex());
+	QuizCatalog::Ptr& catalog = getCatalogInstance();
+
+	/** Load the index and bring it up to date once, afterwards the catalog is served from memory */
+	if ( catalog == nullptr ) {
+		catalog = std::make_shared<QuizCatalog>(DATA_FOLDER, CATALOG_INDEX_FILE);
+		catalog->load();
+		catalog->refresh();
+		recoverInterruptedSaves(*catalog);
+		catalog->save();
+	}
+
+	return catalog;
+}
+
+void MusicQuiz::util::QuizLoader::setCatalog(const QuizCatalog::Ptr& catalog)
+{
+	std::lock_guard<std::mutex> lock(getCatalogMutex());
+	getCatalogInstance() = catalog;
+}
+
+void MusicQuiz::util::QuizLoader::refreshCatalog()
+{
+	const QuizCatalog::Ptr& catalog = getCatalog();
+	catalog->refresh();
+	recoverInterruptedSaves(*catalog);
+	catalog->save();
+}
+
+MusicQuiz::util::QuizLibraryWatcher* MusicQuiz::util::QuizLoader::getLibraryWatcher()
+{
+	static QuizLibraryWatcher* watcher = new QuizLibraryWatcher(DATA_FOLDER, getCatalog(), QCoreApplication::instance());
+	return watcher;
+}
+
+void MusicQuiz::util::QuizLoader::invalidateQuiz(const std::string& path)
+{
+	getLibraryWatcher()->invalidate(path);
+}
+
 std::vector<std::string> MusicQuiz::util::QuizLoader::getListOfQuizzes()
 {
-	/** Check if data folder exists */
-	const boost::filesystem::path dataFolder = "./data/";
-	if ( !boost::filesystem::is_directory(dataFolder) ) {
-		throw std::runtime_error("Data folder does not exists.");
+	return getCatalog()->getQuizList();
+}
+
+const MusicQuiz::util::QuizSearchIndex::Ptr& MusicQuiz::util::QuizLoader::getSearchIndex()
+{
+	static const QuizSearchIndex::Ptr index = std::make_shared<QuizSearchIndex>();
+	return index;
+}
+
+MusicQuiz::util::QuizSearchIndexUpdater* MusicQuiz::util::QuizLoader::getSearchIndexUpdater()
+{
+	static QuizSearchIndexUpdater* updater = []() {
+		QuizSearchIndexUpdater* searchIndexUpdater = new QuizSearchIndexUpdater(getSearchIndex(), getEntryIndex(), getCatalog(), &readQuizDocument, QCoreApplication::instance());
+
+		/** Only the quizzes changed by a batch are read again */
+		QObject::connect(getLibraryWatcher(), SIGNAL(changesApplied()), searchIndexUpdater, SLOT(update()));
+		return searchIndexUpdater;
+	}();
+	return updater;
+}
+
+std::vector<MusicQuiz::util::QuizSearchIndex::Result> MusicQuiz::util::QuizLoader::searchQuizzes(const std::string& text, const size_t limit)
+{
+	/** The index is updated in the background, a search never reads quizzes */
+	return getSearchIndex()->search(text, limit);
+}
+
+const MusicQuiz::util::EntryIndex::Ptr& MusicQuiz::util::QuizLoader::getEntryIndex()
+{
+	static const EntryIndex::Ptr index = []() {
+		const EntryIndex::Ptr entryIndex = std::make_shared<EntryIndex>(PLAY_HISTORY_FILE);
+		entryIndex->loadHistory();
+		return entryIndex;
+	}();
+	return index;
+}
+
+std::vector<MusicQuiz::util::EntryIndex::Row> MusicQuiz::util::QuizLoader::queryEntries(const EntryIndex::Query& query)
+{
+	/** The index is updated in the background, a query never reads quizzes */
+	if ( getSearchIndexUpdater()->isUpdating() ) {
+		LOG_INFO("The entry index is being updated, only the quizzes indexed so far are queried.");
+	}
+	return getEntryIndex()->query(query);
+}
+
+MusicQuiz::util::QuizModel::CPtr MusicQuiz::util::QuizLoader::loadMixModel(const EntryIndex::Query& query, const size_t numberOfCategories, const size_t numberOfEntries, const unsigned int seed)
+{
+	/** Group the matching entries by category */
+	const std::vector<EntryIndex::Row> rows = queryEntries(query);
+	std::map< std::string, std::vector<size_t> > groups;
+	for ( size_t i = 0; i < rows.size(); ++i ) {
+		groups[rows[i].category].push_back(i);
 	}
 
-	/** Find Quizzes */
-	std::vector<std::string> quizList;
-	boost::filesystem::recursive_directory_iterator end;
+	std::vector< std::pair< std::string, std::vector<size_t> > > candidates;
+	for ( std::map< std::string, std::vector<size_t> >::const_iterator it = groups.begin(); it != groups.end(); ++it ) {
+		if ( it->second.size() >= numberOfEntries ) {
+			candidates.push_back(*it);
+		}
+	}
 
-	for ( boost::filesystem::recursive_directory_iterator file(dataFolder); file != end; ++file ) {
-		const std::string fileStr = boost::filesystem::path(*file).string();
+	if ( candidates.empty() || numberOfEntries == 0 ) {
+		throw std::runtime_error("Not enough entries match the query to create a quiz.");
+	}
 
-		/** Skip non quiz files */
-		if ( fileStr.find(".quiz.xml") == std::string::npos ) {
-			continue;
+	/** Pick Categories and Entries */
+	std::mt19937 rng(seed);
+	std::shuffle(candidates.begin(), candidates.end(), rng);
+	candidates.resize(std::min(candidates.size(), numberOfCategories));
+
+	QuizDocument::Ptr document = std::make_shared<QuizDocument>();
+	document->quizName = document->store("Mix Quiz");
+	document->quizAuthor = document->store("Quiz Library");
+	document->quizDescription = document->store("Entries picked from the quiz library.");
+
+	std::vector<std::uint64_t> keys;
+	document->categories.resize(candidates.size());
+	for ( size_t i = 0; i < candidates.size(); ++i ) {
+		std::vector<size_t>& entries = candidates[i].second;
+		std::shuffle(entries.begin(), entries.end(), rng);
+		entries.resize(numberOfEntries);
+		std::stable_sort(entries.begin(), entries.end(), [&rows](const size_t lhs, const size_t rhs) {
+			return rows[lhs].points < rows[rhs].points;
+		});
+
+		QuizDocument::Category& category = document->categories[i];
+		category.name = document->store(candidates[i].first);
+		for ( size_t j = 0; j < entries.size(); ++j ) {
+			const EntryIndex::Row& row = rows[entries[j]];
+			QuizDocument::Entry entry;
+			entry.name = document->store(row.name);
+			entry.answer = document->store(row.answer);
+			entry.type = row.type;
+			entry.points = row.points;
+			entry.startTime = row.startTime;
+			entry.answerStartTime = row.answerStartTime;
+			entry.videoSongStartTime = row.videoSongStartTime;
+			entry.songFile = document->store(row.songFile);
+			entry.videoFile = document->store(row.videoFile);
+			category.entries.push_back(entry);
+			keys.push_back(row.key);
 		}
+	}
 
-		/** Push back quiz */
-		quizList.push_back(fileStr);
+	/** Create Model, the entries keep the keys of the quizzes they come from */
+	const QuizModel::Ptr model = QuizModel::fromDocument(*document, boost::filesystem::current_path().string() + "/");
+	size_t keyIdx = 0;
+	for ( size_t i = 0; i < model->categories.size(); ++i ) {
+		for ( size_t j = 0; j < model->categories[i].entries.size(); ++j ) {
+			model->categories[i].entries[j].key = keys[keyIdx++];
+		}
 	}
 
-	return quizList;
+	return model;
+}
+
+void MusicQuiz::util::QuizLoader::markPlayed(const std::uint64_t key)
+{
+	const EntryIndex::Ptr& index = getEntryIndex();
+	index->markPlayed(key, std::time(nullptr));
+	index->saveHistory();
+}
+
+const MusicQuiz::util::MediaStore::Ptr& MusicQuiz::util::QuizLoader::getMediaStore()
+{
+	static const MediaStore::Ptr store = []() {
+		const MediaStore::Ptr mediaStore = std::make_shared<MediaStore>(MEDIA_STORE_FOLDER);
+		mediaStore->loadReferences();
+		return mediaStore;
+	}();
+	return store;
+}
+
+MusicQuiz::util::MediaStore::GarbageReport MusicQuiz::util::QuizLoader::collectMediaGarbage()
+{
+	const MediaStore::Ptr& store = getMediaStore();
+	const MediaStore::GarbageReport report = store->collectGarbage(*getCatalog(), &readQuizDocument);
+	store->saveReferences();
+
+	LOG_INFO("Removed " << report.files << " unused media files (" << report.bytes << " bytes) from the media store.");
+	return report;
 }
 
-MusicQuiz::util::QuizLoader::QuizPreview MusicQuiz::util::QuizLoader::getQuizPreview(size_t idx)
+MusicQuiz::util::QuizLoader::QuizPreview MusicQuiz::util::QuizLoader::getQuizPreview(const QuizId id)
 {
-	/** Get List of Quizzes */
-	const std::vector<std::string> quizList = getListOfQuizzes();
-	if ( quizList.empty() ) {
-		throw std::runtime_error("No quizzes found in the data folder.");
+	/** Use the cached preview if the file is unchanged */
+	const QuizCatalog::Ptr& catalog = getCatalog();
+	QuizCatalog::Entry entry = catalog->getEntry(id);
+	if ( entry.previewValid ) {
+		return entry.preview;
 	}
 
-	/** Sanity Check */
-	if ( idx >= quizList.size() ) {
-		throw std::runtime_error("Index out of range.");
+	/** Load Preview */
+	if ( entry.document != nullptr ) {
+		entry.preview = entry.document->toPreview();
+	} else {
+		entry.preview = readQuizPreview(entry.path);
 	}
+	catalog->setPreview(entry);
+
+	return entry.preview;
+}
 
-	if ( !boost::filesystem::exists(quizList[idx]) ) {
-		throw std::runtime_error("Quiz file does not exists.");
+MusicQuiz::util::QuizLoader::QuizPreview MusicQuiz::util::QuizLoader::readQuizPreview(const std::string& path)
+{
+	if ( QuizPackage::isPackageFile(path) ) {
+		return QuizPackage::open(path, true)->readPreview();
 	}
+	return QuizDocument::readPreview(path);
+}
 
-	/** Load preview */
-	QuizLoader::QuizPreview quizPreview;
-	boost::property_tree::ptree tree;
-	boost::property_tree::read_xml(quizList[idx], tree, boost::property_tree::xml_parser::trim_whitespace);
-	boost::property_tree::ptree sub_tree = tree.get_child("MusicQuiz");
-
-	/** Name */
-	quizPreview.quizName = sub_tree.get<std::string>("QuizName");
-
-	/** Author */
-	quizPreview.quizAuthor = sub_tree.get<std::string>("QuizAuthor");
-
-	/** Description */
-	quizPreview.quizDescription = sub_tree.get<std::string>("QuizDescription");
-
-	/** Guess the Category */
-	quizPreview.guessTheCategory = sub_tree.get("QuizGuessTheCategory.<xmlattr>.enabled", false);
-
-	/** Categories & Row Categories */
-	boost::property_tree::ptree::const_iterator ctrl = sub_tree.begin();
-	for ( ; ctrl != sub_tree.end(); ++ctrl ) {
-		if ( ctrl->first == "QuizCategories" ) { // Load Categories
-			boost::property_tree::ptree categoriesTree = ctrl->second;
-			boost::property_tree::ptree::const_iterator sub_ctrl = categoriesTree.begin();
-			for ( ; sub_ctrl != categoriesTree.end(); ++sub_ctrl ) {
-				if ( sub_ctrl->first == "Category" ) {
-					quizPreview.categories.push_back(sub_ctrl->second.get<std::string>("<xmlattr>.name"));
-
-					if ( !quizPreview.includeSongs || !quizPreview.includeVideos ) { // Check if the quiz contains songs / videos.
-						boost::property_tree::ptree mediaTree = sub_ctrl->second;
-						boost::property_tree::ptree::const_iterator it = mediaTree.begin();
-						for ( ; it != mediaTree.end(); ++it ) {
-							if ( it->first == "QuizEntry" ) {
-								if ( it->second.get<std::string>("<xmlattr>.type") == "song" && !quizPreview.includeSongs ) {
-									quizPreview.includeSongs = true;
-								} else if ( it->second.get<std::string>("<xmlattr>.type") == "video" && !quizPreview.includeVideos ) {
-									quizPreview.includeVideos = true;
-								}
-							}
-						}
-					}
-				}
-			}
-		} else if ( ctrl->first == "QuizRowCategories" ) { // Load Row Categories
-			boost::property_tree::ptree rowCategoriesTree = ctrl->second;
-			boost::property_tree::ptree::const_iterator sub_ctrl = rowCategoriesTree.begin();
-			for ( ; sub_ctrl != rowCategoriesTree.end(); ++sub_ctrl ) {
-				if ( sub_ctrl->first == "RowCategory" ) {
-					quizPreview.rowCategories.push_back(sub_ctrl->second.data());
-				}
-			}
+MusicQuiz::util::QuizDocument::CPtr MusicQuiz::util::QuizLoader::loadQuizDocument(const QuizId id)
+{
+	/** Get Quiz File */
+	const std::string quizFile = getQuizPath(id);
+
+	/** Use the cached document if the file is unchanged */
+	const QuizCatalog::Ptr& catalog = getCatalog();
+	const QuizDocument::CPtr cached = catalog->getEntry(id).document;
+	if ( cached != nullptr ) {
+		boost::system::error_code err;
+		const std::time_t lastWriteTime = boost::filesystem::last_write_time(quizFile, err);
+		const std::uintmax_t fileSize = boost::filesystem::file_size(quizFile, err);
+		if ( !err && cached->lastWriteTime == lastWriteTime && cached->fileSize == fileSize ) {
+			return cached;
 		}
 	}
 
-	return quizPreview;
+	/** Read Quiz */
+	const QuizDocument::CPtr document = readQuizDocument(quizFile);
+	catalog->setDocument(document);
+
+	return document;
 }
 
-std::vector<MusicQuiz::QuizCategory*> MusicQuiz::util::QuizLoader::loadQuizCategories(const size_t idx, const media::AudioPlayer::Ptr& audioPlayer,
-	const media::VideoPlayer::Ptr& videoPlayer, std::string& err)
+MusicQuiz::util::QuizDocument::CPtr MusicQuiz::util::QuizLoader::readQuizDocument(const std::string& path)
 {
-	/** Get List of Quizzes */
-	const std::vector<std::string> quizList = getListOfQuizzes();
-	if ( quizList.empty() ) {
-		throw std::runtime_error("No quizzes found in the data folder.");
+	/** Packages are mapped again, as the file may have been replaced since it was last opened */
+	if ( QuizPackage::isPackageFile(path) ) {
+		LOG_INFO("Opening Quiz Package '" << path << "'.");
+		return QuizPackage::open(path, true)->readDocument();
+	}
+
+	/** Map the compiled quiz if it belongs to the current quiz file */
+	QuizDocument::CPtr document = nullptr;
+	if ( QuizBinary::isUpToDate(path) ) {
+		try {
+			document = QuizBinary::read(QuizBinary::getBinaryPath(path), path);
+
+			boost::system::error_code err;
+			const std::time_t lastWriteTime = boost::filesystem::last_write_time(path, err);
+			const std::uintmax_t fileSize = boost::filesystem::file_size(path, err);
+			if ( err || document->lastWriteTime != lastWriteTime || document->fileSize != fileSize ) {
+				document = nullptr;
+			}
+		} catch ( const std::exception& err ) {
+			LOG_WARN("Ignoring compiled quiz for '" << path << "'. " << err.what());
+			document = nullptr;
+		}
 	}
 
-	/** Sanity Check */
-	if ( idx >= quizList.size() ) {
-		throw std::runtime_error("No quiz index requested does not exists.");
+	/** Parse Quiz */
+	if ( document == nullptr ) {
+		LOG_INFO("Parsing Quiz '" << path << "'.");
+		document = QuizDocument::fromFile(path);
 	}
 
-	if ( !boost::filesystem::exists(quizList[idx]) ) {
-		throw std::runtime_error("Quiz file does not exists.");
+	return document;
+}
+
+MusicQuiz::util::QuizModel::CPtr MusicQuiz::util::QuizLoader::loadQuizModel(const QuizId id, const QuizModel::ProgressCallback& progress)
+{
+	/** Load Quiz */
+	const QuizDocument::CPtr document = loadQuizDocument(id);
+	LOG_INFO("Loading Quiz '" << document->path << "'.");
+
+	/** Create Model */
+	const QuizModel::CPtr model = QuizModel::fromDocument(*document, boost::filesystem::current_path().string() + "/", progress);
+	if ( model == nullptr ) {
+		LOG_INFO("Loading of quiz '" << document->path << "' was cancelled.");
+		return nullptr;
 	}
 
+	const MediaValidator::Report& report = model->mediaReport;
+	LOG_INFO("Checked " << report.files.size() << " media files in " << report.elapsed.count() << " us, " << report.issueCount << " missing or unreadable.");
 
-	/** Load Categories */
-	LOG_INFO("Loading Quiz #" << idx << " '" << quizList[idx] << "'.");
+	return model;
+}
 
-	boost::property_tree::ptree tree;
-	boost::property_tree::read_xml(quizList[idx], tree, boost::property_tree::xml_parser::trim_whitespace);
-	boost::property_tree::ptree sub_tree = tree.get_child("MusicQuiz");
+MusicQuiz::util::QuizLoadTask::Ptr MusicQuiz::util::QuizLoader::loadAsync(const QuizId id)
+{
+	return std::make_shared<QuizLoadTask>([id](const QuizModel::ProgressCallback& progress) {
+		return loadQuizModel(id, progress);
+	});
+}
 
+std::vector<MusicQuiz::QuizCategory*> MusicQuiz::util::QuizLoader::loadQuizCategories(const QuizModel::CPtr& model, const media::AudioPlayer::Ptr& audioPlayer,
+	const media::VideoPlayer::Ptr& videoPlayer)
+{
+	/** Load Categories */
 	std::vector<MusicQuiz::QuizCategory*> categories;
-	boost::property_tree::ptree::const_iterator ctrl = sub_tree.begin();
-	for ( ; ctrl != sub_tree.end(); ++ctrl ) {
-		if ( ctrl->first == "QuizCategories" ) { // Load Categories
-			boost::property_tree::ptree categoriesTree = ctrl->second;
-			boost::property_tree::ptree::const_iterator sub_ctrl = categoriesTree.begin();
-			try {
-				for ( ; sub_ctrl != categoriesTree.end(); ++sub_ctrl ) {
-					if ( sub_ctrl->first == "Category" ) {
-
-						/** Category Name */
-						const QString categoryName = QString::fromStdString(sub_ctrl->second.get<std::string>("<xmlattr>.name"));
-
-						/** Category Entries */
-						std::vector<MusicQuiz::QuizEntry*> categorieEntries;
-						boost::property_tree::ptree entryTree = sub_ctrl->second;
-						boost::property_tree::ptree::const_iterator it = entryTree.begin();
-						for ( ; it != entryTree.end(); ++it ) {
-							if ( it->first == "QuizEntry" ) {
-								const boost::filesystem::path full_path(boost::filesystem::current_path());
-
-								/** Settings */
-								const QString answer = QString::fromStdString(it->second.get<std::string>("Answer"));
-								const size_t points = it->second.get<size_t>("Points");
-								const size_t answerStartTime = it->second.get<size_t>("AnswerStartTime");
-
-								/** Media Type */
-								const std::string type = it->second.get<std::string>("<xmlattr>.type");
-								if ( type == "song" ) { // Song
-									QString songFile = QString::fromStdString(full_path.string() + "/" + it->second.get<std::string>("Media.SongFile"));
-									const size_t audioStartTime = it->second.get<size_t>("StartTime");
-									std::replace(songFile.begin(), songFile.end(), '\\', '/');
-
-									/** Check if file exsists */
-									if ( !boost::filesystem::exists(songFile.toStdString()) ) {
-										err += "Missing song file '" + songFile.toStdString() + "'\n";
-									}
-
-									/** Push Back Song Entry */
-									categorieEntries.push_back(new MusicQuiz::QuizEntry(songFile, answer, points, audioStartTime, answerStartTime, audioPlayer));
-								} else if ( type == "video" ) { // Video
-									QString songFile = QString::fromStdString(full_path.string() + "/" + it->second.get<std::string>("Media.SongFile"));
-									QString videoFile = QString::fromStdString(full_path.string() + "/" + it->second.get<std::string>("Media.VideoFile"));
-									std::replace(songFile.begin(), songFile.end(), '\\', '/');
-									std::replace(videoFile.begin(), videoFile.end(), '\\', '/');
-									const size_t videoStartTime = it->second.get<size_t>("StartTime");
-									const size_t videoSongStartTime = it->second.get<size_t>("VideoSongStartTime");
-
-									/** Check if files exsists */
-									if ( !boost::filesystem::exists(songFile.toStdString()) ) {
-										err += "Missing song file '" + songFile.toStdString() + "'\n";
-									}
-
-									if ( !boost::filesystem::exists(videoFile.toStdString()) ) {
-										err += "Missing video file '" + videoFile.toStdString() + "'\n";
-									}
-
-									/** Push Back Video Entry */
-									categorieEntries.push_back(new MusicQuiz::QuizEntry(songFile, videoFile, answer, points, videoSongStartTime, videoStartTime, answerStartTime, audioPlayer, videoPlayer));
-								}
-							}
-						}
-
-						categories.push_back(new MusicQuiz::QuizCategory(categoryName, categorieEntries));
-					}
+	try {
+		for ( size_t i = 0; i < model->categories.size(); ++i ) {
+			const QuizModel::CategoryModel& category = model->categories[i];
+
+			/** Category Name */
+			const QString categoryName = QString::fromStdString(category.name);
+
+			/** Category Entries */
+			std::vector<MusicQuiz::QuizEntry*> categorieEntries;
+			for ( size_t j = 0; j < category.entries.size(); ++j ) {
+				const QuizModel::EntryModel& entry = category.entries[j];
+
+				/** Settings */
+				const QString answer = QString::fromStdString(entry.answer);
+				const QString songFile = QString::fromStdString(entry.songFile);
+
+				/** Media Type */
+				MusicQuiz::QuizEntry* quizEntry = nullptr;
+				if ( entry.type == QuizModel::EntryType::Song ) { // Song
+					quizEntry = new MusicQuiz::QuizEntry(songFile, answer, entry.points, entry.startTime, entry.answerStartTime, audioPlayer);
+				} else if ( entry.type == QuizModel::EntryType::Video ) { // Video
+					const QString videoFile = QString::fromStdString(entry.videoFile);
+					quizEntry = new MusicQuiz::QuizEntry(songFile, videoFile, answer, entry.points, entry.videoSongStartTime, entry.startTime, entry.answerStartTime, audioPlayer, videoPlayer);
+				} else {
+					LOG_WARN("Skipping entry '" << entry.name << "' with an unknown media type.");
+					continue;
 				}
-			} catch ( const std::exception& error ) {
-				LOG_ERROR("Failed to load category. " << error.what());
-			} catch ( ... ) {
-				LOG_ERROR("Failed to load category.");
+
+				/** Media in a package or the media store is played from memory */
+				quizEntry->setMediaSources(getMediaSource(entry.songFile, entry.songRange), getMediaSource(entry.videoFile, entry.videoRange));
+
+				/** Push Back Entry */
+				categorieEntries.push_back(quizEntry);
 			}
 
+			categories.push_back(new MusicQuiz::QuizCategory(categoryName, categorieEntries));
 		}
+	} catch ( const std::exception& error ) {
+		LOG_ERROR("Failed to load category. " << error.what());
+	} catch ( ... ) {
+		LOG_ERROR("Failed to load category.");
 	}
 
 	return categories;
 }
 
-std::vector<QString> MusicQuiz::util::QuizLoader::loadQuizRowCategories(const size_t idx)
+std::vector<QString> MusicQuiz::util::QuizLoader::loadQuizRowCategories(const QuizModel::CPtr& model)
 {
-	/** Get List of Quizzes */
-	const std::vector<std::string> quizList = getListOfQuizzes();
-	if ( quizList.empty() ) {
-		throw std::runtime_error("No quizzes found in the data folder.");
-	}
-
-	/** Sanity Check */
-	if ( idx >= quizList.size() ) {
-		throw std::runtime_error("No quiz index requested does not exists.");
+	/** Load Row Categories */
+	std::vector<QString> rowCategories;
+	for ( size_t i = 0; i < model->rowCategories.size(); ++i ) {
+		rowCategories.push_back(QString::fromStdString(model->rowCategories[i]));
 	}
 
-	if ( !boost::filesystem::exists(quizList[idx]) ) {
-		throw std::runtime_error("Quiz file does not exists.");
-	}
+	return rowCategories;
+}
 
+std::vector<QString> MusicQuiz::util::QuizLoader::loadQuizRowCategories(const QuizId id)
+{
+	return loadQuizRowCategories(loadQuizDocument(id));
+}
 
+std::vector<QString> MusicQuiz::util::QuizLoader::loadQuizRowCategories(const QuizDocument::CPtr& document)
+{
 	/** Load Row Categories */
-	boost::property_tree::ptree tree;
-	boost::property_tree::read_xml(quizList[idx], tree, boost::property_tree::xml_parser::trim_whitespace);
-	boost::property_tree::ptree sub_tree = tree.get_child("MusicQuiz");
-
 	std::vector<QString> rowCategories;
-	boost::property_tree::ptree::const_iterator ctrl = sub_tree.begin();
-	for ( ; ctrl != sub_tree.end(); ++ctrl ) {
-		if ( ctrl->first == "QuizRowCategories" ) { // Load Categories
-			boost::property_tree::ptree rowCategoriesTree = ctrl->second;
-			boost::property_tree::ptree::const_iterator sub_ctrl = rowCategoriesTree.begin();
-			for ( ; sub_ctrl != rowCategoriesTree.end(); ++sub_ctrl ) {
-				if ( sub_ctrl->first == "RowCategory" ) {
-					rowCategories.push_back(QString::fromStdString(sub_ctrl->second.data()));
-				}
-			}
-		}
+	for ( size_t i = 0; i < document->rowCategories.size(); ++i ) {
+		rowCategories.push_back(toQString(document->rowCategories[i]));
 	}
 
 	return rowCategories;
+}
+
+QString MusicQuiz::util::QuizLoader::toQString(const std::string_view str)
+{
+	return QString::fromUtf8(str.data(), static_cast<int>(str.size()));
 }
\ No newline at end of file
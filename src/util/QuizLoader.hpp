@@ -3,12 +3,24 @@
 #include <string>
 #include <vector>
 #include <memory>
-#include <iostream>
+#include <cstdint>
+#include <string_view>
 
 #include <QString>
 
 #include <boost/filesystem.hpp>
 
+#include "util/QuizId.hpp"
+#include "util/QuizPreview.hpp"
+#include "util/QuizModel.hpp"
+#include "util/QuizLoadTask.hpp"
+#include "util/QuizCatalog.hpp"
+#include "util/EntryIndex.hpp"
+#include "util/MediaStore.hpp"
+#include "util/QuizSearchIndex.hpp"
+#include "util/QuizDocument.hpp"
+#include "util/QuizLibraryWatcher.hpp"
+#include "util/QuizSearchIndexUpdater.hpp"
 #include "media/AudioPlayer.hpp"
 #include "media/VideoPlayer.hpp"
 #include "gui_tools/widgets/QuizCategory.hpp"
@@ -19,42 +31,7 @@ namespace MusicQuiz {
 		class QuizLoader
 		{
 		public:
-			struct QuizPreview
-			{
-				std::string quizName = "";
-				std::string quizAuthor = "";
-				bool includeSongs = false;
-				bool includeVideos = false;
-				bool guessTheCategory = false;
-				std::string quizDescription = "";
-				std::vector<std::string> categories;
-				std::vector<std::string> rowCategories;
-
-				friend std::ostream& operator<<(std::ostream& out, const QuizPreview& quizPreview)
-				{
-					out << "\n\nQuiz Name: " << quizPreview.quizName << "\n";
-					out << "Quiz Author: " << quizPreview.quizAuthor << "\n";
-					out << "Quiz Description: " << quizPreview.quizDescription << "\n";
-					if ( !quizPreview.categories.empty() ) {
-						out << "Quiz Categories:\n";
-						for ( size_t i = 0; i < quizPreview.categories.size(); ++i ) {
-							out << "\t" << quizPreview.categories[i] << "\n";
-						}
-					}
-
-					if ( !quizPreview.rowCategories.empty() ) {
-						out << "Quiz Row Categories:\n";
-						for ( size_t i = 0; i < quizPreview.rowCategories.size(); ++i ) {
-							out << "\t" << quizPreview.rowCategories[i] << "\n";
-						}
-					}
-
-					out << "Quiz Include Songs: " << (quizPreview.includeSongs ? "Yes" : "No") << "\n";
-					out << "Quiz Include Videos: " << (quizPreview.includeVideos ? "Yes" : "No") << "\n";
-					out << "Quiz Quess the Category: " << (quizPreview.guessTheCategory ? "Yes" : "No") << "\n\n";
-					return out;
-				}
-			};
+			typedef MusicQuiz::util::QuizPreview QuizPreview;
 
 			/**
 			 * @brief Deleted constructor.
@@ -72,6 +49,42 @@ namespace MusicQuiz {
 			QuizLoader(const QuizLoader&) = delete;
 			QuizLoader& operator=(const QuizLoader&) = delete;
 
+			/**
+			* @brief Returns the quiz catalog. The catalog is loaded from its index and refreshed on first use.
+			*
+			* @return The quiz catalog.
+			*/
+			static const MusicQuiz::util::QuizCatalog::Ptr& getCatalog();
+
+			/**
+			* @brief Replaces the quiz catalog, e.g. to load quizzes from another folder in tools and benchmarks.
+			*        Must not be called while quizzes are being loaded.
+			*
+			* @param[in] catalog The catalog to use. If nullptr the default catalog is loaded on next use.
+			*/
+			static void setCatalog(const MusicQuiz::util::QuizCatalog::Ptr& catalog);
+
+			/**
+			* @brief Returns the watcher that keeps the quiz catalog up to date while the application runs.
+			*        The watcher is created on first use and owned by the application object.
+			*
+			* @return The library watcher.
+			*/
+			static MusicQuiz::util::QuizLibraryWatcher* getLibraryWatcher();
+
+			/**
+			* @brief Rescans the data folder and updates the quiz catalog.
+			*/
+			static void refreshCatalog();
+
+			/**
+			* @brief Updates the catalog entry of a single quiz file, e.g. after it has been saved.
+			*        Listeners of the library watcher are notified of the change.
+			*
+			* @param[in] path The path of the quiz file.
+			*/
+			static void invalidateQuiz(const std::string& path);
+
 			/**
 			* @brief Returns a list of quizzez stored in the data folder.
 			*
@@ -79,34 +92,188 @@ namespace MusicQuiz {
 			*/
 			static std::vector<std::string> getListOfQuizzes();
 
+			/**
+			* @brief Returns the search index of the quizzes in the catalog. The index is kept up to date by the search index updater.
+			*
+			* @return The search index.
+			*/
+			static const MusicQuiz::util::QuizSearchIndex::Ptr& getSearchIndex();
+
+			/**
+			* @brief Returns the updater that builds the search index and the entry index on a worker thread and updates them after each batch of library changes.
+			*        The updater is created on first use, which starts building the index, and is owned by the application object.
+			*
+			* @return The index updater.
+			*/
+			static MusicQuiz::util::QuizSearchIndexUpdater* getSearchIndexUpdater();
+
+			/**
+			* @brief Searches the name, author, description, categories and answers of the quizzes in the catalog.
+			*        Only searches the index, quizzes that have not been indexed yet are not found.
+			*
+			* @param[in] text The search text.
+			* @param[in] limit The maximum number of results.
+			*
+			* @return The matching quizzes, best match first.
+			*/
+			static std::vector<MusicQuiz::util::QuizSearchIndex::Result> searchQuizzes(const std::string& text, size_t limit = SIZE_MAX);
+
+			/**
+			* @brief Returns the index of the entries of all quizzes in the catalog. The index is created on first use
+			*        and updated by the search index updater.
+			*
+			* @return The entry index.
+			*/
+			static const MusicQuiz::util::EntryIndex::Ptr& getEntryIndex();
+
+			/**
+			* @brief Returns the entries of all quizzes that match a query.
+			*        Only queries the index, quizzes that have not been indexed yet are not found.
+			*
+			* @param[in] query The query.
+			*
+			* @return The matching entries.
+			*/
+			static std::vector<MusicQuiz::util::EntryIndex::Row> queryEntries(const MusicQuiz::util::EntryIndex::Query& query);
+
+			/**
+			* @brief Assembles a quiz from the entries that match a query. Entries are grouped by their category name,
+			*        and categories with enough entries are picked at random.
+			*
+			* @param[in] query The query selecting the entries.
+			* @param[in] numberOfCategories The number of categories on the board.
+			* @param[in] numberOfEntries The number of entries per category.
+			* @param[in] seed The seed of the random selection.
+			*
+			* @return The quiz model.
+			*/
+			static MusicQuiz::util::QuizModel::CPtr loadMixModel(const MusicQuiz::util::EntryIndex::Query& query, size_t numberOfCategories, size_t numberOfEntries, unsigned int seed);
+
+			/**
+			* @brief Records that an entry was played.
+			*
+			* @param[in] key The key of the entry.
+			*/
+			static void markPlayed(std::uint64_t key);
+
+			/**
+			* @brief Returns the media store shared between quizzes. The references are loaded on first use.
+			*
+			* @return The media store.
+			*/
+			static const MusicQuiz::util::MediaStore::Ptr& getMediaStore();
+
+			/**
+			* @brief Removes the files in the media store that no quiz in the catalog refers to.
+			*
+			* @return The number of files and bytes removed.
+			*/
+			static MusicQuiz::util::MediaStore::GarbageReport collectMediaGarbage();
+
 			/**
 			* @brief Returns a quiz preview.
 			*
-			* @param[in] idx The index of the quiz to preview.
+			* @param[in] id The id of the quiz to preview.
 			*
 			* @return The quiz preview.
 			*/
-			static QuizPreview getQuizPreview(size_t idx);
+			static QuizPreview getQuizPreview(MusicQuiz::util::QuizId id);
+
+			/**
+			* @brief Returns the parsed quiz. The document is cached in the catalog and only parsed again when the file changes.
+			*
+			* @param[in] id The id of the quiz to load.
+			*
+			* @return The quiz document.
+			*/
+			static MusicQuiz::util::QuizDocument::CPtr loadQuizDocument(MusicQuiz::util::QuizId id);
+
+			/**
+			* @brief Returns the plain data model of a quiz with the media files checked. Does not create any widgets,
+			*        so it can be called from a worker thread.
+			*
+			* @param[in] id The id of the quiz to load.
+			* @param[in] progress Called with the number of entries loaded. Returning false cancels the load.
+			*
+			* @return The quiz model, or nullptr if the load was cancelled.
+			*/
+			static MusicQuiz::util::QuizModel::CPtr loadQuizModel(MusicQuiz::util::QuizId id, const MusicQuiz::util::QuizModel::ProgressCallback& progress = nullptr);
 
 			/**
-			* @brief Returns a list of the categories.
+			* @brief Starts loading the model of a quiz on a worker thread.
+			*
+			* @param[in] id The id of the quiz to load.
 			*
-			* @param[in] idx The index of the quiz to load the categories from.
-			* @param[out] err The error message.
+			* @return The load task, which reports the progress and holds the model when done.
+			*/
+			static MusicQuiz::util::QuizLoadTask::Ptr loadAsync(MusicQuiz::util::QuizId id);
+
+			/**
+			* @brief Creates the category widgets of a quiz. Must be called from the GUI thread.
+			*
+			* @param[in] model The quiz model to create the categories from.
+			* @param[in] audioPlayer The audio player.
+			* @param[in] videoPlayer The video player.
 			*
 			* @return The quiz categories.
 			*/
-			static std::vector<MusicQuiz::QuizCategory*> loadQuizCategories(size_t idx, const std::shared_ptr< media::AudioPlayer >& audioPlayer,
-				const std::shared_ptr< media::VideoPlayer >& videoPlayer, std::string& err);
+			static std::vector<MusicQuiz::QuizCategory*> loadQuizCategories(const MusicQuiz::util::QuizModel::CPtr& model, const std::shared_ptr< media::AudioPlayer >& audioPlayer,
+				const std::shared_ptr< media::VideoPlayer >& videoPlayer);
 
 			/**
 			* @brief Returns a list of the row categories.
 			*
-			* @param[in] idx The index of the quiz to load the categories from.
+			* @param[in] id The id of the quiz to load the categories from.
 			*
 			* @return The quiz row categories.
 			*/
-			static std::vector<QString> loadQuizRowCategories(size_t idx);
+			static std::vector<QString> loadQuizRowCategories(MusicQuiz::util::QuizId id);
+
+			/**
+			* @brief Returns a list of the row categories.
+			*
+			* @param[in] model The quiz model to load the row categories from.
+			*
+			* @return The quiz row categories.
+			*/
+			static std::vector<QString> loadQuizRowCategories(const MusicQuiz::util::QuizModel::CPtr& model);
+
+			/**
+			* @brief Returns a list of the row categories.
+			*
+			* @param[in] document The quiz document to load the row categories from.
+			*
+			* @return The quiz row categories.
+			*/
+			static std::vector<QString> loadQuizRowCategories(const MusicQuiz::util::QuizDocument::CPtr& document);
+
+			/**
+			* @brief Reads a quiz file. The compiled quiz is used if it belongs to the current quiz file.
+			*        Quiz packages are mapped and their media paths point into the package.
+			*
+			* @param[in] path The path of the quiz file.
+			*
+			* @return The quiz document.
+			*/
+			static MusicQuiz::util::QuizDocument::CPtr readQuizDocument(const std::string& path);
+
+			/**
+			* @brief Reads the preview of a quiz file.
+			*
+			* @param[in] path The path of the quiz file.
+			*
+			* @return The quiz preview.
+			*/
+			static QuizPreview readQuizPreview(const std::string& path);
+
+			/**
+			* @brief Converts a string from a quiz document.
+			*
+			* @param[in] str The UTF-8 string.
+			*
+			* @return The string.
+			*/
+			static QString toQString(std::string_view str);
 
 
 		protected:
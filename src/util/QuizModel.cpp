@@ -0,0 +1,145 @@
+#include "QuizModel.hpp"
+
+#include "util/QuizCatalog.hpp"
+#include "util/EntryIndex.hpp"
+
+
+namespace {
+	/**
+	 * @brief Looks up a media file in the package its virtual path points into.
+	 *
+	 * @param[in] path The media path.
+	 *
+	 * @return The byte range of the file, invalid if the path is not in a package or the file is missing.
+	 */
+	MusicQuiz::util::QuizPackage::Range getPackageRange(const std::string& path)
+	{
+		std::string packagePath, member;
+		if ( !MusicQuiz::util::QuizPackage::splitPath(path, packagePath, member) ) {
+			return MusicQuiz::util::QuizPackage::Range();
+		}
+
+		/** The package is already open, the media files were checked against it */
+		try {
+			return MusicQuiz::util::QuizPackage::getRange(MusicQuiz::util::QuizPackage::open(packagePath), member);
+		} catch ( const std::exception& ) {
+			return MusicQuiz::util::QuizPackage::Range();
+		}
+	}
+
+	/**
+	 * @brief Takes the next resolved media file if it belongs to an entry.
+	 *
+	 * @param[in] files The resolved media files in document order.
+	 * @param[in,out] fileIdx The index of the next file, advanced if the file is taken.
+	 * @param[in] category The category index.
+	 * @param[in] entry The entry index.
+	 * @param[in] type The type of the file.
+	 *
+	 * @return The path of the file, empty if the entry has no such file.
+	 */
+	std::string takeMediaFile(const std::vector<MusicQuiz::util::MediaValidator::MediaFile>& files, size_t& fileIdx, const size_t category, const size_t entry,
+		const MusicQuiz::util::MediaValidator::FileType type)
+	{
+		if ( fileIdx >= files.size() || files[fileIdx].category != category || files[fileIdx].entry != entry || files[fileIdx].type != type ) {
+			return "";
+		}
+		return files[fileIdx++].path;
+	}
+}
+
+
+MusicQuiz::util::QuizModel::Ptr MusicQuiz::util::QuizModel::fromDocument(const MusicQuiz::util::QuizDocument& document, const std::string& rootFolder, const ProgressCallback& progress)
+{
+	/** The media files are counted once they are resolved, checking them is most of the work */
+	const size_t numberOfEntries = document.getNumberOfEntries();
+	if ( progress && !progress(0, numberOfEntries) ) {
+		return nullptr;
+	}
+
+	Ptr model = std::make_shared<QuizModel>();
+
+	/** Source File */
+	model->id = QuizCatalog::getQuizId(document.path);
+	model->path = document.path;
+
+	/** Quiz */
+	model->quizName = std::string(document.quizName);
+	model->quizAuthor = std::string(document.quizAuthor);
+	model->quizDescription = std::string(document.quizDescription);
+	model->guessTheCategory = document.guessTheCategory;
+
+	/** Media Files */
+	MediaValidator::ProgressCallback checkProgress = nullptr;
+	if ( progress ) {
+		checkProgress = [&progress, numberOfEntries](const size_t filesDone, const size_t filesTotal) {
+			return progress(filesDone, filesTotal + numberOfEntries);
+		};
+	}
+	model->mediaReport = MediaValidator::validate(document, rootFolder, checkProgress);
+	if ( model->mediaReport.cancelled ) {
+		return nullptr;
+	}
+	const std::vector<MediaValidator::MediaFile>& files = model->mediaReport.files;
+	size_t done = files.size();
+	const size_t total = files.size() + numberOfEntries;
+
+	/** Categories */
+	size_t fileIdx = 0;
+	model->categories.resize(document.categories.size());
+	for ( size_t i = 0; i < document.categories.size(); ++i ) {
+		const QuizDocument::Category& category = document.categories[i];
+		CategoryModel& categoryModel = model->categories[i];
+		categoryModel.name = std::string(category.name);
+
+		/** Entries */
+		categoryModel.entries.resize(category.entries.size());
+		for ( size_t j = 0; j < category.entries.size(); ++j ) {
+			const QuizDocument::Entry& entry = category.entries[j];
+			EntryModel& entryModel = categoryModel.entries[j];
+			entryModel.name = std::string(entry.name);
+			entryModel.answer = std::string(entry.answer);
+			entryModel.type = entry.type;
+			entryModel.points = entry.points;
+			entryModel.startTime = entry.startTime;
+			entryModel.answerStartTime = entry.answerStartTime;
+			entryModel.videoSongStartTime = entry.videoSongStartTime;
+			entryModel.key = EntryIndex::getEntryKey(model->id, category.name, entry.answer);
+
+			/** The media files are resolved in document order, the song file first. Empty media paths were skipped */
+			entryModel.songFile = takeMediaFile(files, fileIdx, i, j, MediaValidator::FileType::SONG);
+			if ( entry.type == EntryType::Video ) {
+				entryModel.videoFile = takeMediaFile(files, fileIdx, i, j, MediaValidator::FileType::VIDEO);
+			}
+
+			entryModel.songRange = getPackageRange(entryModel.songFile);
+			entryModel.videoRange = getPackageRange(entryModel.videoFile);
+
+			if ( progress && !progress(++done, total) ) {
+				return nullptr;
+			}
+		}
+	}
+
+	/** Row Categories */
+	model->rowCategories.reserve(document.rowCategories.size());
+	for ( size_t i = 0; i < document.rowCategories.size(); ++i ) {
+		model->rowCategories.push_back(std::string(document.rowCategories[i]));
+	}
+
+	return model;
+}
+
+size_t MusicQuiz::util::QuizModel::getNumberOfEntries() const
+{
+	size_t numberOfEntries = 0;
+	for ( size_t i = 0; i < categories.size(); ++i ) {
+		numberOfEntries += categories[i].entries.size();
+	}
+	return numberOfEntries;
+}
+
+std::string MusicQuiz::util::QuizModel::getLoadError() const
+{
+	return mediaReport.toString();
+}
\ No newline at end of file
@@ -0,0 +1,127 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include <memory>
+#include <cstdint>
+#include <functional>
+
+#include "util/QuizId.hpp"
+#include "util/QuizDocument.hpp"
+#include "util/QuizPackage.hpp"
+#include "util/MediaValidator.hpp"
+
+
+namespace MusicQuiz {
+	namespace util {
+		/**
+		 * @brief Plain data model of a quiz that is ready to be shown.
+		 *
+		 * The model holds the quiz with its media paths resolved and checked. It does not depend on Qt,
+		 * so it can be loaded and validated on a worker thread, after which the widgets are created from it on the GUI thread.
+		 */
+		class QuizModel
+		{
+		public:
+			typedef MusicQuiz::util::QuizDocument::EntryType EntryType;
+
+			/**
+			 * @brief Called with the number of steps done and the total number of steps. Returning false cancels the load.
+			 */
+			typedef std::function<bool(size_t done, size_t total)> ProgressCallback;
+
+			struct EntryModel
+			{
+				std::string name = "";
+				std::string answer = "";
+				EntryType type = EntryType::Song;
+
+				size_t points = 0;
+				size_t startTime = 0;
+				size_t answerStartTime = 0;
+				size_t videoSongStartTime = 0;
+
+				/** Full media paths */
+				std::string songFile = "";
+				std::string videoFile = "";
+
+				/** Byte ranges of the media files if the quiz is a package, invalid otherwise */
+				MusicQuiz::util::QuizPackage::Range songRange;
+				MusicQuiz::util::QuizPackage::Range videoRange;
+
+				/** Key of the entry in the play history, see EntryIndex::getEntryKey */
+				std::uint64_t key = 0;
+			};
+
+			struct CategoryModel
+			{
+				std::string name = "";
+				std::vector<EntryModel> entries;
+			};
+
+			/**
+			 * @brief Default constructor
+			 */
+			QuizModel() = default;
+
+			/**
+			 * @brief Default destructor
+			 */
+			virtual ~QuizModel() = default;
+
+			/**
+			 * @brief Shared Pointer
+			 */
+			typedef std::shared_ptr< QuizModel > Ptr;
+			typedef std::shared_ptr< const QuizModel > CPtr;
+
+			/**
+			 * @brief Deleted the copy and assignment constructor.
+			 */
+			QuizModel(const QuizModel&) = delete;
+			QuizModel& operator=(const QuizModel&) = delete;
+
+			/**
+			 * @brief Creates the model of a quiz document and checks its media files.
+			 *
+			 * @param[in] document The quiz document.
+			 * @param[in] rootFolder The folder the media paths in the document are relative to.
+			 * @param[in] progress Called before the media files are checked, after each media file and after each entry.
+			 *                     The total counts the media files and the entries.
+			 *
+			 * @return The quiz model, or nullptr if the load was cancelled.
+			 */
+			static Ptr fromDocument(const MusicQuiz::util::QuizDocument& document, const std::string& rootFolder, const ProgressCallback& progress = nullptr);
+
+			/**
+			 * @brief Returns the number of entries in the quiz.
+			 *
+			 * @return The number of entries.
+			 */
+			size_t getNumberOfEntries() const;
+
+			/**
+			 * @brief Returns the problems found while loading the quiz, one per line.
+			 *
+			 * @return The error message. Empty if the quiz is complete.
+			 */
+			std::string getLoadError() const;
+
+			/** Source File */
+			MusicQuiz::util::QuizId id = 0;
+			std::string path = "";
+
+			/** Quiz */
+			std::string quizName = "";
+			std::string quizAuthor = "";
+			std::string quizDescription = "";
+			bool guessTheCategory = false;
+
+			std::vector<CategoryModel> categories;
+			std::vector<std::string> rowCategories;
+
+			/** Media Files */
+			MusicQuiz::util::MediaValidator::Report mediaReport;
+		};
+	}
+}
\ No newline at end of file
@@ -0,0 +1,515 @@
+#include "QuizPackage.hpp"
+
+#include <mutex>
+#include <cstring>
+#include <fstream>
+#include <algorithm>
+#include <stdexcept>
+#include <type_traits>
+
+#include <boost/filesystem.hpp>
+
+#include "util/XxHash64.hpp"
+
+#include "common/Log.hpp"
+
+
+namespace {
+	/** File Format */
+	const char MAGIC[4] = { 'M', 'Q', 'Z', 'P' };
+	const uint32_t VERSION = 1;
+	const uint32_t BYTE_ORDER_MARK = 0x01020304;
+
+	/** Media files start on a page boundary, so a mapped media file shares no page with its neighbours */
+	const uint32_t ALIGNMENT = 4096;
+
+	/** Size of the buffer used to copy media files into the package */
+	const size_t COPY_BUFFER_SIZE = 1 << 20;
+
+	const std::string PACKAGE_EXTENSION = ".quizpack";
+
+	struct StringRef
+	{
+		uint32_t offset;
+		uint32_t size;
+	};
+
+	struct Header
+	{
+		char magic[4];
+		uint32_t version;
+		uint32_t byteOrder;
+		uint32_t alignment;
+
+		uint64_t documentOffset;
+		uint64_t documentSize;
+
+		uint64_t tocOffset;
+		uint32_t numberOfMembers;
+		uint32_t stringTableSize;
+
+		uint64_t documentHash;
+		uint64_t tocHash;
+	};
+
+	struct MemberRecord
+	{
+		StringRef name;
+		uint64_t offset;
+		uint64_t size;
+		uint64_t hash;
+	};
+
+	/** The records are written and read as is, their layout must not depend on the compiler */
+	static_assert(sizeof(StringRef) == 8, "Unexpected size of StringRef.");
+	static_assert(sizeof(Header) == 64, "Unexpected size of Header.");
+	static_assert(sizeof(MemberRecord) == 32, "Unexpected size of MemberRecord.");
+	static_assert(std::is_trivially_copyable<MemberRecord>::value, "Records must be trivially copyable.");
+
+	/**
+	 * @brief Copies a record out of the mapped file.
+	 *
+	 * @param[in] data The mapped file.
+	 * @param[in] offset The offset of the record.
+	 *
+	 * @return The record.
+	 */
+	template<typename T>
+	T readRecord(const std::string_view data, const uint64_t offset)
+	{
+		T record;
+		std::memcpy(&record, data.data() + offset, sizeof(T));
+		return record;
+	}
+
+	/**
+	 * @brief Writes zeros up to the next multiple of the alignment.
+	 *
+	 * @param[in] out The package file.
+	 * @param[in,out] offset The current offset, moved to the aligned offset.
+	 */
+	void pad(std::ofstream& out, uint64_t& offset)
+	{
+		static const char zeros[ALIGNMENT] = { 0 };
+		const uint64_t padding = (ALIGNMENT - offset % ALIGNMENT) % ALIGNMENT;
+		out.write(zeros, static_cast<std::streamsize>(padding));
+		offset += padding;
+	}
+
+	/**
+	 * @brief Returns the key of a package in the list of open packages.
+	 *
+	 * @param[in] path The path of the package.
+	 *
+	 * @return The absolute path without '.' and '..' elements.
+	 */
+	std::string getPackageKey(const std::string& path)
+	{
+		return boost::filesystem::absolute(path).lexically_normal().generic_string();
+	}
+
+	std::mutex& getPackagesMutex()
+	{
+		static std::mutex mutex;
+		return mutex;
+	}
+
+	std::unordered_map< std::string, std::weak_ptr<const MusicQuiz::util::QuizPackage> >& getOpenPackages()
+	{
+		static std::unordered_map< std::string, std::weak_ptr<const MusicQuiz::util::QuizPackage> > packages;
+		return packages;
+	}
+}
+
+
+const char* MusicQuiz::util::QuizPackage::Range::getData() const
+{
+	if ( package == nullptr || package->_file.getData() == nullptr ) {
+		return nullptr;
+	}
+	return package->_file.getData() + offset;
+}
+
+bool MusicQuiz::util::QuizPackage::Range::isValid() const
+{
+	return package != nullptr;
+}
+
+MusicQuiz::util::QuizPackage::QuizPackage(const std::string& path) :
+	_path(path), _file(path)
+{
+	_lastWriteTime = boost::filesystem::last_write_time(path);
+	const std::string_view data = _file.getView();
+
+	/** Header */
+	if ( data.size() < sizeof(Header) ) {
+		throw std::runtime_error("Quiz package '" + path + "' is truncated.");
+	}
+
+	const Header header = readRecord<Header>(data, 0);
+	if ( std::memcmp(header.magic, MAGIC, sizeof(MAGIC)) != 0 || header.byteOrder != BYTE_ORDER_MARK ) {
+		throw std::runtime_error("'" + path + "' is not a quiz package.");
+	}
+
+	if ( header.version != VERSION ) {
+		throw std::runtime_error("Quiz package '" + path + "' has unsupported version " + std::to_string(header.version) + ".");
+	}
+
+	/** Layout. The offsets and sizes are untrusted, they are compared without sums that could overflow */
+	const uint64_t tocSize = static_cast<uint64_t>(header.numberOfMembers) * sizeof(MemberRecord) + header.stringTableSize;
+	if ( header.tocOffset > data.size() || tocSize != data.size() - header.tocOffset ||
+		header.documentOffset < sizeof(Header) || header.documentOffset > header.tocOffset || header.documentSize > header.tocOffset - header.documentOffset ) {
+		throw std::runtime_error("Quiz package '" + path + "' has an invalid size.");
+	}
+
+	/** Checksums of the quiz and the table of contents, the media files are only checked by verify */
+	_document = data.substr(header.documentOffset, header.documentSize);
+	if ( XxHash64::hash(_document.data(), _document.size()) != header.documentHash ) {
+		throw std::runtime_error("Quiz package '" + path + "' has a corrupt quiz.");
+	}
+
+	if ( XxHash64::hash(data.data() + header.tocOffset, tocSize) != header.tocHash ) {
+		throw std::runtime_error("Quiz package '" + path + "' has a corrupt table of contents.");
+	}
+
+	/** Table of Contents */
+	const uint64_t stringsOffset = header.tocOffset + static_cast<uint64_t>(header.numberOfMembers) * sizeof(MemberRecord);
+	const std::string_view strings = data.substr(stringsOffset, header.stringTableSize);
+	const uint64_t mediaOffset = header.documentOffset + header.documentSize;
+
+	_members.resize(header.numberOfMembers);
+	_index.reserve(header.numberOfMembers);
+	for ( size_t i = 0; i < header.numberOfMembers; ++i ) {
+		const MemberRecord record = readRecord<MemberRecord>(data, header.tocOffset + i * sizeof(MemberRecord));
+		if ( static_cast<uint64_t>(record.name.offset) + record.name.size > strings.size() ) {
+			throw std::runtime_error("Quiz package '" + path + "' has an invalid string reference.");
+		}
+
+		if ( record.offset < mediaOffset || record.offset > header.tocOffset || record.size > header.tocOffset - record.offset ) {
+			throw std::runtime_error("Quiz package '" + path + "' has an invalid media file.");
+		}
+
+		Member& member = _members[i];
+		member.name = strings.substr(record.name.offset, record.name.size);
+		member.offset = record.offset;
+		member.size = record.size;
+		member.hash = record.hash;
+
+		if ( !_index.emplace(member.name, i).second ) {
+			throw std::runtime_error("Quiz package '" + path + "' contains '" + std::string(member.name) + "' twice.");
+		}
+	}
+}
+
+MusicQuiz::util::QuizPackage::CPtr MusicQuiz::util::QuizPackage::open(const std::string& path, const bool reopen)
+{
+	const std::string key = getPackageKey(path);
+
+	std::lock_guard<std::mutex> lock(getPackagesMutex());
+	std::unordered_map< std::string, std::weak_ptr<const QuizPackage> >& packages = getOpenPackages();
+
+	/** Use the open package */
+	if ( !reopen ) {
+		const auto it = packages.find(key);
+		if ( it != packages.end() ) {
+			const CPtr package = it->second.lock();
+			if ( package != nullptr ) {
+				return package;
+			}
+		}
+	}
+
+	/** Map the package, forgetting the packages that are no longer used */
+	const CPtr package = std::make_shared<const QuizPackage>(path);
+	for ( auto it = packages.begin(); it != packages.end(); ) {
+		if ( it->second.expired() ) {
+			it = packages.erase(it);
+		} else {
+			++it;
+		}
+	}
+	packages[key] = package;
+
+	return package;
+}
+
+size_t MusicQuiz::util::QuizPackage::write(const std::string& quizFile, const std::string& packagePath, const std::string& rootFolder)
+{
+	/** Quiz */
+	const MusicQuiz::util::MappedFile quiz(quizFile);
+	const QuizDocument::Ptr document = QuizDocument::fromBuffer(quiz.getView(), quizFile);
+
+	std::string root = rootFolder;
+	std::replace(root.begin(), root.end(), '\\', '/');
+	if ( !root.empty() && root.back() != '/' ) {
+		root += "/";
+	}
+
+	/** Media files, each file once in the order they are used */
+	std::vector< std::pair<std::string, std::string> > media;
+	std::unordered_map<std::string, size_t> known;
+	const auto addMedia = [&](const std::string_view file) {
+		if ( file.empty() ) {
+			return;
+		}
+
+		const std::string name = getMemberName(file);
+		if ( known.emplace(name, media.size()).second ) {
+			media.emplace_back(name, root + name);
+		}
+	};
+
+	for ( size_t i = 0; i < document->categories.size(); ++i ) {
+		const QuizDocument::Category& category = document->categories[i];
+		for ( size_t j = 0; j < category.entries.size(); ++j ) {
+			addMedia(category.entries[j].songFile);
+			if ( category.entries[j].type == QuizDocument::EntryType::Video ) {
+				addMedia(category.entries[j].videoFile);
+			}
+		}
+	}
+
+	/** Header, written again once the offsets are known */
+	Header header;
+	std::memset(&header, 0, sizeof(Header));
+	std::memcpy(header.magic, MAGIC, sizeof(MAGIC));
+	header.version = VERSION;
+	header.byteOrder = BYTE_ORDER_MARK;
+	header.alignment = ALIGNMENT;
+
+	const std::string tmpPath = packagePath + ".tmp";
+	std::ofstream out(tmpPath, std::ios::binary | std::ios::trunc);
+	if ( !out.is_open() ) {
+		throw std::runtime_error("Failed to open '" + tmpPath + "'.");
+	}
+
+	try {
+		out.write(reinterpret_cast<const char*>(&header), sizeof(Header));
+		uint64_t offset = sizeof(Header);
+
+		/** Quiz */
+		const std::string_view xml = quiz.getView();
+		header.documentOffset = offset;
+		header.documentSize = xml.size();
+		header.documentHash = XxHash64::hash(xml.data(), xml.size());
+		out.write(xml.data(), static_cast<std::streamsize>(xml.size()));
+		offset += xml.size();
+
+		/** Media Files */
+		std::string strings;
+		std::vector<MemberRecord> records;
+		std::vector<char> buffer(COPY_BUFFER_SIZE);
+		for ( size_t i = 0; i < media.size(); ++i ) {
+			const std::string& name = media[i].first;
+			const std::string& source = media[i].second;
+
+			std::ifstream in(source, std::ios::in | std::ios::binary);
+			if ( !in.is_open() ) {
+				throw std::runtime_error("Media file '" + source + "' does not exist.");
+			}
+
+			if ( strings.size() + name.size() > UINT32_MAX ) {
+				throw std::runtime_error("Quiz is too large for the package format.");
+			}
+
+			pad(out, offset);
+
+			MemberRecord record;
+			std::memset(&record, 0, sizeof(MemberRecord));
+			record.name.offset = static_cast<uint32_t>(strings.size());
+			record.name.size = static_cast<uint32_t>(name.size());
+			record.offset = offset;
+			strings += name;
+
+			/** Copy and hash the file in one pass */
+			XxHash64 hash;
+			while ( in ) {
+				in.read(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+				const size_t count = static_cast<size_t>(in.gcount());
+				if ( count == 0 ) {
+					break;
+				}
+				hash.update(buffer.data(), count);
+				out.write(buffer.data(), static_cast<std::streamsize>(count));
+				record.size += count;
+			}
+
+			if ( in.bad() ) {
+				throw std::runtime_error("Failed to read media file '" + source + "'.");
+			}
+
+			record.hash = hash.digest();
+			records.push_back(record);
+			offset += record.size;
+		}
+
+		/** Table of Contents */
+		XxHash64 tocHash;
+		tocHash.update(records.data(), records.size() * sizeof(MemberRecord));
+		tocHash.update(strings.data(), strings.size());
+
+		header.tocOffset = offset;
+		header.numberOfMembers = static_cast<uint32_t>(records.size());
+		header.stringTableSize = static_cast<uint32_t>(strings.size());
+		header.tocHash = tocHash.digest();
+		out.write(reinterpret_cast<const char*>(records.data()), static_cast<std::streamsize>(records.size() * sizeof(MemberRecord)));
+		out.write(strings.data(), static_cast<std::streamsize>(strings.size()));
+
+		/** Header */
+		out.seekp(0);
+		out.write(reinterpret_cast<const char*>(&header), sizeof(Header));
+		out.close();
+
+		if ( !out ) {
+			throw std::runtime_error("Failed to write '" + tmpPath + "'.");
+		}
+	} catch ( ... ) {
+		out.close();
+		boost::system::error_code err;
+		boost::filesystem::remove(tmpPath, err);
+		throw;
+	}
+
+	boost::filesystem::rename(tmpPath, packagePath);
+	LOG_INFO("Wrote quiz package '" << packagePath << "' with " << media.size() << " media files.");
+
+	return media.size();
+}
+
+bool MusicQuiz::util::QuizPackage::isPackageFile(const std::string& path)
+{
+	return path.size() >= PACKAGE_EXTENSION.size() && path.compare(path.size() - PACKAGE_EXTENSION.size(), PACKAGE_EXTENSION.size(), PACKAGE_EXTENSION) == 0;
+}
+
+bool MusicQuiz::util::QuizPackage::splitPath(const std::string& path, std::string& packagePath, std::string& member)
+{
+	const size_t pos = path.find(PACKAGE_EXTENSION + "/");
+	if ( pos == std::string::npos ) {
+		return false;
+	}
+
+	const size_t end = pos + PACKAGE_EXTENSION.size();
+	if ( end + 1 >= path.size() ) {
+		return false;
+	}
+
+	packagePath = path.substr(0, end);
+	member = path.substr(end + 1);
+	return true;
+}
+
+std::string MusicQuiz::util::QuizPackage::getMemberName(const std::string_view mediaPath)
+{
+	std::string name(mediaPath);
+	std::replace(name.begin(), name.end(), '\\', '/');
+
+	/** The media paths are relative to the working folder, usually written as ./data/... */
+	size_t start = 0;
+	while ( name.compare(start, 2, "./") == 0 ) {
+		start += 2;
+	}
+	while ( start < name.size() && name[start] == '/' ) {
+		++start;
+	}
+
+	return name.substr(start);
+}
+
+const MusicQuiz::util::QuizPackage::Member* MusicQuiz::util::QuizPackage::find(const std::string_view name) const
+{
+	const auto it = _index.find(name);
+	if ( it == _index.end() ) {
+		return nullptr;
+	}
+	return &_members[it->second];
+}
+
+MusicQuiz::util::QuizPackage::Range MusicQuiz::util::QuizPackage::getRange(const CPtr& package, const std::string_view name)
+{
+	Range range;
+	if ( package == nullptr ) {
+		return range;
+	}
+
+	const Member* member = package->find(name);
+	if ( member != nullptr ) {
+		range.package = package;
+		range.offset = member->offset;
+		range.size = member->size;
+	}
+	return range;
+}
+
+std::string MusicQuiz::util::QuizPackage::getMediaPath(const std::string_view name) const
+{
+	std::string path;
+	path.reserve(_path.size() + 1 + name.size());
+	path.append(_path).append("/").append(name.data(), name.size());
+	return path;
+}
+
+const std::vector<MusicQuiz::util::QuizPackage::Member>& MusicQuiz::util::QuizPackage::getMembers() const
+{
+	return _members;
+}
+
+std::string_view MusicQuiz::util::QuizPackage::getDocument() const
+{
+	return _document;
+}
+
+MusicQuiz::util::QuizDocument::Ptr MusicQuiz::util::QuizPackage::readDocument() const
+{
+	QuizDocument::Ptr document = QuizDocument::fromBuffer(_document, _path);
+	document->lastWriteTime = _lastWriteTime;
+	document->fileSize = getFileSize();
+
+	/** Point the media files into the package */
+	for ( size_t i = 0; i < document->categories.size(); ++i ) {
+		QuizDocument::Category& category = document->categories[i];
+		for ( size_t j = 0; j < category.entries.size(); ++j ) {
+			QuizDocument::Entry& entry = category.entries[j];
+			if ( !entry.songFile.empty() ) {
+				entry.songFile = document->store(getMediaPath(getMemberName(entry.songFile)));
+			}
+
+			if ( !entry.videoFile.empty() ) {
+				entry.videoFile = document->store(getMediaPath(getMemberName(entry.videoFile)));
+			}
+		}
+	}
+
+	return document;
+}
+
+MusicQuiz::util::QuizPreview MusicQuiz::util::QuizPackage::readPreview() const
+{
+	return QuizDocument::previewFromBuffer(_document, _path);
+}
+
+std::vector<std::string> MusicQuiz::util::QuizPackage::verify() const
+{
+	std::vector<std::string> corrupt;
+	for ( size_t i = 0; i < _members.size(); ++i ) {
+		const Member& member = _members[i];
+		if ( XxHash64::hash(_file.getData() + member.offset, member.size) != member.hash ) {
+			corrupt.push_back(std::string(member.name));
+		}
+	}
+	return corrupt;
+}
+
+const std::string& MusicQuiz::util::QuizPackage::getPath() const
+{
+	return _path;
+}
+
+std::time_t MusicQuiz::util::QuizPackage::getLastWriteTime() const
+{
+	return _lastWriteTime;
+}
+
+std::uintmax_t MusicQuiz::util::QuizPackage::getFileSize() const
+{
+	return _file.getSize();
+}
\ No newline at end of file
@@ -0,0 +1,234 @@
+#pragma once
+
+#include <ctime>
+#include <string>
+#include <vector>
+#include <memory>
+#include <cstdint>
+#include <string_view>
+#include <unordered_map>
+
+#include "util/MappedFile.hpp"
+#include "util/QuizPreview.hpp"
+#include "util/QuizDocument.hpp"
+
+
+namespace MusicQuiz {
+	namespace util {
+		/**
+		 * @brief Single file quiz package (.quizpack).
+		 *
+		 * A package holds the quiz XML and all its media files, so a quiz can be copied, checksummed and replaced as one file.
+		 * It consists of a fixed size header, the quiz XML, the media files stored uncompressed and aligned to pages,
+		 * and a table of contents with the name, byte range and hash of each media file.
+		 * An open package maps the whole file once, media files are then served as byte ranges of the mapping.
+		 *
+		 * Documents read from a package refer to their media by virtual paths of the form <package path>/<media path>.
+		 */
+		class QuizPackage
+		{
+		public:
+			/**
+			 * @brief Shared Pointer
+			 */
+			typedef std::shared_ptr< QuizPackage > Ptr;
+			typedef std::shared_ptr< const QuizPackage > CPtr;
+
+			struct Member
+			{
+				std::string_view name;
+				std::uint64_t offset = 0;
+				std::uint64_t size = 0;
+				std::uint64_t hash = 0;
+			};
+
+			/**
+			 * @brief Byte range of a media file in a package. The range keeps the package mapped.
+			 */
+			struct Range
+			{
+				CPtr package = nullptr;
+				std::uint64_t offset = 0;
+				std::uint64_t size = 0;
+
+				/**
+				 * @brief Returns the first byte of the range.
+				 *
+				 * @return Pointer into the mapping, or nullptr if the range is empty.
+				 */
+				const char* getData() const;
+
+				/**
+				 * @brief Checks if the range refers to a package.
+				 *
+				 * @return True if the range is set.
+				 */
+				bool isValid() const;
+			};
+
+			/**
+			 * @brief Constructor. Maps the package and reads the table of contents.
+			 *
+			 * @param[in] path The path of the package.
+			 */
+			explicit QuizPackage(const std::string& path);
+
+			/**
+			 * @brief Default destructor
+			 */
+			virtual ~QuizPackage() = default;
+
+			/**
+			 * @brief Deleted the copy and assignment constructor.
+			 */
+			QuizPackage(const QuizPackage&) = delete;
+			QuizPackage& operator=(const QuizPackage&) = delete;
+
+			/**
+			 * @brief Opens a package. Packages are shared, a package that is already open is mapped once.
+			 *
+			 * @param[in] path The path of the package.
+			 * @param[in] reopen Maps the file again instead of using the open package, used after the file has been replaced.
+			 *
+			 * @return The package.
+			 */
+			static CPtr open(const std::string& path, bool reopen = false);
+
+			/**
+			 * @brief Writes a quiz and its media files to a package. The package is written to a temporary file first,
+			 *        so an existing package is replaced in one step.
+			 *
+			 * @param[in] quizFile The path of the quiz XML.
+			 * @param[in] packagePath The path of the package.
+			 * @param[in] rootFolder The folder the media paths in the quiz are relative to.
+			 *
+			 * @return The number of media files in the package.
+			 */
+			static size_t write(const std::string& quizFile, const std::string& packagePath, const std::string& rootFolder);
+
+			/**
+			 * @brief Checks if a path has the package extension.
+			 *
+			 * @param[in] path The path.
+			 *
+			 * @return True if the path is a package.
+			 */
+			static bool isPackageFile(const std::string& path);
+
+			/**
+			 * @brief Splits a virtual media path into the path of the package and the name of the member.
+			 *
+			 * @param[in] path The virtual media path.
+			 * @param[out] packagePath The path of the package.
+			 * @param[out] member The name of the media file in the package.
+			 *
+			 * @return False if the path does not point into a package.
+			 */
+			static bool splitPath(const std::string& path, std::string& packagePath, std::string& member);
+
+			/**
+			 * @brief Converts a media path as written in a quiz file to the name of the media file in a package.
+			 *
+			 * @param[in] mediaPath The media path.
+			 *
+			 * @return The member name.
+			 */
+			static std::string getMemberName(std::string_view mediaPath);
+
+			/**
+			 * @brief Looks up a media file.
+			 *
+			 * @param[in] name The member name, see getMemberName.
+			 *
+			 * @return The media file, or nullptr if the package does not contain it.
+			 */
+			const Member* find(std::string_view name) const;
+
+			/**
+			 * @brief Returns the byte range of a media file.
+			 *
+			 * @param[in] package The package.
+			 * @param[in] name The member name.
+			 *
+			 * @return The range, invalid if the package does not contain the file.
+			 */
+			static Range getRange(const CPtr& package, std::string_view name);
+
+			/**
+			 * @brief Returns the virtual path of a media file.
+			 *
+			 * @param[in] name The member name.
+			 *
+			 * @return The virtual path.
+			 */
+			std::string getMediaPath(std::string_view name) const;
+
+			/**
+			 * @brief Returns the media files in the order they are stored.
+			 *
+			 * @return The members.
+			 */
+			const std::vector<Member>& getMembers() const;
+
+			/**
+			 * @brief Returns the quiz XML.
+			 *
+			 * @return View into the mapping.
+			 */
+			std::string_view getDocument() const;
+
+			/**
+			 * @brief Parses the quiz. The media paths of the entries are replaced by virtual paths into the package.
+			 *
+			 * @return The quiz document.
+			 */
+			MusicQuiz::util::QuizDocument::Ptr readDocument() const;
+
+			/**
+			 * @brief Reads the preview of the quiz.
+			 *
+			 * @return The quiz preview.
+			 */
+			MusicQuiz::util::QuizPreview readPreview() const;
+
+			/**
+			 * @brief Hashes all media files and compares them with the table of contents. Reads the whole package.
+			 *
+			 * @return The names of the media files that do not match. Empty if the package is intact.
+			 */
+			std::vector<std::string> verify() const;
+
+			/**
+			 * @brief Returns the path of the package.
+			 *
+			 * @return The path.
+			 */
+			const std::string& getPath() const;
+
+			/**
+			 * @brief Returns the last write time of the package when it was mapped.
+			 *
+			 * @return The last write time.
+			 */
+			std::time_t getLastWriteTime() const;
+
+			/**
+			 * @brief Returns the size of the package.
+			 *
+			 * @return The size in bytes.
+			 */
+			std::uintmax_t getFileSize() const;
+
+		protected:
+			/** Variables */
+			const std::string _path;
+			std::time_t _lastWriteTime = 0;
+
+			MusicQuiz::util::MappedFile _file;
+			std::string_view _document;
+
+			std::vector<Member> _members;
+			std::unordered_map<std::string_view, size_t> _index;
+		};
+	}
+}
\ No newline at end of file
@@ -0,0 +1,49 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include <iostream>
+
+
+namespace MusicQuiz {
+	namespace util {
+		struct QuizPreview
+		{
+			std::string quizName = "";
+			std::string quizAuthor = "";
+			bool includeSongs = false;
+			bool includeVideos = false;
+			size_t numberOfSongs = 0;
+			size_t numberOfVideos = 0;
+			bool guessTheCategory = false;
+			std::string quizDescription = "";
+			std::vector<std::string> categories;
+			std::vector<std::string> rowCategories;
+
+			friend std::ostream& operator<<(std::ostream& out, const QuizPreview& quizPreview)
+			{
+				out << "\n\nQuiz Name: " << quizPreview.quizName << "\n";
+				out << "Quiz Author: " << quizPreview.quizAuthor << "\n";
+				out << "Quiz Description: " << quizPreview.quizDescription << "\n";
+				if ( !quizPreview.categories.empty() ) {
+					out << "Quiz Categories:\n";
+					for ( size_t i = 0; i < quizPreview.categories.size(); ++i ) {
+						out << "\t" << quizPreview.categories[i] << "\n";
+					}
+				}
+
+				if ( !quizPreview.rowCategories.empty() ) {
+					out << "Quiz Row Categories:\n";
+					for ( size_t i = 0; i < quizPreview.rowCategories.size(); ++i ) {
+						out << "\t" << quizPreview.rowCategories[i] << "\n";
+					}
+				}
+
+				out << "Quiz Include Songs: " << (quizPreview.includeSongs ? "Yes" : "No") << " (" << quizPreview.numberOfSongs << ")\n";
+				out << "Quiz Include Videos: " << (quizPreview.includeVideos ? "Yes" : "No") << " (" << quizPreview.numberOfVideos << ")\n";
+				out << "Quiz Quess the Category: " << (quizPreview.guessTheCategory ? "Yes" : "No") << "\n\n";
+				return out;
+			}
+		};
+	}
+}
\ No newline at end of file
@@ -0,0 +1,668 @@
+#include "QuizSaveTask.hpp"
+
+#include <fstream>
+#include <utility>
+#include <algorithm>
+#include <stdexcept>
+#include <unordered_set>
+#include <unordered_map>
+
+#include <boost/filesystem.hpp>
+
+#include "common/Log.hpp"
+#include "common/TimeUtil.hpp"
+#include "util/QuizBinary.hpp"
+#include "util/QuizCatalog.hpp"
+#include "util/QuizDocument.hpp"
+#include "util/QuizXmlWriter.hpp"
+
+
+namespace {
+	/** Size of the chunks the media files are compared in */
+	constexpr size_t COMPARE_CHUNK_SIZE = 1 << 20;
+
+	/** Folders and files of a save in progress, in the quiz folder */
+	const std::string MEDIA_FOLDER = "media";
+	const std::string NEW_MEDIA_FOLDER = "mediaTmp";
+	const std::string OLD_MEDIA_FOLDER = "mediaOld";
+	const std::string TMP_QUIZ_FILE_SUFFIX = ".tmp";
+	const std::string COMMITTED_QUIZ_FILE_SUFFIX = ".new";
+
+	/**
+	 * @brief Returns the mutex that serializes finishing committed saves, such that a recovery at a catalog refresh
+	 *        does not finish a save that its task is finishing at the same time.
+	 *
+	 * @return The mutex.
+	 */
+	std::mutex& getFinishMutex()
+	{
+		static std::mutex mutex;
+		return mutex;
+	}
+
+	/**
+	 * @brief Syncs a folder and its sub folders to disk, so the files created in them survive a crash.
+	 *
+	 * @param[in] folder The folder.
+	 */
+	void syncFolderTree(const std::string& folder)
+	{
+		boost::filesystem::recursive_directory_iterator it(folder), end;
+		for ( ; it != end; ++it ) {
+			if ( boost::filesystem::is_directory(it->symlink_status()) ) {
+				MusicQuiz::util::FileCopier::syncFolder(it->path().string());
+			}
+		}
+		MusicQuiz::util::FileCopier::syncFolder(folder);
+	}
+
+	/**
+	 * @brief Returns the path of a file relative to a folder, with '/' as separator.
+	 *
+	 * @param[in] path The canonical path of the file.
+	 * @param[in] folder The canonical path of the folder.
+	 *
+	 * @return The relative path, or an empty string if the file is not in the folder.
+	 */
+	std::string getRelativePath(const boost::filesystem::path& path, const boost::filesystem::path& folder)
+	{
+		const std::string file = path.generic_string();
+		const std::string prefix = folder.generic_string() + "/";
+		if ( file.size() <= prefix.size() || file.compare(0, prefix.size(), prefix) != 0 ) {
+			return "";
+		}
+		return file.substr(prefix.size());
+	}
+}
+
+
+MusicQuiz::util::QuizSaveTask::QuizSaveTask(const QuizSnapshot& snapshot, const std::string& dataFolder, const Options& options) :
+	_snapshot(snapshot), _options(options), _quizFolder(dataFolder + "/" + snapshot.quizName), _quizFile(_quizFolder + "/" + snapshot.quizName + ".quiz.xml"),
+	_state(State::RUNNING), _cancelled(false), _committing(false), _filesDone(0), _filesTotal(0),
+	_filesKept(0), _filesMoved(0), _bytesDone(0), _bytesTotal(0), _currentFileDone(0), _currentFileSize(0)
+{
+	_thread = std::thread(&QuizSaveTask::run, this);
+}
+
+MusicQuiz::util::QuizSaveTask::~QuizSaveTask()
+{
+	cancel();
+	wait();
+}
+
+void MusicQuiz::util::QuizSaveTask::cancel()
+{
+	std::lock_guard<std::mutex> lock(_mutex);
+	if ( !_committing ) {
+		_cancelled = true;
+	}
+}
+
+void MusicQuiz::util::QuizSaveTask::wait()
+{
+	if ( _thread.joinable() ) {
+		_thread.join();
+	}
+}
+
+MusicQuiz::util::QuizSaveTask::State MusicQuiz::util::QuizSaveTask::getState() const
+{
+	return _state;
+}
+
+MusicQuiz::util::QuizSaveTask::Progress MusicQuiz::util::QuizSaveTask::getProgress() const
+{
+	Progress progress;
+	progress.filesDone = _filesDone;
+	progress.filesTotal = _filesTotal;
+	progress.filesKept = _filesKept;
+	progress.filesMoved = _filesMoved;
+	progress.bytesDone = _bytesDone;
+	progress.bytesTotal = _bytesTotal;
+	progress.currentFileDone = _currentFileDone;
+	progress.currentFileSize = _currentFileSize;
+	progress.committing = _committing;
+
+	std::lock_guard<std::mutex> lock(_mutex);
+	progress.currentFile = _currentFile;
+	progress.copyBackends = _copyBackends;
+
+	/** Speed of the copying only, so planning and writing the quiz do not count */
+	if ( _copyStartTime != std::chrono::steady_clock::time_point() ) {
+		const std::chrono::steady_clock::time_point end = _copyEndTime != std::chrono::steady_clock::time_point() ? _copyEndTime : std::chrono::steady_clock::now();
+		const double seconds = std::chrono::duration<double>(end - _copyStartTime).count();
+		if ( seconds > 0.0 ) {
+			progress.bytesPerSecond = static_cast<double>(progress.bytesDone) / seconds;
+		}
+	}
+	return progress;
+}
+
+const std::string& MusicQuiz::util::QuizSaveTask::getQuizFile() const
+{
+	return _quizFile;
+}
+
+std::string MusicQuiz::util::QuizSaveTask::getError() const
+{
+	std::lock_guard<std::mutex> lock(_mutex);
+	return _error;
+}
+
+bool MusicQuiz::util::QuizSaveTask::recover(const std::string& quizFile)
+{
+	std::lock_guard<std::mutex> lock(getFinishMutex());
+	const std::string committedQuizFile = quizFile + COMMITTED_QUIZ_FILE_SUFFIX;
+	if ( !boost::filesystem::is_regular_file(committedQuizFile) ) {
+		return false;
+	}
+
+	LOG_INFO("Finishing the interrupted save of '" << quizFile << "'.");
+	finishSave(quizFile);
+	return true;
+}
+
+void MusicQuiz::util::QuizSaveTask::finishSave(const std::string& quizFile)
+{
+	/** Swap the media folders. The new media folder is gone if it was already moved into place */
+	const std::string quizFolder = boost::filesystem::path(quizFile).parent_path().string();
+	const std::string mediaFolder = quizFolder + "/" + MEDIA_FOLDER;
+	const std::string newMediaFolder = quizFolder + "/" + NEW_MEDIA_FOLDER;
+	const std::string oldMediaFolder = quizFolder + "/" + OLD_MEDIA_FOLDER;
+	if ( boost::filesystem::is_directory(newMediaFolder) ) {
+		if ( boost::filesystem::exists(mediaFolder) ) {
+			boost::filesystem::remove_all(oldMediaFolder);
+			boost::filesystem::rename(mediaFolder, oldMediaFolder);
+		}
+		boost::filesystem::rename(newMediaFolder, mediaFolder);
+	}
+
+	/** Move the quiz file into place */
+	boost::filesystem::rename(quizFile + COMMITTED_QUIZ_FILE_SUFFIX, quizFile);
+	FileCopier::syncFolder(quizFolder);
+
+	boost::filesystem::remove_all(oldMediaFolder);
+}
+
+void MusicQuiz::util::QuizSaveTask::run()
+{
+	const std::string mediaFolder = _quizFolder + "/" + MEDIA_FOLDER;
+	const std::string stagingFolder = _quizFolder + "/" + NEW_MEDIA_FOLDER;
+	const std::string tmpQuizFile = _quizFile + TMP_QUIZ_FILE_SUFFIX;
+	const std::string committedQuizFile = _quizFile + COMMITTED_QUIZ_FILE_SUFFIX;
+
+	try {
+		/** Finish a save that was interrupted after it was committed, and remove what is left of one that was not */
+		boost::filesystem::create_directories(_quizFolder);
+		recover(_quizFile);
+		boost::filesystem::remove_all(stagingFolder);
+		boost::filesystem::remove_all(_quizFolder + "/" + OLD_MEDIA_FOLDER);
+		boost::filesystem::remove(tmpQuizFile);
+		boost::filesystem::create_directory(stagingFolder);
+
+		/** Collect Media Files */
+		std::vector<MediaFile> mediaFiles = planMedia(mediaFolder, stagingFolder);
+		size_t filesTotal = 0, filesKept = 0, filesMoved = 0;
+		std::uintmax_t bytesTotal = 0;
+		for ( size_t i = 0; i < mediaFiles.size(); ++i ) {
+			if ( mediaFiles[i].action == Action::COPY || mediaFiles[i].action == Action::STORE ) {
+				++filesTotal;
+				bytesTotal += mediaFiles[i].size;
+			} else if ( mediaFiles[i].action == Action::KEEP ) {
+				++filesKept;
+			} else if ( mediaFiles[i].action == Action::MOVE ) {
+				++filesMoved;
+			}
+		}
+		_filesTotal = filesTotal;
+		_filesKept = filesKept;
+		_filesMoved = filesMoved;
+		_bytesTotal = bytesTotal;
+
+		/** Copy Media Files */
+		if ( !copyMedia(mediaFiles) ) {
+			boost::filesystem::remove_all(stagingFolder);
+			_state = State::CANCELLED;
+			return;
+		}
+
+		/** From here on the quiz on disk is changed, so the task can no longer be cancelled */
+		{
+			std::lock_guard<std::mutex> lock(_mutex);
+			_committing = !_cancelled;
+		}
+
+		if ( !_committing ) {
+			boost::filesystem::remove_all(stagingFolder);
+			_state = State::CANCELLED;
+			return;
+		}
+
+		/** Complete the new media folder */
+		linkMedia(mediaFiles, mediaFolder);
+
+		/** Write Quiz */
+		writeQuizFile(mediaFiles, tmpQuizFile);
+
+		/** The copied media files are synced as they are written, their folder entries before the commit */
+		syncFolderTree(stagingFolder);
+
+		/** Commit. From here on the save is finished by recover() if it is interrupted */
+		{
+			std::lock_guard<std::mutex> lock(getFinishMutex());
+			boost::filesystem::rename(tmpQuizFile, committedQuizFile);
+			FileCopier::syncFolder(_quizFolder);
+			finishSave(_quizFile);
+		}
+
+		/** Update the references to the media store, also when the quiz no longer uses it */
+		if ( _options.mediaStore != nullptr ) {
+			std::vector<std::string> storedFiles;
+			for ( size_t i = 0; i < mediaFiles.size(); ++i ) {
+				if ( mediaFiles[i].stored ) {
+					storedFiles.push_back(mediaFiles[i].path);
+				}
+			}
+			_options.mediaStore->setReferences(QuizCatalog::getQuizId(_quizFile), storedFiles);
+			_options.mediaStore->saveReferences();
+		}
+
+		/** Compile Quiz. The binary is only a cache of the XML, so failing to write it is not fatal */
+		try {
+			const QuizDocument::CPtr document = QuizDocument::fromFile(_quizFile);
+			QuizBinary::write(*document, QuizBinary::getBinaryPath(_quizFile));
+		} catch ( const std::exception& err ) {
+			LOG_ERROR("Failed to write compiled quiz for '" << _quizFile << "'. " << err.what());
+		}
+
+		/** Create Cheat Sheet */
+		writeCheatSheet(_quizFolder + "/" + _snapshot.quizName + ".cheatsheet.txt");
+
+		const Progress progress = getProgress();
+		std::string backends = "";
+		for ( std::map<FileCopier::Backend, size_t>::const_iterator it = progress.copyBackends.begin(); it != progress.copyBackends.end(); ++it ) {
+			backends += (backends.empty() ? "" : ", ") + FileCopier::getBackendName(it->first) + " (" + std::to_string(it->second) + ")";
+		}
+
+		LOG_INFO("Saved quiz '" << _quizFile << "'. Copied " << progress.filesDone << " media files (" << progress.bytesDone << " bytes) at "
+			<< static_cast<std::uintmax_t>(progress.bytesPerSecond) << " bytes/s" << (backends.empty() ? "" : " using " + backends) << ", kept "
+			<< progress.filesKept << " and moved " << progress.filesMoved << ".");
+		_state = State::FINISHED;
+	} catch ( const std::exception& err ) {
+		LOG_ERROR("Failed to save quiz. " << err.what());
+
+		/** A committed save is left for recover() */
+		boost::system::error_code boost_err;
+		if ( !boost::filesystem::exists(committedQuizFile, boost_err) ) {
+			boost::filesystem::remove_all(stagingFolder, boost_err);
+			boost::filesystem::remove(tmpQuizFile, boost_err);
+		}
+
+		std::lock_guard<std::mutex> lock(_mutex);
+		_error = err.what();
+		_state = State::FAILED;
+	} catch ( ... ) {
+		LOG_ERROR("Failed to save quiz.");
+
+		boost::system::error_code boost_err;
+		if ( !boost::filesystem::exists(committedQuizFile, boost_err) ) {
+			boost::filesystem::remove_all(stagingFolder, boost_err);
+			boost::filesystem::remove(tmpQuizFile, boost_err);
+		}
+
+		std::lock_guard<std::mutex> lock(_mutex);
+		_error = "Unknown error.";
+		_state = State::FAILED;
+	}
+}
+
+std::vector<MusicQuiz::util::QuizSaveTask::MediaFile> MusicQuiz::util::QuizSaveTask::planMedia(const std::string& mediaFolder, const std::string& stagingFolder) const
+{
+	std::vector<MediaFile> mediaFiles;
+	for ( size_t i = 0; i < _snapshot.categories.size(); ++i ) {
+		const QuizSnapshot::Category& category = _snapshot.categories[i];
+		for ( size_t j = 0; j < category.entries.size(); ++j ) {
+			const QuizSnapshot::Entry& entry = category.entries[j];
+			std::vector< std::pair<std::string, std::string> > files;
+			if ( entry.type == QuizSnapshot::EntryType::Song && !entry.songFile.empty() ) {
+				files.emplace_back(entry.songFile, getMediaFileName(entry, "", entry.songFile));
+			} else if ( entry.type == QuizSnapshot::EntryType::Video && !entry.videoFile.empty() && !entry.songFile.empty() ) {
+				files.emplace_back(entry.videoFile, getMediaFileName(entry, "_video", entry.videoFile));
+				files.emplace_back(entry.songFile, getMediaFileName(entry, "_song", entry.songFile));
+			}
+
+			for ( size_t k = 0; k < files.size(); ++k ) {
+				MediaFile mediaFile;
+				mediaFile.source = files[k].first;
+				mediaFile.destination = category.name + "/" + files[k].second;
+				mediaFile.size = boost::filesystem::file_size(mediaFile.source);
+				mediaFile.staged = stagingFolder + "/" + mediaFile.destination;
+				mediaFile.path = _quizFolder + "/" + MEDIA_FOLDER + "/" + mediaFile.destination;
+				mediaFiles.push_back(mediaFile);
+			}
+		}
+	}
+
+	/** Files already in the media store are kept, the others are added to it */
+	if ( _options.useMediaStore && _options.mediaStore != nullptr ) {
+		for ( size_t i = 0; i < mediaFiles.size(); ++i ) {
+			MediaFile& mediaFile = mediaFiles[i];
+			mediaFile.stored = true;
+			if ( _options.mediaStore->contains(mediaFile.source) ) {
+				mediaFile.action = Action::KEEP;
+				mediaFile.path = _options.mediaStore->getPath(mediaFile.source);
+			} else {
+				mediaFile.action = Action::STORE;
+			}
+		}
+		return mediaFiles;
+	}
+
+	if ( _options.mode == Mode::FULL || !boost::filesystem::is_directory(mediaFolder) ) {
+		return mediaFiles;
+	}
+
+	/** Keep the files that are up to date, and remember which sources are already in the media folder */
+	const boost::filesystem::path mediaRoot = boost::filesystem::canonical(mediaFolder);
+	std::unordered_set<std::string> keptSources;
+	std::unordered_map< std::string, std::vector<size_t> > mediaSources;
+	for ( size_t i = 0; i < mediaFiles.size(); ++i ) {
+		MediaFile& mediaFile = mediaFiles[i];
+		const std::string source = getRelativePath(boost::filesystem::canonical(mediaFile.source), mediaRoot);
+		if ( source == mediaFile.destination ) {
+			mediaFile.action = Action::KEEP;
+			keptSources.insert(source);
+			continue;
+		}
+
+		/** A file of the quiz that was renamed. Files of other entries are never taken for the same file, however alike they are */
+		if ( !source.empty() ) {
+			mediaSources[source].push_back(i);
+			continue;
+		}
+
+		const boost::filesystem::path destination(mediaFolder + "/" + mediaFile.destination);
+		if ( boost::filesystem::is_regular_file(destination) && isSameFile(mediaFile.source, destination) ) {
+			mediaFile.action = Action::KEEP;
+		}
+	}
+
+	/** A source in the media folder that is no longer used in its own place is moved by its last user, the others copy it */
+	for ( std::unordered_map< std::string, std::vector<size_t> >::const_iterator it = mediaSources.begin(); it != mediaSources.end(); ++it ) {
+		if ( keptSources.count(it->first) == 0 ) {
+			mediaFiles[it->second.back()].action = Action::MOVE;
+		}
+	}
+	return mediaFiles;
+}
+
+bool MusicQuiz::util::QuizSaveTask::copyMedia(std::vector<MediaFile>& mediaFiles)
+{
+	{
+		std::lock_guard<std::mutex> lock(_mutex);
+		_copyStartTime = std::chrono::steady_clock::now();
+	}
+
+	size_t filesDone = 0;
+	for ( size_t i = 0; i < mediaFiles.size(); ++i ) {
+		if ( mediaFiles[i].action != Action::COPY ) {
+			continue;
+		}
+
+		{
+			std::lock_guard<std::mutex> lock(_mutex);
+			_currentFile = mediaFiles[i].source;
+		}
+		_currentFileDone = 0;
+		_currentFileSize = mediaFiles[i].size;
+
+		boost::filesystem::create_directories(boost::filesystem::path(mediaFiles[i].staged).parent_path());
+		if ( !copyFile(mediaFiles[i].source, mediaFiles[i].staged) ) {
+			return false;
+		}
+		_filesDone = ++filesDone;
+	}
+
+	{
+		std::lock_guard<std::mutex> lock(_mutex);
+		_currentFile = "";
+	}
+
+	/** Add to the media store. The files are hashed in parallel, so there is no current file */
+	std::vector<size_t> storeIndices;
+	std::vector<std::string> storeSources;
+	for ( size_t i = 0; i < mediaFiles.size(); ++i ) {
+		if ( mediaFiles[i].action == Action::STORE ) {
+			storeIndices.push_back(i);
+			storeSources.push_back(mediaFiles[i].source);
+		}
+	}
+
+	if ( !storeSources.empty() ) {
+		_currentFileDone = 0;
+		_currentFileSize = 0;
+
+		std::vector<std::string> storedPaths;
+		const bool completed = _options.mediaStore->add(storeSources, storedPaths, 0, [this](const std::uintmax_t bytes, const size_t files) {
+			_bytesDone += bytes;
+			_filesDone += files;
+			return !_cancelled;
+		});
+
+		if ( !completed ) {
+			return false;
+		}
+
+		for ( size_t i = 0; i < storeIndices.size(); ++i ) {
+			mediaFiles[storeIndices[i]].path = storedPaths[i];
+		}
+	}
+
+	{
+		std::lock_guard<std::mutex> lock(_mutex);
+		_copyEndTime = std::chrono::steady_clock::now();
+	}
+	return !_cancelled;
+}
+
+void MusicQuiz::util::QuizSaveTask::linkMedia(const std::vector<MediaFile>& mediaFiles, const std::string& mediaFolder) const
+{
+	for ( size_t i = 0; i < mediaFiles.size(); ++i ) {
+		const MediaFile& mediaFile = mediaFiles[i];
+		if ( mediaFile.stored || (mediaFile.action != Action::KEEP && mediaFile.action != Action::MOVE) ) {
+			continue;
+		}
+
+		/** The current media folder is left as it is, so the quiz stays usable until the save is committed */
+		const std::string source = mediaFile.action == Action::MOVE ? mediaFile.source : mediaFolder + "/" + mediaFile.destination;
+		boost::filesystem::create_directories(boost::filesystem::path(mediaFile.staged).parent_path());
+
+		boost::system::error_code err;
+		boost::filesystem::create_hard_link(source, mediaFile.staged, err);
+		if ( err ) {
+			FileCopier::Backend backend;
+			FileCopier::copy(source, mediaFile.staged, backend, nullptr, true);
+			boost::filesystem::last_write_time(mediaFile.staged, boost::filesystem::last_write_time(source));
+		}
+	}
+}
+
+bool MusicQuiz::util::QuizSaveTask::copyFile(const std::string& source, const std::string& destination)
+{
+	FileCopier::Backend backend;
+	const bool completed = FileCopier::copy(source, destination, backend, [this](const std::uintmax_t bytes) {
+		_currentFileDone += bytes;
+		_bytesDone += bytes;
+		return !_cancelled;
+	}, true);
+
+	if ( !completed ) {
+		return false;
+	}
+
+	{
+		std::lock_guard<std::mutex> lock(_mutex);
+		++_copyBackends[backend];
+	}
+
+	/** Keep the modification time, so the next incremental save finds the file up to date */
+	boost::filesystem::last_write_time(destination, boost::filesystem::last_write_time(source));
+	return true;
+}
+
+bool MusicQuiz::util::QuizSaveTask::isSameFile(const boost::filesystem::path& source, const boost::filesystem::path& destination) const
+{
+	if ( boost::filesystem::file_size(source) != boost::filesystem::file_size(destination) ) {
+		return false;
+	}
+
+	if ( !_options.compareContent ) {
+		return boost::filesystem::last_write_time(source) == boost::filesystem::last_write_time(destination);
+	}
+
+	std::ifstream lhs(source.string(), std::ios::binary);
+	std::ifstream rhs(destination.string(), std::ios::binary);
+	if ( !lhs.is_open() || !rhs.is_open() ) {
+		return false;
+	}
+
+	std::vector<char> lhsBuffer(COMPARE_CHUNK_SIZE), rhsBuffer(COMPARE_CHUNK_SIZE);
+	while ( lhs && rhs ) {
+		lhs.read(lhsBuffer.data(), static_cast<std::streamsize>(lhsBuffer.size()));
+		rhs.read(rhsBuffer.data(), static_cast<std::streamsize>(rhsBuffer.size()));
+		const std::streamsize count = lhs.gcount();
+		if ( count != rhs.gcount() || !std::equal(lhsBuffer.begin(), lhsBuffer.begin() + count, rhsBuffer.begin()) ) {
+			return false;
+		}
+	}
+	return !lhs.bad() && !rhs.bad();
+}
+
+void MusicQuiz::util::QuizSaveTask::writeQuizFile(const std::vector<MediaFile>& mediaFiles, const std::string& path) const
+{
+	QuizXmlWriter writer(path);
+	writer.startElement("MusicQuiz");
+	writer.writeComment(std::string("File content written on the ") + common::TimeUtil::getTimeNow());
+
+	/** Quiz Name */
+	writer.writeElement("QuizName", _snapshot.quizName);
+
+	/** Quiz Author */
+	writer.writeElement("QuizAuthor", _snapshot.quizAuthor);
+
+	/** Quiz Description */
+	writer.writeElement("QuizDescription", _snapshot.quizDescription);
+
+	/** Guess the Category Setting */
+	writer.writeElement("QuizGuessTheCategory", std::to_string(_snapshot.guessTheCategoryPoints), { { "enabled", _snapshot.guessTheCategory ? "true" : "false" } });
+
+	/** Summary used for the quiz preview, written before the categories */
+	size_t numberOfSongs = 0, numberOfVideos = 0;
+	for ( size_t i = 0; i < _snapshot.categories.size(); ++i ) {
+		const QuizSnapshot::Category& category = _snapshot.categories[i];
+		for ( size_t j = 0; j < category.entries.size(); ++j ) {
+			if ( category.entries[j].type == QuizSnapshot::EntryType::Song ) {
+				++numberOfSongs;
+			} else if ( category.entries[j].type == QuizSnapshot::EntryType::Video ) {
+				++numberOfVideos;
+			}
+		}
+	}
+
+	writer.startElement("QuizSummary", { { "songs", std::to_string(numberOfSongs) }, { "videos", std::to_string(numberOfVideos) } });
+	for ( size_t i = 0; i < _snapshot.categories.size(); ++i ) {
+		writer.writeElement("Category", "", { { "name", _snapshot.categories[i].name }, { "entries", std::to_string(_snapshot.categories[i].entries.size()) } });
+	}
+
+	for ( size_t i = 0; i < _snapshot.rowCategories.size(); ++i ) {
+		writer.writeElement("RowCategory", _snapshot.rowCategories[i]);
+	}
+	writer.endElement();
+
+	/** Categories */
+	std::unordered_map<std::string, std::string> mediaPaths;
+	for ( size_t i = 0; i < mediaFiles.size(); ++i ) {
+		mediaPaths.emplace(mediaFiles[i].destination, mediaFiles[i].path);
+	}
+
+	if ( !_snapshot.categories.empty() ) {
+		writer.startElement("QuizCategories");
+		for ( size_t i = 0; i < _snapshot.categories.size(); ++i ) {
+			const QuizSnapshot::Category& category = _snapshot.categories[i];
+			writer.startElement("Category", { { "name", category.name } });
+
+			for ( size_t j = 0; j < category.entries.size(); ++j ) {
+				const QuizSnapshot::Entry& entry = category.entries[j];
+				writer.startElement("QuizEntry", { { "name", entry.name }, { "type", entry.type == QuizSnapshot::EntryType::Video ? "video" : "song" } });
+				writer.writeElement("Answer", entry.name);
+				writer.writeElement("Points", std::to_string(entry.points));
+
+				if ( entry.type == QuizSnapshot::EntryType::Song ) { // Song
+					writer.writeElement("StartTime", std::to_string(entry.startTime));
+					writer.writeElement("AnswerStartTime", std::to_string(entry.answerStartTime));
+
+					if ( !entry.songFile.empty() ) {
+						writer.startElement("Media");
+						writer.writeElement("SongFile", mediaPaths.at(category.name + "/" + getMediaFileName(entry, "", entry.songFile)));
+						writer.endElement();
+					}
+				} else if ( entry.type == QuizSnapshot::EntryType::Video ) { // Video
+					writer.writeElement("StartTime", std::to_string(entry.startTime));
+					writer.writeElement("VideoSongStartTime", std::to_string(entry.videoSongStartTime));
+					writer.writeElement("AnswerStartTime", std::to_string(entry.answerStartTime));
+
+					if ( !entry.videoFile.empty() && !entry.songFile.empty() ) {
+						writer.startElement("Media");
+						writer.writeElement("VideoFile", mediaPaths.at(category.name + "/" + getMediaFileName(entry, "_video", entry.videoFile)));
+						writer.writeElement("SongFile", mediaPaths.at(category.name + "/" + getMediaFileName(entry, "_song", entry.songFile)));
+						writer.endElement();
+					}
+				}
+				writer.endElement();
+			}
+			writer.endElement();
+		}
+		writer.endElement();
+	}
+
+	/** Row Categories */
+	if ( !_snapshot.rowCategories.empty() ) {
+		writer.startElement("QuizRowCategories");
+		for ( size_t i = 0; i < _snapshot.rowCategories.size(); ++i ) {
+			writer.writeElement("RowCategory", _snapshot.rowCategories[i]);
+		}
+		writer.endElement();
+	}
+
+	/** Save Quiz */
+	writer.endElement();
+	writer.close();
+}
+
+void MusicQuiz::util::QuizSaveTask::writeCheatSheet(const std::string& path) const
+{
+	std::ofstream cheatSheet(path);
+	if ( !cheatSheet.is_open() ) {
+		LOG_WARN("Failed to write the cheat sheet '" << path << "'.");
+		return;
+	}
+
+	cheatSheet << "--------------   CHEATSHEET   --------------\n"
+		<< "Quiz: " << _snapshot.quizName << "\n"
+		<< "Guess the Category: " << (_snapshot.guessTheCategory ? "Enabled" : "Disabled");
+
+	for ( size_t i = 0; i < _snapshot.categories.size(); ++i ) {
+		const QuizSnapshot::Category& category = _snapshot.categories[i];
+		cheatSheet << "\n\n-----  " << category.name << "  -----";
+		for ( size_t j = 0; j < category.entries.size(); ++j ) {
+			cheatSheet << "\n#" << j + 1 << " - " << category.entries[j].points << " - " << category.entries[j].name;
+		}
+	}
+	cheatSheet.flush();
+	cheatSheet.close();
+}
+
+std::string MusicQuiz::util::QuizSaveTask::getMediaFileName(const QuizSnapshot::Entry& entry, const std::string& suffix, const std::string& source)
+{
+	return entry.name + suffix + boost::filesystem::path(source).extension().string();
+}
\ No newline at end of file
@@ -0,0 +1,315 @@
+#pragma once
+
+#include <map>
+#include <mutex>
+#include <atomic>
+#include <chrono>
+#include <string>
+#include <thread>
+#include <vector>
+#include <memory>
+#include <cstdint>
+
+#include <boost/filesystem.hpp>
+
+#include "util/FileCopier.hpp"
+#include "util/MediaStore.hpp"
+#include "util/QuizSnapshot.hpp"
+
+
+namespace MusicQuiz {
+	namespace util {
+		/**
+		 * @brief Saves a quiz on a worker thread.
+		 *
+		 * The new media folder is built next to the current one. The media files that have to be copied are copied into it and synced to disk, after
+		 * which the files that are up to date and those of renamed entries are linked into it from the current media folder. The quiz file is then
+		 * written to a temporary file, and it and the new media folder are synced to disk. Renaming it to <quiz>.quiz.xml.new commits the save, after which the media folders are swapped and the
+		 * quiz file is moved into place. A save that is interrupted before the commit leaves the quiz untouched, one that is interrupted after it is
+		 * finished by recover(). The progress and state are polled from the GUI thread, no callbacks are made on the worker thread. Cancelling is
+		 * possible until the media is linked, the quiz on disk is then left untouched.
+		 */
+		class QuizSaveTask
+		{
+		public:
+			enum class State
+			{
+				RUNNING, FINISHED, FAILED, CANCELLED
+			};
+
+			enum class Mode
+			{
+				/** Copies every media file */
+				FULL,
+
+				/** Only copies the media files that are not already in the media folder of the quiz */
+				INCREMENTAL
+			};
+
+			struct Options
+			{
+				Mode mode = Mode::INCREMENTAL;
+
+				/** Compares the content of a source file with the file in the media folder, instead of the modification time */
+				bool compareContent = false;
+
+				/** Stores the media files in the shared media store instead of the media folder of the quiz */
+				bool useMediaStore = false;
+
+				/** The media store. If set, the references of the quiz are updated also when the store is not used */
+				MusicQuiz::util::MediaStore::Ptr mediaStore = nullptr;
+			};
+
+			struct Progress
+			{
+				/** Media files to copy or add to the media store */
+				size_t filesDone = 0;
+				size_t filesTotal = 0;
+
+				/** Media files already in the media folder, and those moved within it */
+				size_t filesKept = 0;
+				size_t filesMoved = 0;
+
+				/** Media bytes to copy */
+				std::uintmax_t bytesDone = 0;
+				std::uintmax_t bytesTotal = 0;
+
+				/** The file being copied */
+				std::string currentFile = "";
+				std::uintmax_t currentFileDone = 0;
+				std::uintmax_t currentFileSize = 0;
+
+				/** Average copy speed since the copying was started */
+				double bytesPerSecond = 0.0;
+
+				/** The number of files copied with each copy backend */
+				std::map<MusicQuiz::util::FileCopier::Backend, size_t> copyBackends;
+
+				/** True once the media is copied and the quiz is being written. The task can no longer be cancelled */
+				bool committing = false;
+			};
+
+			/**
+			 * @brief Constructor. Starts saving the quiz on a worker thread.
+			 *
+			 * @param[in] snapshot The quiz to save.
+			 * @param[in] dataFolder The folder the quiz folder is created in.
+			 * @param[in] options The save options.
+			 */
+			QuizSaveTask(const MusicQuiz::util::QuizSnapshot& snapshot, const std::string& dataFolder, const Options& options);
+
+			/**
+			 * @brief Destructor. Cancels the task and waits for the worker thread.
+			 */
+			virtual ~QuizSaveTask();
+
+			/**
+			 * @brief Shared Pointer
+			 */
+			typedef std::shared_ptr< QuizSaveTask > Ptr;
+			typedef std::shared_ptr< const QuizSaveTask > CPtr;
+
+			/**
+			 * @brief Deleted the copy and assignment constructor.
+			 */
+			QuizSaveTask(const QuizSaveTask&) = delete;
+			QuizSaveTask& operator=(const QuizSaveTask&) = delete;
+
+			/**
+			 * @brief Requests the task to stop. Ignored once the task is committing.
+			 */
+			void cancel();
+
+			/**
+			 * @brief Blocks until the task is done.
+			 */
+			void wait();
+
+			/**
+			 * @brief Returns the state of the task.
+			 *
+			 * @return The state.
+			 */
+			State getState() const;
+
+			/**
+			 * @brief Returns the progress of the task.
+			 *
+			 * @return The progress.
+			 */
+			Progress getProgress() const;
+
+			/**
+			 * @brief Returns the path of the quiz file.
+			 *
+			 * @return The path of the quiz file.
+			 */
+			const std::string& getQuizFile() const;
+
+			/**
+			 * @brief Returns the reason the task failed.
+			 *
+			 * @return The error message.
+			 */
+			std::string getError() const;
+
+			/**
+			 * @brief Finishes a save of a quiz that was interrupted after it was committed.
+			 *        Called before a save starts and by the quiz loader when the catalog is refreshed, not when a quiz is loaded.
+			 *
+			 * @param[in] quizFile The path of the quiz file.
+			 *
+			 * @return True if an interrupted save was finished.
+			 */
+			static bool recover(const std::string& quizFile);
+
+		protected:
+			enum class Action
+			{
+				/** The file in the media folder is up to date and is linked into the new media folder */
+				KEEP,
+
+				/** The source is copied */
+				COPY,
+
+				/** The source is in the media folder and is linked into the new media folder under its new name */
+				MOVE,
+
+				/** The source is added to the media store */
+				STORE
+			};
+
+			struct MediaFile
+			{
+				std::string source = "";
+
+				/** Path relative to the media folder */
+				std::string destination = "";
+				std::uintmax_t size = 0;
+
+				Action action = Action::COPY;
+
+				/** The path written to the quiz file */
+				std::string path = "";
+				bool stored = false;
+
+				/** The path of the file in the new media folder */
+				std::string staged = "";
+			};
+
+			/**
+			 * @brief Saves the quiz. Called on the worker thread.
+			 */
+			void run();
+
+			/**
+			 * @brief Lists the media files of the quiz and decides how each of them gets into the media folder.
+			 *
+			 * @param[in] mediaFolder The media folder of the quiz.
+			 * @param[in] stagingFolder The new media folder.
+			 *
+			 * @return The media files.
+			 */
+			std::vector<MediaFile> planMedia(const std::string& mediaFolder, const std::string& stagingFolder) const;
+
+			/**
+			 * @brief Copies the media files into the new media folder and adds the files to store to the media store.
+			 *
+			 * @param[in,out] mediaFiles The media files. The paths of stored files are set.
+			 *
+			 * @return False if the task was cancelled.
+			 */
+			bool copyMedia(std::vector<MediaFile>& mediaFiles);
+
+			/**
+			 * @brief Links the kept and moved media files into the new media folder. Files that can not be linked are copied.
+			 *
+			 * @param[in] mediaFiles The media files.
+			 * @param[in] mediaFolder The media folder of the quiz.
+			 */
+			void linkMedia(const std::vector<MediaFile>& mediaFiles, const std::string& mediaFolder) const;
+
+			/**
+			 * @brief Copies a file with the fastest backend available, reporting the progress after each chunk. The modification time of the source is kept.
+			 *
+			 * @param[in] source The file to copy.
+			 * @param[in] destination The file to write.
+			 *
+			 * @return False if the task was cancelled.
+			 */
+			bool copyFile(const std::string& source, const std::string& destination);
+
+			/**
+			 * @brief Checks if a file in the media folder is the same as its source.
+			 *
+			 * @param[in] source The source file.
+			 * @param[in] destination The file in the media folder.
+			 *
+			 * @return True if the files have the same size, and the same modification time or content.
+			 */
+			bool isSameFile(const boost::filesystem::path& source, const boost::filesystem::path& destination) const;
+
+			/**
+			 * @brief Writes the quiz file and syncs it to disk.
+			 *
+			 * @param[in] mediaFiles The media files.
+			 * @param[in] path The file to write.
+			 */
+			void writeQuizFile(const std::vector<MediaFile>& mediaFiles, const std::string& path) const;
+
+			/**
+			 * @brief Swaps in the new media folder and moves the committed quiz file into place.
+			 *
+			 * @param[in] quizFile The path of the quiz file.
+			 */
+			static void finishSave(const std::string& quizFile);
+
+			/**
+			 * @brief Writes the cheat sheet of the quiz.
+			 *
+			 * @param[in] path The path of the cheat sheet.
+			 */
+			void writeCheatSheet(const std::string& path) const;
+
+			/**
+			 * @brief Returns the file name of a media file in the media folder of the quiz.
+			 *
+			 * @param[in] entry The entry the file belongs to.
+			 * @param[in] suffix Appended to the entry name, e.g. "_video".
+			 * @param[in] source The source file, its extension is kept.
+			 *
+			 * @return The file name.
+			 */
+			static std::string getMediaFileName(const MusicQuiz::util::QuizSnapshot::Entry& entry, const std::string& suffix, const std::string& source);
+
+			/** Variables */
+			const MusicQuiz::util::QuizSnapshot _snapshot;
+			const Options _options;
+			const std::string _quizFolder;
+			const std::string _quizFile;
+
+			std::atomic<State> _state;
+			std::atomic<bool> _cancelled;
+			std::atomic<bool> _committing;
+			std::atomic<size_t> _filesDone;
+			std::atomic<size_t> _filesTotal;
+			std::atomic<size_t> _filesKept;
+			std::atomic<size_t> _filesMoved;
+			std::atomic<std::uintmax_t> _bytesDone;
+			std::atomic<std::uintmax_t> _bytesTotal;
+			std::atomic<std::uintmax_t> _currentFileDone;
+			std::atomic<std::uintmax_t> _currentFileSize;
+
+			mutable std::mutex _mutex;
+			std::string _currentFile = "";
+			std::map<MusicQuiz::util::FileCopier::Backend, size_t> _copyBackends;
+
+			/** The time the copying started and ended. The end is unset while copying */
+			std::chrono::steady_clock::time_point _copyStartTime;
+			std::chrono::steady_clock::time_point _copyEndTime;
+			std::string _error = "";
+
+			std::thread _thread;
+		};
+	}
+}
\ No newline at end of file
@@ -0,0 +1,348 @@
+#include "QuizSearchIndex.hpp"
+
+#include <cctype>
+#include <algorithm>
+#include <stdexcept>
+#include <unordered_set>
+
+#include "common/Log.hpp"
+
+
+namespace {
+	/** Weight of a match per field, in the order of QuizSearchIndex::Field */
+	const float FIELD_WEIGHTS[] = { 8.0f, 4.0f, 3.0f, 2.0f, 1.0f };
+	const size_t NUMBER_OF_FIELDS = sizeof(FIELD_WEIGHTS) / sizeof(FIELD_WEIGHTS[0]);
+
+	/**
+	 * @brief Returns the weight of a set of fields, which is the weight of the best field.
+	 *
+	 * @param[in] fields Bit per field.
+	 *
+	 * @return The weight.
+	 */
+	float getFieldWeight(const std::uint8_t fields)
+	{
+		static const std::vector<float> weights = []() {
+			std::vector<float> table(256, 0.0f);
+			for ( size_t i = 0; i < table.size(); ++i ) {
+				for ( size_t field = 0; field < NUMBER_OF_FIELDS; ++field ) {
+					if ( (i & (static_cast<size_t>(1) << field)) != 0 ) {
+						table[i] = FIELD_WEIGHTS[field];
+						break;
+					}
+				}
+			}
+			return table;
+		}();
+		return weights[fields];
+	}
+
+	/** Quality of a match between a search word and an indexed word */
+	const float EXACT_MATCH = 1.0f;
+	const float PREFIX_MATCH = 0.5f;
+	const float FUZZY_MATCH = 0.4f;
+
+	/** Words shorter than this are not matched with typos */
+	const size_t MIN_FUZZY_LENGTH = 4;
+	const size_t MIN_FUZZY_LENGTH_TWO_TYPOS = 8;
+
+	/**
+	 * @brief Returns the file name of a quiz without the extension.
+	 *
+	 * @param[in] path The path of the quiz file.
+	 *
+	 * @return The file name.
+	 */
+	std::string getFileStem(const std::string& path)
+	{
+		std::string name = path.substr(path.find_last_of("\\/") + 1);
+		const size_t extension = name.find(".quiz.");
+		return extension == std::string::npos ? name : name.substr(0, extension);
+	}
+}
+
+
+size_t MusicQuiz::util::QuizSearchIndex::update(const QuizCatalog& catalog, const DocumentReader& reader, const ProgressCallback& progress)
+{
+	std::lock_guard<std::mutex> updateLock(_updateMutex);
+
+	/** Compare the catalog with the indexed file versions */
+	std::vector<QuizCatalog::Entry> changed;
+	std::vector<std::uint32_t> removed;
+	{
+		std::lock_guard<std::mutex> lock(_mutex);
+		std::unordered_set<QuizId> present;
+		const std::vector<std::string> quizList = catalog.getQuizList();
+		for ( size_t i = 0; i < quizList.size(); ++i ) {
+			const QuizId quizId = QuizCatalog::getQuizId(quizList[i]);
+			QuizCatalog::Entry entry;
+			try {
+				entry = catalog.getEntry(quizId);
+			} catch ( const std::exception& ) {
+				continue;
+			}
+			present.insert(quizId);
+
+			const std::unordered_map<QuizId, std::uint32_t>::const_iterator it = _documentIds.find(quizId);
+			if ( it != _documentIds.end() ) {
+				const Document& document = _documents[it->second];
+				if ( document.lastWriteTime == entry.lastWriteTime && document.fileSize == entry.fileSize ) {
+					continue;
+				}
+				removed.push_back(it->second);
+			}
+			changed.push_back(std::move(entry));
+		}
+
+		for ( std::unordered_map<QuizId, std::uint32_t>::const_iterator it = _documentIds.begin(); it != _documentIds.end(); ++it ) {
+			if ( present.count(it->first) == 0 ) {
+				removed.push_back(it->second);
+			}
+		}
+
+		if ( changed.empty() && removed.empty() ) {
+			return 0;
+		}
+	}
+
+	/** Read the changed quizzes without blocking searches */
+	std::vector<QuizDocument::CPtr> documents(changed.size());
+	for ( size_t i = 0; i < changed.size(); ++i ) {
+		if ( progress && !progress(i, changed.size()) ) {
+			return 0;
+		}
+
+		try {
+			documents[i] = changed[i].document != nullptr ? changed[i].document : reader(changed[i].path);
+		} catch ( const std::exception& err ) {
+			LOG_WARN("Failed to index quiz '" << changed[i].path << "'. " << err.what());
+		}
+	}
+
+	/** Replace the changed quizzes */
+	std::lock_guard<std::mutex> lock(_mutex);
+	for ( size_t i = 0; i < removed.size(); ++i ) {
+		remove(removed[i]);
+	}
+	for ( size_t i = 0; i < changed.size(); ++i ) {
+		add(changed[i], documents[i].get());
+	}
+
+	return changed.size();
+}
+
+std::vector<MusicQuiz::util::QuizSearchIndex::Result> MusicQuiz::util::QuizSearchIndex::search(const std::string& text, const size_t limit) const
+{
+	const std::vector<std::string> words = tokenize(text);
+	if ( words.empty() ) {
+		return {};
+	}
+
+	std::lock_guard<std::mutex> lock(_mutex);
+
+	/** Score per quiz and the number of search words it matched */
+	std::vector<float> totalScores(_documents.size(), 0.0f);
+	std::vector<size_t> matches(_documents.size(), 0);
+	std::vector<float> scores(_documents.size());
+	for ( size_t i = 0; i < words.size(); ++i ) {
+		const std::string& word = words[i];
+		std::fill(scores.begin(), scores.end(), 0.0f);
+
+		/** Exact and Prefix */
+		std::map< std::string, std::vector<Posting> >::const_iterator it = _postings.lower_bound(word);
+		for ( ; it != _postings.end() && it->first.compare(0, word.size(), word) == 0; ++it ) {
+			if ( it->first.size() == word.size() ) {
+				score(it->second, EXACT_MATCH, scores);
+			} else {
+				score(it->second, PREFIX_MATCH * (1.0f + static_cast<float>(word.size()) / static_cast<float>(it->first.size())), scores);
+			}
+		}
+
+		/** Typos, words starting with another letter are not considered */
+		if ( word.size() >= MIN_FUZZY_LENGTH ) {
+			const size_t maxDistance = word.size() >= MIN_FUZZY_LENGTH_TWO_TYPOS ? 2 : 1;
+			it = _postings.lower_bound(word.substr(0, 1));
+			for ( ; it != _postings.end() && it->first[0] == word[0]; ++it ) {
+				const size_t lengthDifference = it->first.size() > word.size() ? it->first.size() - word.size() : word.size() - it->first.size();
+				if ( lengthDifference <= maxDistance && isWithinDistance(word, it->first, maxDistance) ) {
+					score(it->second, FUZZY_MATCH, scores);
+				}
+			}
+		}
+
+		for ( size_t j = 0; j < scores.size(); ++j ) {
+			if ( scores[j] > 0.0f ) {
+				totalScores[j] += scores[j];
+				++matches[j];
+			}
+		}
+	}
+
+	/** Results, quizzes have to match all words. Ties keep the order the quizzes were indexed in */
+	std::vector< std::pair<float, std::uint32_t> > ranking;
+	for ( size_t i = 0; i < _documents.size(); ++i ) {
+		if ( _documents[i].live && matches[i] == words.size() ) {
+			ranking.push_back(std::make_pair(-totalScores[i], static_cast<std::uint32_t>(i)));
+		}
+	}
+
+	const size_t numberOfResults = std::min(limit, ranking.size());
+	std::partial_sort(ranking.begin(), ranking.begin() + numberOfResults, ranking.end());
+
+	std::vector<Result> results(numberOfResults);
+	for ( size_t i = 0; i < numberOfResults; ++i ) {
+		const Document& document = _documents[ranking[i].second];
+		results[i].id = document.id;
+		results[i].path = document.path;
+		results[i].score = -ranking[i].first;
+	}
+
+	return results;
+}
+
+size_t MusicQuiz::util::QuizSearchIndex::size() const
+{
+	std::lock_guard<std::mutex> lock(_mutex);
+	return _documentIds.size();
+}
+
+std::vector<std::string> MusicQuiz::util::QuizSearchIndex::tokenize(const std::string_view text)
+{
+	std::vector<std::string> words;
+	std::string word;
+	for ( size_t i = 0; i <= text.size(); ++i ) {
+		const unsigned char c = i < text.size() ? static_cast<unsigned char>(text[i]) : ' ';
+		if ( std::isalnum(c) || c >= 0x80 ) {
+			word += static_cast<char>(std::tolower(c));
+		} else if ( !word.empty() ) {
+			words.push_back(word);
+			word.clear();
+		}
+	}
+	return words;
+}
+
+bool MusicQuiz::util::QuizSearchIndex::isWithinDistance(const std::string_view lhs, const std::string_view rhs, const size_t maxDistance)
+{
+	/** Edit distance counting swapped neighbours as one edit, stopped as soon as a row exceeds the limit */
+	std::vector<size_t> beforePrevious(rhs.size() + 1), previous(rhs.size() + 1), current(rhs.size() + 1);
+	for ( size_t j = 0; j <= rhs.size(); ++j ) {
+		previous[j] = j;
+	}
+
+	for ( size_t i = 1; i <= lhs.size(); ++i ) {
+		current[0] = i;
+		size_t rowMin = current[0];
+		for ( size_t j = 1; j <= rhs.size(); ++j ) {
+			const size_t substitution = previous[j - 1] + (lhs[i - 1] == rhs[j - 1] ? 0 : 1);
+			current[j] = std::min(std::min(previous[j] + 1, current[j - 1] + 1), substitution);
+			if ( i > 1 && j > 1 && lhs[i - 1] == rhs[j - 2] && lhs[i - 2] == rhs[j - 1] ) {
+				current[j] = std::min(current[j], beforePrevious[j - 2] + 1);
+			}
+			rowMin = std::min(rowMin, current[j]);
+		}
+		if ( rowMin > maxDistance ) {
+			return false;
+		}
+		std::swap(beforePrevious, previous);
+		std::swap(previous, current);
+	}
+
+	return previous[rhs.size()] <= maxDistance;
+}
+
+void MusicQuiz::util::QuizSearchIndex::add(const QuizCatalog::Entry& entry, const QuizDocument* document)
+{
+	/** Reuse the slot of a removed quiz */
+	std::uint32_t doc = 0;
+	if ( !_freeDocuments.empty() ) {
+		doc = _freeDocuments.back();
+		_freeDocuments.pop_back();
+	} else {
+		doc = static_cast<std::uint32_t>(_documents.size());
+		_documents.emplace_back();
+	}
+
+	Document& indexed = _documents[doc];
+	indexed.id = entry.id;
+	indexed.path = entry.path;
+	indexed.lastWriteTime = entry.lastWriteTime;
+	indexed.fileSize = entry.fileSize;
+	indexed.live = true;
+	indexed.terms.clear();
+	_documentIds[entry.id] = doc;
+
+	/** Collect the words with the fields they occur in */
+	std::unordered_map<std::string, std::uint8_t> terms;
+	const auto addText = [&terms](const std::string_view text, const Field field) {
+		const std::vector<std::string> words = tokenize(text);
+		for ( size_t i = 0; i < words.size(); ++i ) {
+			terms[words[i]] |= static_cast<std::uint8_t>(1 << static_cast<int>(field));
+		}
+	};
+
+	addText(getFileStem(entry.path), Field::NAME);
+	if ( document != nullptr ) {
+		addText(document->quizName, Field::NAME);
+		addText(document->quizAuthor, Field::AUTHOR);
+		addText(document->quizDescription, Field::DESCRIPTION);
+		for ( size_t i = 0; i < document->categories.size(); ++i ) {
+			const QuizDocument::Category& category = document->categories[i];
+			addText(category.name, Field::CATEGORY);
+			for ( size_t j = 0; j < category.entries.size(); ++j ) {
+				addText(category.entries[j].answer, Field::ANSWER);
+			}
+		}
+	}
+
+	/** Postings are kept sorted by document number */
+	for ( std::unordered_map<std::string, std::uint8_t>::const_iterator it = terms.begin(); it != terms.end(); ++it ) {
+		Posting posting;
+		posting.doc = doc;
+		posting.fields = it->second;
+
+		std::vector<Posting>& postings = _postings[it->first];
+		const std::vector<Posting>::iterator position = std::lower_bound(postings.begin(), postings.end(), posting, [](const Posting& lhs, const Posting& rhs) {
+			return lhs.doc < rhs.doc;
+		});
+		postings.insert(position, posting);
+		indexed.terms.push_back(it->first);
+	}
+}
+
+void MusicQuiz::util::QuizSearchIndex::remove(const std::uint32_t doc)
+{
+	Document& indexed = _documents[doc];
+	if ( !indexed.live ) {
+		return;
+	}
+
+	for ( size_t i = 0; i < indexed.terms.size(); ++i ) {
+		const std::map< std::string, std::vector<Posting> >::iterator it = _postings.find(indexed.terms[i]);
+		if ( it == _postings.end() ) {
+			continue;
+		}
+
+		std::vector<Posting>& postings = it->second;
+		postings.erase(std::remove_if(postings.begin(), postings.end(), [doc](const Posting& posting) {
+			return posting.doc == doc;
+		}), postings.end());
+		if ( postings.empty() ) {
+			_postings.erase(it);
+		}
+	}
+
+	_documentIds.erase(indexed.id);
+	indexed.live = false;
+	indexed.terms.clear();
+	indexed.path.clear();
+	_freeDocuments.push_back(doc);
+}
+
+void MusicQuiz::util::QuizSearchIndex::score(const std::vector<Posting>& postings, const float quality, std::vector<float>& scores)
+{
+	for ( size_t i = 0; i < postings.size(); ++i ) {
+		float& best = scores[postings[i].doc];
+		best = std::max(best, getFieldWeight(postings[i].fields) * quality);
+	}
+}
\ No newline at end of file
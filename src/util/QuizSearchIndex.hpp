@@ -0,0 +1,184 @@
+#pragma once
+
+#include <map>
+#include <ctime>
+#include <mutex>
+#include <string>
+#include <vector>
+#include <memory>
+#include <cstdint>
+#include <functional>
+#include <string_view>
+#include <unordered_map>
+
+#include "util/QuizId.hpp"
+#include "util/QuizCatalog.hpp"
+#include "util/QuizDocument.hpp"
+
+
+namespace MusicQuiz {
+	namespace util {
+		/**
+		 * @brief Inverted index for searching the quizzes in the catalog.
+		 *
+		 * The quiz name, author, description, category names and answers are split into lower case words, and each word
+		 * maps to the quizzes containing it. Words are matched exactly, by prefix, and with one or two typos for longer words.
+		 * The index is updated from the catalog, and only the quizzes that changed since the last update are read again.
+		 */
+		class QuizSearchIndex
+		{
+		public:
+			/**
+			 * @brief Reads the document of a quiz file.
+			 */
+			typedef std::function<MusicQuiz::util::QuizDocument::CPtr(const std::string& path)> DocumentReader;
+
+			/**
+			 * @brief Called with the number of quizzes read and the number of quizzes to read. Returning false cancels the update.
+			 */
+			typedef std::function<bool(size_t done, size_t total)> ProgressCallback;
+
+			/**
+			 * @brief The fields of a quiz, a match in a field listed first ranks higher.
+			 */
+			enum class Field
+			{
+				NAME = 0, CATEGORY = 1, AUTHOR = 2, ANSWER = 3, DESCRIPTION = 4
+			};
+
+			struct Result
+			{
+				MusicQuiz::util::QuizId id = 0;
+				std::string path = "";
+				float score = 0.0f;
+			};
+
+			/**
+			 * @brief Default constructor
+			 */
+			QuizSearchIndex() = default;
+
+			/**
+			 * @brief Default destructor
+			 */
+			virtual ~QuizSearchIndex() = default;
+
+			/**
+			 * @brief Shared Pointer
+			 */
+			typedef std::shared_ptr< QuizSearchIndex > Ptr;
+			typedef std::shared_ptr< const QuizSearchIndex > CPtr;
+
+			/**
+			 * @brief Deleted the copy and assignment constructor.
+			 */
+			QuizSearchIndex(const QuizSearchIndex&) = delete;
+			QuizSearchIndex& operator=(const QuizSearchIndex&) = delete;
+
+			/**
+			 * @brief Brings the index up to date with the catalog. Quizzes that were added or changed are read,
+			 *        removed quizzes are dropped.
+			 *
+			 * @param[in] catalog The quiz catalog.
+			 * @param[in] reader Reads the quiz documents.
+			 * @param[in] progress Called before each quiz is read. A cancelled update leaves the index unchanged.
+			 *
+			 * @return The number of quizzes that were read.
+			 */
+			size_t update(const MusicQuiz::util::QuizCatalog& catalog, const DocumentReader& reader, const ProgressCallback& progress = nullptr);
+
+			/**
+			 * @brief Searches the quizzes. Every word of the text has to match, the last word may be incomplete.
+			 *
+			 * @param[in] text The search text.
+			 * @param[in] limit The maximum number of results.
+			 *
+			 * @return The matching quizzes, best match first.
+			 */
+			std::vector<Result> search(const std::string& text, size_t limit = SIZE_MAX) const;
+
+			/**
+			 * @brief Returns the number of quizzes in the index.
+			 *
+			 * @return The number of quizzes.
+			 */
+			size_t size() const;
+
+			/**
+			 * @brief Splits a text into lower case words. Bytes outside of ASCII are kept as part of the words.
+			 *
+			 * @param[in] text The text.
+			 *
+			 * @return The words.
+			 */
+			static std::vector<std::string> tokenize(std::string_view text);
+
+			/**
+			 * @brief Checks if the edit distance between two words is at most a limit.
+			 *
+			 * @param[in] lhs The first word.
+			 * @param[in] rhs The second word.
+			 * @param[in] maxDistance The maximum edit distance.
+			 *
+			 * @return True if the words are within the distance.
+			 */
+			static bool isWithinDistance(std::string_view lhs, std::string_view rhs, size_t maxDistance);
+
+		protected:
+			struct Posting
+			{
+				std::uint32_t doc = 0;
+
+				/** Bit per Field */
+				std::uint8_t fields = 0;
+			};
+
+			struct Document
+			{
+				MusicQuiz::util::QuizId id = 0;
+				std::string path = "";
+				std::time_t lastWriteTime = 0;
+				std::uintmax_t fileSize = 0;
+				bool live = false;
+
+				/** The words of the quiz, used to remove it from the postings */
+				std::vector<std::string> terms;
+			};
+
+			/**
+			 * @brief Adds a quiz to the index. Must be called with the mutex locked.
+			 *
+			 * @param[in] entry The catalog entry of the quiz.
+			 * @param[in] document The quiz document. If nullptr only the file name is indexed.
+			 */
+			void add(const MusicQuiz::util::QuizCatalog::Entry& entry, const MusicQuiz::util::QuizDocument* document);
+
+			/**
+			 * @brief Removes a quiz from the index. Must be called with the mutex locked.
+			 *
+			 * @param[in] doc The document number of the quiz.
+			 */
+			void remove(std::uint32_t doc);
+
+			/**
+			 * @brief Adds the score of a word to the quizzes it occurs in.
+			 *
+			 * @param[in] postings The postings of the word.
+			 * @param[in] quality The quality of the match between the search word and the word.
+			 * @param[in,out] scores The scores per quiz. The best match of the search word counts.
+			 */
+			static void score(const std::vector<Posting>& postings, float quality, std::vector<float>& scores);
+
+			/** Variables */
+			std::vector<Document> _documents;
+			std::vector<std::uint32_t> _freeDocuments;
+			std::unordered_map<MusicQuiz::util::QuizId, std::uint32_t> _documentIds;
+
+			/** Word to the quizzes containing it, ordered such that prefixes are a range */
+			std::map< std::string, std::vector<Posting> > _postings;
+
+			mutable std::mutex _mutex;
+			std::mutex _updateMutex;
+		};
+	}
+}
\ No newline at end of file
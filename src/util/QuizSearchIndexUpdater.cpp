@@ -0,0 +1,100 @@
+#include "QuizSearchIndexUpdater.hpp"
+
+#include <chrono>
+#include <string>
+#include <unordered_map>
+
+#include <QMetaObject>
+
+#include "common/Log.hpp"
+
+
+MusicQuiz::util::QuizSearchIndexUpdater::QuizSearchIndexUpdater(const MusicQuiz::util::QuizSearchIndex::Ptr& index, const MusicQuiz::util::EntryIndex::Ptr& entryIndex,
+	const MusicQuiz::util::QuizCatalog::Ptr& catalog, const MusicQuiz::util::QuizSearchIndex::DocumentReader& reader, QObject* parent) :
+	QObject(parent), _index(index), _entryIndex(entryIndex), _catalog(catalog), _reader(reader), _cancelled(false)
+{
+	update();
+}
+
+MusicQuiz::util::QuizSearchIndexUpdater::~QuizSearchIndexUpdater()
+{
+	/** The update stops before the next quiz is read */
+	_cancelled = true;
+	if ( _thread.joinable() ) {
+		_thread.join();
+	}
+}
+
+bool MusicQuiz::util::QuizSearchIndexUpdater::isUpdating() const
+{
+	return _updating;
+}
+
+void MusicQuiz::util::QuizSearchIndexUpdater::update()
+{
+	if ( _updating ) {
+		_pending = true;
+		return;
+	}
+
+	_updating = true;
+	_thread = std::thread(&QuizSearchIndexUpdater::run, this);
+}
+
+void MusicQuiz::util::QuizSearchIndexUpdater::updateFinished()
+{
+	if ( _thread.joinable() ) {
+		_thread.join();
+	}
+	_updating = false;
+
+	emit updated();
+
+	if ( _pending ) {
+		_pending = false;
+		update();
+	}
+}
+
+void MusicQuiz::util::QuizSearchIndexUpdater::run()
+{
+	/** The documents read for the search index are kept for the entry index, so a changed quiz is read once */
+	std::unordered_map<std::string, QuizDocument::CPtr> documents;
+	const QuizSearchIndex::DocumentReader reader = [this, &documents](const std::string& path) {
+		const std::unordered_map<std::string, QuizDocument::CPtr>::const_iterator it = documents.find(path);
+		if ( it != documents.end() ) {
+			return it->second;
+		}
+
+		const QuizDocument::CPtr document = _reader(path);
+		documents.emplace(path, document);
+		return document;
+	};
+	const QuizSearchIndex::ProgressCallback progress = [this](const size_t, const size_t) {
+		return !_cancelled;
+	};
+
+	std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+	try {
+		const size_t numberOfQuizzes = _index->update(*_catalog, reader, progress);
+		if ( numberOfQuizzes > 0 ) {
+			LOG_INFO("Indexed " << numberOfQuizzes << " quizzes for search in " << std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start).count() << " ms.");
+		}
+	} catch ( const std::exception& err ) {
+		LOG_ERROR("Failed to update the search index. " << err.what());
+	}
+
+	start = std::chrono::steady_clock::now();
+	try {
+		const size_t numberOfQuizzes = _entryIndex->update(*_catalog, reader, progress);
+		if ( numberOfQuizzes > 0 ) {
+			LOG_INFO("Indexed " << numberOfQuizzes << " quizzes, " << _entryIndex->size() << " entries in total, in "
+				<< std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start).count() << " ms.");
+		}
+	} catch ( const std::exception& err ) {
+		LOG_ERROR("Failed to update the entry index. " << err.what());
+	}
+
+	/** Report back on the GUI thread */
+	QMetaObject::invokeMethod(this, "updateFinished", Qt::QueuedConnection);
+}
\ No newline at end of file
@@ -0,0 +1,90 @@
+#pragma once
+
+#include <atomic>
+#include <thread>
+
+#include <QObject>
+
+#include "util/EntryIndex.hpp"
+#include "util/QuizCatalog.hpp"
+#include "util/QuizSearchIndex.hpp"
+
+
+namespace MusicQuiz {
+	namespace util {
+		/**
+		 * @brief Brings the quiz search index and the entry index up to date with the catalog on a worker thread.
+		 *
+		 * Reading every quiz takes seconds for a large library, so searching and querying entries must not wait for it. Updates are started
+		 * when the updater is created and whenever the library watcher applied a batch of changes. Each changed quiz is read once for both indices.
+		 * The updated signal is emitted on the GUI thread once the indices match the catalog, searches and queries made before then
+		 * return the quizzes indexed so far.
+		 */
+		class QuizSearchIndexUpdater : public QObject
+		{
+			Q_OBJECT
+		public:
+			/**
+			 * @brief Constructor. Starts the first update.
+			 *
+			 * @param[in] index The search index.
+			 * @param[in] entryIndex The entry index.
+			 * @param[in] catalog The quiz catalog.
+			 * @param[in] reader Reads the quiz documents.
+			 * @param[in] parent The parent object.
+			 */
+			explicit QuizSearchIndexUpdater(const MusicQuiz::util::QuizSearchIndex::Ptr& index, const MusicQuiz::util::EntryIndex::Ptr& entryIndex,
+				const MusicQuiz::util::QuizCatalog::Ptr& catalog, const MusicQuiz::util::QuizSearchIndex::DocumentReader& reader, QObject* parent = nullptr);
+
+			/**
+			 * @brief Destructor. Cancels a running update and waits for it to stop.
+			 */
+			virtual ~QuizSearchIndexUpdater();
+
+			/**
+			 * @brief Deleted the copy and assignment constructor.
+			 */
+			QuizSearchIndexUpdater(const QuizSearchIndexUpdater&) = delete;
+			QuizSearchIndexUpdater& operator=(const QuizSearchIndexUpdater&) = delete;
+
+			/**
+			 * @brief Checks if an update is running.
+			 *
+			 * @return True while the indices are being updated.
+			 */
+			bool isUpdating() const;
+
+		public slots:
+			/**
+			 * @brief Starts an update. If an update is running, another one is started when it is done.
+			 */
+			void update();
+
+		signals:
+			void updated();
+
+		private slots:
+			/**
+			 * @brief Joins the worker thread and starts the pending update. Called on the GUI thread.
+			 */
+			void updateFinished();
+
+		protected:
+			/**
+			 * @brief Updates the indices. Called on the worker thread.
+			 */
+			void run();
+
+			/** Variables */
+			const MusicQuiz::util::QuizSearchIndex::Ptr _index;
+			const MusicQuiz::util::EntryIndex::Ptr _entryIndex;
+			const MusicQuiz::util::QuizCatalog::Ptr _catalog;
+			const MusicQuiz::util::QuizSearchIndex::DocumentReader _reader;
+
+			bool _updating = false;
+			bool _pending = false;
+			std::atomic<bool> _cancelled;
+			std::thread _thread;
+		};
+	}
+}
\ No newline at end of file
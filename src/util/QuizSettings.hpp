@@ -1,6 +1,7 @@
 #pragma once
 
 #include <cstddef>
+#include <cstdint>
 
 namespace MusicQuiz {
 	struct QuizSettings
@@ -15,6 +16,12 @@ namespace MusicQuiz {
 		bool dailyTripleHidden = true;
 		size_t dailyTriplePercentage = 5;
 
+		/** Special Tile Placement */
+		std::uint64_t specialTileSeed = 0; // 0: A new seed for every game
+		bool oneSpecialTilePerCategory = false;
+		bool oneSpecialTilePerRow = false;
+		bool specialTilesInBothHalves = false;
+
 		/** Teams */
 		bool hiddenTeamScore = false;
 
@@ -0,0 +1,52 @@
+#pragma once
+
+#include <string>
+#include <vector>
+
+#include "util/QuizDocument.hpp"
+
+
+namespace MusicQuiz {
+	namespace util {
+		/**
+		 * @brief Plain copy of a quiz being edited in the quiz creator.
+		 *
+		 * The snapshot is taken from the creator widgets on the GUI thread, after which it can be validated and saved on a worker thread.
+		 */
+		struct QuizSnapshot
+		{
+			typedef MusicQuiz::util::QuizDocument::EntryType EntryType;
+
+			struct Entry
+			{
+				std::string name = "";
+				EntryType type = EntryType::Song;
+
+				size_t points = 0;
+				size_t startTime = 0;
+				size_t answerStartTime = 0;
+				size_t videoSongStartTime = 0;
+
+				/** Source media files selected in the creator. Empty if not set */
+				std::string songFile = "";
+				std::string videoFile = "";
+			};
+
+			struct Category
+			{
+				std::string name = "";
+				std::vector<Entry> entries;
+			};
+
+			std::string quizName = "";
+			std::string quizAuthor = "";
+			std::string quizDescription = "";
+
+			bool guessTheCategory = false;
+			size_t guessTheCategoryPoints = 0;
+
+			std::vector<Category> categories;
+			std::vector<std::string> rowCategories;
+		};
+	}
+}
\ No newline at end of file
@@ -0,0 +1,239 @@
+#include "QuizValidator.hpp"
+
+#include <cctype>
+#include <utility>
+#include <algorithm>
+#include <string_view>
+#include <unordered_set>
+#include <unordered_map>
+
+#include "util/MediaValidator.hpp"
+
+
+namespace {
+	/** Extensions of the files the quiz can play, the same as offered by the entry creator */
+	const std::vector<std::string> AUDIO_FORMATS = { ".mp3", ".mp4", ".wav" };
+	const std::vector<std::string> VIDEO_FORMATS = { ".mp4" };
+
+	/** Characters that can not be used in file and folder names on any of the supported platforms */
+	const std::string INVALID_NAME_CHARACTERS = "/\\:*?\"<>|";
+
+	/**
+	 * @brief Returns the position of an issue in the quiz, issues of the quiz itself come first.
+	 *
+	 * @param[in] index The category or entry index of the issue.
+	 *
+	 * @return The sort key.
+	 */
+	size_t getSortKey(const size_t index)
+	{
+		return index == MusicQuiz::util::QuizValidator::NO_INDEX ? 0 : index + 1;
+	}
+}
+
+
+bool MusicQuiz::util::QuizValidator::Report::ok() const
+{
+	return errorCount == 0;
+}
+
+std::string MusicQuiz::util::QuizValidator::Report::toString(const size_t maxIssues) const
+{
+	const size_t count = maxIssues == 0 ? issues.size() : std::min(maxIssues, issues.size());
+
+	std::string msg;
+	for ( size_t i = 0; i < count; ++i ) {
+		msg += issues[i].severity == Severity::ERROR ? "Error: " : "Warning: ";
+		msg += issues[i].message + "\n";
+	}
+
+	if ( count < issues.size() ) {
+		msg += "... and " + std::to_string(issues.size() - count) + " more.\n";
+	}
+	return msg;
+}
+
+MusicQuiz::util::QuizValidator::Report MusicQuiz::util::QuizValidator::validate(const QuizSnapshot& snapshot, const bool checkFiles)
+{
+	const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+
+	Report report;
+	const auto addIssue = [&report](const Severity severity, const Problem problem, const size_t category, const size_t entry, const std::string& message) {
+		Issue issue;
+		issue.severity = severity;
+		issue.problem = problem;
+		issue.category = category;
+		issue.entry = entry;
+		issue.message = message;
+		report.issues.push_back(issue);
+	};
+
+	/** Quiz */
+	if ( snapshot.quizName.empty() ) {
+		addIssue(Severity::ERROR, Problem::MISSING_QUIZ_NAME, NO_INDEX, NO_INDEX, "The quiz name needs to be set.");
+	} else if ( !isValidName(snapshot.quizName) ) {
+		addIssue(Severity::ERROR, Problem::INVALID_NAME, NO_INDEX, NO_INDEX, "The quiz name '" + snapshot.quizName + "' can not be used as a folder name.");
+	}
+
+	if ( snapshot.quizAuthor.empty() ) {
+		addIssue(Severity::ERROR, Problem::MISSING_AUTHOR, NO_INDEX, NO_INDEX, "The author needs to be set.");
+	}
+
+	if ( snapshot.quizDescription.empty() ) {
+		addIssue(Severity::ERROR, Problem::MISSING_DESCRIPTION, NO_INDEX, NO_INDEX, "The description needs to be set.");
+	}
+
+	/** Categories and Entries. Names are only formatted for the issues found */
+	std::unordered_set<std::string_view> categoryNames, entryNames;
+	std::vector<bool> uniqueCategoryNames(snapshot.categories.size(), false);
+	categoryNames.reserve(snapshot.categories.size());
+
+	const auto getLabel = [&snapshot, &uniqueCategoryNames](const size_t category, const size_t entry, const bool uniqueEntryName) {
+		const QuizSnapshot::Category& categoryData = snapshot.categories[category];
+		std::string label = uniqueCategoryNames[category] ? "Category '" + categoryData.name + "'" : "Category #" + std::to_string(category + 1);
+		if ( entry != NO_INDEX ) {
+			label += uniqueEntryName ? ", entry '" + categoryData.entries[entry].name + "'" : ", entry #" + std::to_string(entry + 1);
+		}
+		return label;
+	};
+
+	/** The first entry using each media file, and the files to check on disk */
+	struct MediaUser
+	{
+		size_t category;
+		size_t entry;
+		bool uniqueEntryName;
+	};
+	size_t numberOfEntries = 0;
+	for ( size_t i = 0; i < snapshot.categories.size(); ++i ) {
+		numberOfEntries += snapshot.categories[i].entries.size();
+	}
+
+	std::unordered_map<std::string_view, MediaUser> mediaUsers;
+	std::vector<MediaValidator::MediaFile> files;
+	mediaUsers.reserve(numberOfEntries);
+
+	for ( size_t i = 0; i < snapshot.categories.size(); ++i ) {
+		const QuizSnapshot::Category& category = snapshot.categories[i];
+		if ( category.name.empty() ) {
+			addIssue(Severity::ERROR, Problem::MISSING_CATEGORY_NAME, i, NO_INDEX, getLabel(i, NO_INDEX, false) + " has no name.");
+		} else if ( !categoryNames.insert(category.name).second ) {
+			addIssue(Severity::ERROR, Problem::DUPLICATE_CATEGORY_NAME, i, NO_INDEX, getLabel(i, NO_INDEX, false) + " has the same name as another category, '" + category.name + "'.");
+		} else {
+			uniqueCategoryNames[i] = true;
+			if ( !isValidName(category.name) ) {
+				addIssue(Severity::ERROR, Problem::INVALID_NAME, i, NO_INDEX, getLabel(i, NO_INDEX, false) + " can not be named '" + category.name + "', it is used as a folder name.");
+			}
+		}
+
+		entryNames.clear();
+		entryNames.reserve(category.entries.size());
+		for ( size_t j = 0; j < category.entries.size(); ++j ) {
+			const QuizSnapshot::Entry& entry = category.entries[j];
+			bool uniqueEntryName = false;
+			if ( entry.name.empty() ) {
+				addIssue(Severity::ERROR, Problem::MISSING_ENTRY_NAME, i, j, getLabel(i, j, false) + " has no name.");
+			} else if ( !entryNames.insert(entry.name).second ) {
+				addIssue(Severity::ERROR, Problem::DUPLICATE_ENTRY_NAME, i, j, getLabel(i, j, false) + " has the same name as another entry in the category, '" + entry.name + "'.");
+			} else {
+				uniqueEntryName = true;
+				if ( !isValidName(entry.name) ) {
+					addIssue(Severity::ERROR, Problem::INVALID_NAME, i, j, getLabel(i, j, false) + " can not be named '" + entry.name + "', it is used as a file name.");
+				}
+			}
+
+			/** Media. Video entries have a video and a song file */
+			const bool video = entry.type == QuizSnapshot::EntryType::Video;
+			for ( size_t k = video ? 0 : 1; k < 2; ++k ) {
+				const bool videoFile = k == 0;
+				const std::string& file = videoFile ? entry.videoFile : entry.songFile;
+				const std::string fileLabel = videoFile ? "video file" : "song file";
+				if ( file.empty() ) {
+					addIssue(Severity::WARNING, Problem::MISSING_MEDIA, i, j, getLabel(i, j, uniqueEntryName) + " has no " + fileLabel + ".");
+					continue;
+				}
+
+				if ( !isSupportedFormat(file, videoFile) ) {
+					addIssue(Severity::WARNING, Problem::UNSUPPORTED_FORMAT, i, j, getLabel(i, j, uniqueEntryName) + ": the format of the " + fileLabel + " '" + file + "' is not supported.");
+				}
+
+				/** Each file is checked once. Using a file for both the video and the song of an entry is fine */
+				const MediaUser mediaUser = { i, j, uniqueEntryName };
+				const std::pair< std::unordered_map<std::string_view, MediaUser>::iterator, bool > user = mediaUsers.emplace(file, mediaUser);
+				if ( user.second ) {
+					if ( checkFiles ) {
+						MediaValidator::MediaFile mediaFile;
+						mediaFile.category = i;
+						mediaFile.entry = j;
+						mediaFile.type = videoFile ? MediaValidator::FileType::VIDEO : MediaValidator::FileType::SONG;
+						mediaFile.path = file;
+						files.push_back(mediaFile);
+					}
+				} else if ( user.first->second.category != i || user.first->second.entry != j ) {
+					const MediaUser& other = user.first->second;
+					addIssue(Severity::WARNING, Problem::DUPLICATE_MEDIA, i, j, getLabel(i, j, uniqueEntryName) + " uses the same " + fileLabel + " as "
+						+ getLabel(other.category, other.entry, other.uniqueEntryName) + ".");
+				}
+			}
+		}
+	}
+
+	/** Media Files */
+	if ( checkFiles ) {
+		MediaValidator::check(files);
+		for ( size_t i = 0; i < files.size(); ++i ) {
+			const MediaValidator::MediaFile& file = files[i];
+			if ( file.problem == MediaValidator::Problem::NONE ) {
+				continue;
+			}
+
+			addIssue(Severity::ERROR, Problem::MEDIA_NOT_FOUND, file.category, file.entry, getLabel(file.category, file.entry, mediaUsers.at(file.path).uniqueEntryName) + ": the "
+				+ (file.type == MediaValidator::FileType::VIDEO ? "video" : "song") + " file '" + file.path + "' " + (file.problem == MediaValidator::Problem::MISSING ? "does not exist." : "can not be read."));
+		}
+	}
+
+	/** Order the issues as the quiz */
+	std::stable_sort(report.issues.begin(), report.issues.end(), [](const Issue& lhs, const Issue& rhs) {
+		return std::make_pair(getSortKey(lhs.category), getSortKey(lhs.entry)) < std::make_pair(getSortKey(rhs.category), getSortKey(rhs.entry));
+	});
+
+	for ( size_t i = 0; i < report.issues.size(); ++i ) {
+		if ( report.issues[i].severity == Severity::ERROR ) {
+			++report.errorCount;
+		} else {
+			++report.warningCount;
+		}
+	}
+	report.elapsed = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start);
+
+	return report;
+}
+
+bool MusicQuiz::util::QuizValidator::isValidName(const std::string& name)
+{
+	if ( name.empty() || name == "." || name == ".." || name.back() == ' ' || name.back() == '.' ) {
+		return false;
+	}
+
+	for ( size_t i = 0; i < name.size(); ++i ) {
+		const unsigned char character = static_cast<unsigned char>(name[i]);
+		if ( character < 0x20 || INVALID_NAME_CHARACTERS.find(name[i]) != std::string::npos ) {
+			return false;
+		}
+	}
+	return true;
+}
+
+bool MusicQuiz::util::QuizValidator::isSupportedFormat(const std::string& path, const bool video)
+{
+	const size_t dot = path.find_last_of('.');
+	if ( dot == std::string::npos || path.find_first_of("/\\", dot) != std::string::npos ) {
+		return false;
+	}
+
+	std::string extension = path.substr(dot);
+	std::transform(extension.begin(), extension.end(), extension.begin(), [](const unsigned char c) { return static_cast<char>(std::tolower(c)); });
+
+	const std::vector<std::string>& formats = video ? VIDEO_FORMATS : AUDIO_FORMATS;
+	return std::find(formats.begin(), formats.end(), extension) != formats.end();
+}
\ No newline at end of file
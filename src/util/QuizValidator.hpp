@@ -0,0 +1,113 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include <chrono>
+#include <limits>
+
+#include "util/QuizSnapshot.hpp"
+
+
+namespace MusicQuiz {
+	namespace util {
+		/**
+		 * @brief Checks a quiz before it is saved and reports every problem found.
+		 *
+		 * The names are checked for uniqueness with hash sets in a single pass over the snapshot. The media files that are used
+		 * are collected in the same pass, so each file is checked on disk once no matter how many entries use it.
+		 */
+		class QuizValidator
+		{
+		public:
+			enum class Severity
+			{
+				/** The quiz can not be saved */
+				ERROR,
+
+				/** The quiz can be saved, but is not playable as it is */
+				WARNING
+			};
+
+			enum class Problem
+			{
+				MISSING_QUIZ_NAME, MISSING_AUTHOR, MISSING_DESCRIPTION, INVALID_NAME,
+				MISSING_CATEGORY_NAME, DUPLICATE_CATEGORY_NAME,
+				MISSING_ENTRY_NAME, DUPLICATE_ENTRY_NAME,
+				MISSING_MEDIA, MEDIA_NOT_FOUND, UNSUPPORTED_FORMAT, DUPLICATE_MEDIA
+			};
+
+			/** Index used for issues that do not belong to a category or entry */
+			static constexpr size_t NO_INDEX = std::numeric_limits<size_t>::max();
+
+			struct Issue
+			{
+				Severity severity = Severity::ERROR;
+				Problem problem = Problem::MISSING_QUIZ_NAME;
+				size_t category = NO_INDEX;
+				size_t entry = NO_INDEX;
+				std::string message = "";
+			};
+
+			struct Report
+			{
+				size_t errorCount = 0;
+				size_t warningCount = 0;
+				std::chrono::microseconds elapsed = std::chrono::microseconds(0);
+
+				/** The issues in quiz order */
+				std::vector<Issue> issues;
+
+				/**
+				 * @brief Checks if the quiz can be saved.
+				 *
+				 * @return True if there are no errors.
+				 */
+				bool ok() const;
+
+				/**
+				 * @brief Formats the issues as a message, one line per issue.
+				 *
+				 * @param[in] maxIssues The maximum number of issues listed. Zero lists all issues.
+				 *
+				 * @return The message. Empty if there are no issues.
+				 */
+				std::string toString(size_t maxIssues = 0) const;
+			};
+
+			/**
+			 * @brief Deleted constructor and destructor.
+			 */
+			QuizValidator() = delete;
+			~QuizValidator() = delete;
+
+			/**
+			 * @brief Validates a quiz.
+			 *
+			 * @param[in] snapshot The quiz.
+			 * @param[in] checkFiles Checks that the media files exist and can be read.
+			 *
+			 * @return The validation report.
+			 */
+			static Report validate(const MusicQuiz::util::QuizSnapshot& snapshot, bool checkFiles = true);
+
+			/**
+			 * @brief Checks if a name can be used as a file or folder name.
+			 *
+			 * @param[in] name The name.
+			 *
+			 * @return True if the name is valid.
+			 */
+			static bool isValidName(const std::string& name);
+
+			/**
+			 * @brief Checks if a file has an extension the quiz can play.
+			 *
+			 * @param[in] path The path of the file.
+			 * @param[in] video True for video files, false for audio files.
+			 *
+			 * @return True if the format is supported.
+			 */
+			static bool isSupportedFormat(const std::string& path, bool video);
+		};
+	}
+}
\ No newline at end of file
@@ -0,0 +1,348 @@
+#include "QuizXmlReader.hpp"
+
+#include <cstdint>
+#include <stdexcept>
+
+
+namespace {
+	bool isWhitespace(const char c)
+	{
+		return c == ' ' || c == '\t' || c == '\n' || c == '\r';
+	}
+
+	bool isNameEnd(const char c)
+	{
+		return isWhitespace(c) || c == '/' || c == '>' || c == '=';
+	}
+
+	void appendUtf8(const uint32_t codePoint, std::string& out)
+	{
+		if ( codePoint < 0x80 ) {
+			out += static_cast<char>(codePoint);
+		} else if ( codePoint < 0x800 ) {
+			out += static_cast<char>(0xC0 | (codePoint >> 6));
+			out += static_cast<char>(0x80 | (codePoint & 0x3F));
+		} else if ( codePoint < 0x10000 ) {
+			out += static_cast<char>(0xE0 | (codePoint >> 12));
+			out += static_cast<char>(0x80 | ((codePoint >> 6) & 0x3F));
+			out += static_cast<char>(0x80 | (codePoint & 0x3F));
+		} else {
+			out += static_cast<char>(0xF0 | (codePoint >> 18));
+			out += static_cast<char>(0x80 | ((codePoint >> 12) & 0x3F));
+			out += static_cast<char>(0x80 | ((codePoint >> 6) & 0x3F));
+			out += static_cast<char>(0x80 | (codePoint & 0x3F));
+		}
+	}
+}
+
+
+MusicQuiz::util::QuizXmlReader::QuizXmlReader(const std::string_view buffer) :
+	_buffer(buffer)
+{
+	/** Skip UTF-8 Byte Order Mark */
+	if ( _buffer.substr(0, 3) == "\xEF\xBB\xBF" ) {
+		_pos = 3;
+	}
+}
+
+MusicQuiz::util::QuizXmlReader::Token MusicQuiz::util::QuizXmlReader::next()
+{
+	/** Closing part of a self-closing element */
+	if ( _pendingEnd ) {
+		_pendingEnd = false;
+		--_depth;
+		return Token::END_ELEMENT;
+	}
+
+	while ( _pos < _buffer.size() ) {
+		if ( _buffer[_pos] != '<' ) {
+			/** Text */
+			const size_t end = _buffer.find('<', _pos);
+			const std::string_view raw = _buffer.substr(_pos, end == std::string_view::npos ? std::string_view::npos : end - _pos);
+			_pos += raw.size();
+
+			_text = normalizeText(raw);
+			if ( !_text.empty() && _depth > 0 ) {
+				return Token::TEXT;
+			}
+			continue;
+		}
+
+		const std::string_view rest = _buffer.substr(_pos);
+		if ( rest.compare(0, 4, "<!--") == 0 ) { // Comment
+			skipPast("-->");
+		} else if ( rest.compare(0, 9, "<![CDATA[") == 0 ) { // CDATA
+			const size_t end = _buffer.find("]]>", _pos + 9);
+			if ( end == std::string_view::npos ) {
+				error("Unterminated CDATA section.");
+			}
+			_text = _buffer.substr(_pos + 9, end - _pos - 9);
+			_pos = end + 3;
+			if ( !_text.empty() ) {
+				return Token::TEXT;
+			}
+		} else if ( rest.compare(0, 2, "<?") == 0 ) { // Processing Instruction
+			skipPast("?>");
+		} else if ( rest.compare(0, 2, "<!") == 0 ) { // Doctype
+			skipPast(">");
+		} else { // Element
+			return readTag();
+		}
+	}
+
+	if ( _depth != 0 ) {
+		error("Unexpected end of document.");
+	}
+	return Token::END_OF_DOCUMENT;
+}
+
+void MusicQuiz::util::QuizXmlReader::skipElement()
+{
+	const size_t depth = _depth;
+	while ( _depth >= depth ) {
+		if ( next() == Token::END_OF_DOCUMENT ) {
+			return;
+		}
+	}
+}
+
+std::string_view MusicQuiz::util::QuizXmlReader::getName() const
+{
+	return _name;
+}
+
+std::string_view MusicQuiz::util::QuizXmlReader::getText() const
+{
+	return _text;
+}
+
+bool MusicQuiz::util::QuizXmlReader::getAttribute(const std::string_view name, std::string_view& value) const
+{
+	for ( size_t i = 0; i < _attributes.size(); ++i ) {
+		if ( _attributes[i].first == name ) {
+			value = decodeValue(_attributes[i].second, _attributeBuffer);
+			return true;
+		}
+	}
+	return false;
+}
+
+size_t MusicQuiz::util::QuizXmlReader::getDepth() const
+{
+	return _depth;
+}
+
+size_t MusicQuiz::util::QuizXmlReader::getOffset() const
+{
+	return _pos;
+}
+
+MusicQuiz::util::QuizXmlReader::Token MusicQuiz::util::QuizXmlReader::readTag()
+{
+	/** End Tag */
+	if ( _pos + 1 < _buffer.size() && _buffer[_pos + 1] == '/' ) {
+		_pos += 2;
+		_name = readName();
+		skipWhitespace();
+		if ( _pos >= _buffer.size() || _buffer[_pos] != '>' ) {
+			error("Expected '>' after end tag.");
+		}
+		++_pos;
+
+		if ( _depth == 0 ) {
+			error("Unexpected end tag '" + std::string(_name) + "'.");
+		}
+		--_depth;
+		return Token::END_ELEMENT;
+	}
+
+	/** Start Tag */
+	++_pos;
+	_name = readName();
+	readAttributes();
+	++_depth;
+	return Token::START_ELEMENT;
+}
+
+void MusicQuiz::util::QuizXmlReader::readAttributes()
+{
+	_attributes.clear();
+	while ( true ) {
+		skipWhitespace();
+		if ( _pos >= _buffer.size() ) {
+			error("Unterminated start tag.");
+		}
+
+		/** End of Tag */
+		if ( _buffer[_pos] == '>' ) {
+			++_pos;
+			return;
+		}
+
+		if ( _buffer[_pos] == '/' ) {
+			if ( _pos + 1 >= _buffer.size() || _buffer[_pos + 1] != '>' ) {
+				error("Expected '>' after '/'.");
+			}
+			_pos += 2;
+			_pendingEnd = true;
+			return;
+		}
+
+		/** Attribute */
+		const std::string_view name = readName();
+		skipWhitespace();
+		if ( _pos >= _buffer.size() || _buffer[_pos] != '=' ) {
+			error("Expected '=' after attribute '" + std::string(name) + "'.");
+		}
+		++_pos;
+		skipWhitespace();
+
+		if ( _pos >= _buffer.size() || (_buffer[_pos] != '"' && _buffer[_pos] != '\'') ) {
+			error("Expected quoted value for attribute '" + std::string(name) + "'.");
+		}
+		const char quote = _buffer[_pos];
+		const size_t end = _buffer.find(quote, _pos + 1);
+		if ( end == std::string_view::npos ) {
+			error("Unterminated value for attribute '" + std::string(name) + "'.");
+		}
+
+		_attributes.push_back(std::make_pair(name, _buffer.substr(_pos + 1, end - _pos - 1)));
+		_pos = end + 1;
+	}
+}
+
+std::string_view MusicQuiz::util::QuizXmlReader::readName()
+{
+	const size_t start = _pos;
+	while ( _pos < _buffer.size() && !isNameEnd(_buffer[_pos]) ) {
+		++_pos;
+	}
+
+	if ( _pos == start ) {
+		error("Expected a name.");
+	}
+	return _buffer.substr(start, _pos - start);
+}
+
+void MusicQuiz::util::QuizXmlReader::skipPast(const std::string_view terminator)
+{
+	const size_t end = _buffer.find(terminator, _pos);
+	if ( end == std::string_view::npos ) {
+		error("Expected '" + std::string(terminator) + "'.");
+	}
+	_pos = end + terminator.size();
+}
+
+void MusicQuiz::util::QuizXmlReader::skipWhitespace()
+{
+	while ( _pos < _buffer.size() && isWhitespace(_buffer[_pos]) ) {
+		++_pos;
+	}
+}
+
+std::string_view MusicQuiz::util::QuizXmlReader::normalizeText(std::string_view raw)
+{
+	/** Trim */
+	while ( !raw.empty() && isWhitespace(raw.front()) ) {
+		raw.remove_prefix(1);
+	}
+	while ( !raw.empty() && isWhitespace(raw.back()) ) {
+		raw.remove_suffix(1);
+	}
+
+	/** Check if the text can be used as is */
+	bool needsCopy = false;
+	for ( size_t i = 0; i < raw.size() && !needsCopy; ++i ) {
+		const char c = raw[i];
+		needsCopy = c == '&' || c == '\t' || c == '\n' || c == '\r' || (c == ' ' && raw[i + 1] == ' ');
+	}
+
+	if ( !needsCopy ) {
+		return raw;
+	}
+
+	/** Decode entities and collapse whitespace */
+	_textBuffer.clear();
+	for ( size_t i = 0; i < raw.size(); ) {
+		const char c = raw[i];
+		if ( isWhitespace(c) ) {
+			_textBuffer += ' ';
+			while ( i < raw.size() && isWhitespace(raw[i]) ) {
+				++i;
+			}
+		} else if ( c == '&' ) {
+			i += decodeEntity(raw.substr(i), _textBuffer);
+		} else {
+			_textBuffer += c;
+			++i;
+		}
+	}
+	return _textBuffer;
+}
+
+std::string_view MusicQuiz::util::QuizXmlReader::decodeValue(const std::string_view raw, std::string& decoded)
+{
+	if ( raw.find('&') == std::string_view::npos ) {
+		return raw;
+	}
+
+	decoded.clear();
+	for ( size_t i = 0; i < raw.size(); ) {
+		if ( raw[i] == '&' ) {
+			i += decodeEntity(raw.substr(i), decoded);
+		} else {
+			decoded += raw[i];
+			++i;
+		}
+	}
+	return decoded;
+}
+
+size_t MusicQuiz::util::QuizXmlReader::decodeEntity(const std::string_view raw, std::string& out)
+{
+	const size_t end = raw.find(';');
+	if ( end == std::string_view::npos || end > 10 ) { // Not an entity, keep the '&'
+		out += '&';
+		return 1;
+	}
+
+	const std::string_view entity = raw.substr(1, end - 1);
+	if ( entity == "lt" ) {
+		out += '<';
+	} else if ( entity == "gt" ) {
+		out += '>';
+	} else if ( entity == "amp" ) {
+		out += '&';
+	} else if ( entity == "quot" ) {
+		out += '"';
+	} else if ( entity == "apos" ) {
+		out += '\'';
+	} else if ( entity.size() > 1 && entity[0] == '#' ) { // Character reference
+		const bool hex = entity[1] == 'x' || entity[1] == 'X';
+		uint32_t codePoint = 0;
+		for ( size_t i = hex ? 2 : 1; i < entity.size(); ++i ) {
+			const char c = entity[i];
+			if ( c >= '0' && c <= '9' ) {
+				codePoint = codePoint * (hex ? 16 : 10) + static_cast<uint32_t>(c - '0');
+			} else if ( hex && c >= 'a' && c <= 'f' ) {
+				codePoint = codePoint * 16 + static_cast<uint32_t>(c - 'a' + 10);
+			} else if ( hex && c >= 'A' && c <= 'F' ) {
+				codePoint = codePoint * 16 + static_cast<uint32_t>(c - 'A' + 10);
+			} else { // Malformed, keep the '&'
+				out += '&';
+				return 1;
+			}
+		}
+		appendUtf8(codePoint, out);
+	} else { // Unknown entity, keep the '&'
+		out += '&';
+		return 1;
+	}
+
+	return end + 1;
+}
+
+void MusicQuiz::util::QuizXmlReader::error(const std::string& msg) const
+{
+	throw std::runtime_error("Malformed quiz file at byte " + std::to_string(_pos) + ". " + msg);
+}
\ No newline at end of file
@@ -0,0 +1,180 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include <utility>
+#include <cstddef>
+#include <string_view>
+
+
+namespace MusicQuiz {
+	namespace util {
+		/**
+		 * @brief Pull parser for the XML subset used by the quiz files.
+		 *
+		 * The reader walks a buffer once and hands out views into it. Only text that contains entities
+		 * or has to be whitespace normalized is copied into a scratch buffer owned by the reader.
+		 * Views are valid until the next call to next().
+		 *
+		 * Text is trimmed and whitespace sequences are collapsed, matching boost::property_tree's trim_whitespace.
+		 */
+		class QuizXmlReader
+		{
+		public:
+			enum class Token
+			{
+				START_ELEMENT, END_ELEMENT, TEXT, END_OF_DOCUMENT
+			};
+
+			/**
+			 * @brief Constructor
+			 *
+			 * @param[in] buffer The XML to read. Must outlive the reader.
+			 */
+			explicit QuizXmlReader(std::string_view buffer);
+
+			/**
+			 * @brief Default destructor
+			 */
+			virtual ~QuizXmlReader() = default;
+
+			/**
+			 * @brief Deleted the copy and assignment constructor.
+			 */
+			QuizXmlReader(const QuizXmlReader&) = delete;
+			QuizXmlReader& operator=(const QuizXmlReader&) = delete;
+
+			/**
+			 * @brief Advances to the next token. Self-closing elements are reported as a start and an end element.
+			 *
+			 * @return The token.
+			 */
+			Token next();
+
+			/**
+			 * @brief Skips the rest of the current element including its children. Must be called after START_ELEMENT.
+			 */
+			void skipElement();
+
+			/**
+			 * @brief Returns the element name of the current START_ELEMENT or END_ELEMENT token.
+			 *
+			 * @return The element name.
+			 */
+			std::string_view getName() const;
+
+			/**
+			 * @brief Returns the text of the current TEXT token.
+			 *
+			 * @return The text.
+			 */
+			std::string_view getText() const;
+
+			/**
+			 * @brief Returns an attribute of the current START_ELEMENT token.
+			 *        A decoded value is only valid until the next call to getAttribute().
+			 *
+			 * @param[in] name The attribute name.
+			 * @param[out] value The attribute value.
+			 *
+			 * @return True if the attribute exists.
+			 */
+			bool getAttribute(std::string_view name, std::string_view& value) const;
+
+			/**
+			 * @brief Returns the depth of the current element.
+			 *
+			 * @return The depth, where the root element is at depth 1.
+			 */
+			size_t getDepth() const;
+
+			/**
+			 * @brief Returns the read position.
+			 *
+			 * @return The offset in bytes from the start of the buffer.
+			 */
+			size_t getOffset() const;
+
+		protected:
+			/**
+			 * @brief Reads a start or end tag. The position must be at the '<'.
+			 *
+			 * @return The token.
+			 */
+			Token readTag();
+
+			/**
+			 * @brief Reads the attributes of a start tag up to and including the closing '>'.
+			 */
+			void readAttributes();
+
+			/**
+			 * @brief Reads a name (element or attribute).
+			 *
+			 * @return The name.
+			 */
+			std::string_view readName();
+
+			/**
+			 * @brief Skips past the next occurrence of a string.
+			 *
+			 * @param[in] terminator The string to skip past.
+			 */
+			void skipPast(std::string_view terminator);
+
+			/**
+			 * @brief Skips whitespace.
+			 */
+			void skipWhitespace();
+
+			/**
+			 * @brief Normalizes text data. Returns a view into the buffer if the text does not need to be changed.
+			 *
+			 * @param[in] raw The raw text.
+			 *
+			 * @return The normalized text.
+			 */
+			std::string_view normalizeText(std::string_view raw);
+
+			/**
+			 * @brief Decodes the entities in an attribute value.
+			 *
+			 * @param[in] raw The raw value.
+			 * @param[out] decoded Buffer to decode into if needed.
+			 *
+			 * @return The decoded value.
+			 */
+			static std::string_view decodeValue(std::string_view raw, std::string& decoded);
+
+			/**
+			 * @brief Decodes a single entity and appends it.
+			 *
+			 * @param[in] raw The text starting at the '&'.
+			 * @param[out] out The string to append to.
+			 *
+			 * @return The number of characters consumed.
+			 */
+			static size_t decodeEntity(std::string_view raw, std::string& out);
+
+			/**
+			 * @brief Throws a parse error.
+			 *
+			 * @param[in] msg The error message.
+			 */
+			[[noreturn]] void error(const std::string& msg) const;
+
+			/** Variables */
+			const std::string_view _buffer;
+			size_t _pos = 0;
+			size_t _depth = 0;
+			bool _pendingEnd = false;
+
+			std::string_view _name;
+			std::string_view _text;
+			std::string _textBuffer;
+
+			std::vector< std::pair<std::string_view, std::string_view> > _attributes;
+			mutable std::string _attributeBuffer;
+		};
+	}
+}
\ No newline at end of file
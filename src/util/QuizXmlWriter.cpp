@@ -0,0 +1,150 @@
+#include "QuizXmlWriter.hpp"
+
+#include <stdexcept>
+
+#if defined(_WIN32)
+#include <io.h>
+#else
+#include <unistd.h>
+#endif
+
+
+namespace {
+	/** Size of the write buffer of the file */
+	constexpr size_t BUFFER_SIZE = 64 * 1024;
+}
+
+
+MusicQuiz::util::QuizXmlWriter::QuizXmlWriter(const std::string& path) :
+	_path(path)
+{
+	_file = std::fopen(path.c_str(), "wb");
+	if ( _file == nullptr ) {
+		throw std::runtime_error("Failed to create '" + path + "'.");
+	}
+	std::setvbuf(_file, nullptr, _IOFBF, BUFFER_SIZE);
+
+	write("<?xml version=\"1.0\" encoding=\"utf-8\"?>\n");
+}
+
+MusicQuiz::util::QuizXmlWriter::~QuizXmlWriter()
+{
+	if ( _file != nullptr ) {
+		std::fclose(_file);
+	}
+}
+
+void MusicQuiz::util::QuizXmlWriter::startElement(const std::string& name, const Attributes& attributes)
+{
+	writeIndent();
+	writeStartTag(name, attributes);
+	write(">\n");
+	_elements.push_back(name);
+}
+
+void MusicQuiz::util::QuizXmlWriter::endElement()
+{
+	if ( _elements.empty() ) {
+		throw std::runtime_error("No element to end in '" + _path + "'.");
+	}
+
+	const std::string name = _elements.back();
+	_elements.pop_back();
+	writeIndent();
+	write("</" + name + ">\n");
+}
+
+void MusicQuiz::util::QuizXmlWriter::writeElement(const std::string& name, const std::string& text, const Attributes& attributes)
+{
+	writeIndent();
+	writeStartTag(name, attributes);
+	if ( text.empty() ) {
+		write("/>\n");
+		return;
+	}
+
+	write(">");
+	writeEscaped(text);
+	write("</" + name + ">\n");
+}
+
+void MusicQuiz::util::QuizXmlWriter::writeComment(const std::string& text)
+{
+	writeIndent();
+	write("<!--" + text + "-->\n");
+}
+
+void MusicQuiz::util::QuizXmlWriter::close()
+{
+	while ( !_elements.empty() ) {
+		endElement();
+	}
+
+	/** Flush to disk, so the file is complete before it replaces the quiz */
+	bool failed = std::fflush(_file) != 0 || std::ferror(_file) != 0;
+#if defined(_WIN32)
+	failed = failed || _commit(_fileno(_file)) != 0;
+#else
+	failed = failed || fsync(fileno(_file)) != 0;
+#endif
+	failed = std::fclose(_file) != 0 || failed;
+	_file = nullptr;
+
+	if ( failed ) {
+		throw std::runtime_error("Failed to write '" + _path + "'.");
+	}
+}
+
+void MusicQuiz::util::QuizXmlWriter::writeStartTag(const std::string& name, const Attributes& attributes)
+{
+	write("<" + name);
+	for ( size_t i = 0; i < attributes.size(); ++i ) {
+		write(" " + attributes[i].first + "=\"");
+		writeEscaped(attributes[i].second);
+		write("\"");
+	}
+}
+
+void MusicQuiz::util::QuizXmlWriter::writeIndent()
+{
+	for ( size_t i = 0; i < _elements.size(); ++i ) {
+		std::fputc('\t', _file);
+	}
+}
+
+void MusicQuiz::util::QuizXmlWriter::writeEscaped(const std::string& text)
+{
+	size_t start = 0;
+	for ( size_t i = 0; i < text.size(); ++i ) {
+		const char* entity = nullptr;
+		switch ( text[i] ) {
+		case '&':
+			entity = "&amp;";
+			break;
+		case '<':
+			entity = "&lt;";
+			break;
+		case '>':
+			entity = "&gt;";
+			break;
+		case '"':
+			entity = "&quot;";
+			break;
+		case '\'':
+			entity = "&apos;";
+			break;
+		default:
+			continue;
+		}
+
+		std::fwrite(text.data() + start, 1, i - start, _file);
+		std::fputs(entity, _file);
+		start = i + 1;
+	}
+	std::fwrite(text.data() + start, 1, text.size() - start, _file);
+}
+
+void MusicQuiz::util::QuizXmlWriter::write(const std::string& text)
+{
+	std::fwrite(text.data(), 1, text.size(), _file);
+}
\ No newline at end of file
@@ -0,0 +1,108 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include <cstdio>
+#include <utility>
+
+
+namespace MusicQuiz {
+	namespace util {
+		/**
+		 * @brief Streaming writer for the XML subset used by the quiz files.
+		 *
+		 * Elements are written to the file as they are added, so the memory used does not grow with the size of the quiz.
+		 * The output is indented with tabs in the same layout as boost::property_tree's write_xml.
+		 */
+		class QuizXmlWriter
+		{
+		public:
+			typedef std::vector< std::pair<std::string, std::string> > Attributes;
+
+			/**
+			 * @brief Constructor. Creates the file and writes the XML declaration.
+			 *
+			 * @param[in] path The file to write. Replaced if it exists.
+			 */
+			explicit QuizXmlWriter(const std::string& path);
+
+			/**
+			 * @brief Destructor. Closes the file if close() was not called, the file is then incomplete.
+			 */
+			virtual ~QuizXmlWriter();
+
+			/**
+			 * @brief Deleted the copy and assignment constructor.
+			 */
+			QuizXmlWriter(const QuizXmlWriter&) = delete;
+			QuizXmlWriter& operator=(const QuizXmlWriter&) = delete;
+
+			/**
+			 * @brief Starts an element with children.
+			 *
+			 * @param[in] name The element name.
+			 * @param[in] attributes The attributes of the element.
+			 */
+			void startElement(const std::string& name, const Attributes& attributes = Attributes());
+
+			/**
+			 * @brief Ends the last started element.
+			 */
+			void endElement();
+
+			/**
+			 * @brief Writes an element without children.
+			 *
+			 * @param[in] name The element name.
+			 * @param[in] text The text of the element. The element is self-closing if it is empty.
+			 * @param[in] attributes The attributes of the element.
+			 */
+			void writeElement(const std::string& name, const std::string& text, const Attributes& attributes = Attributes());
+
+			/**
+			 * @brief Writes a comment.
+			 *
+			 * @param[in] text The comment.
+			 */
+			void writeComment(const std::string& text);
+
+			/**
+			 * @brief Ends the open elements, then flushes the file to disk and closes it. Throws if any write failed.
+			 */
+			void close();
+
+		protected:
+			/**
+			 * @brief Writes the start tag of an element, without the closing '>'.
+			 *
+			 * @param[in] name The element name.
+			 * @param[in] attributes The attributes of the element.
+			 */
+			void writeStartTag(const std::string& name, const Attributes& attributes);
+
+			/**
+			 * @brief Writes the indentation of the current depth.
+			 */
+			void writeIndent();
+
+			/**
+			 * @brief Writes text, replacing the characters that have to be escaped.
+			 *
+			 * @param[in] text The text.
+			 */
+			void writeEscaped(const std::string& text);
+
+			/**
+			 * @brief Writes a string as is.
+			 *
+			 * @param[in] text The string.
+			 */
+			void write(const std::string& text);
+
+			/** Variables */
+			const std::string _path;
+			std::FILE* _file = nullptr;
+			std::vector<std::string> _elements;
+		};
+	}
+}
\ No newline at end of file
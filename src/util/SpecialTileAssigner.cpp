@@ -0,0 +1,111 @@
+#include "SpecialTileAssigner.hpp"
+
+#include <limits>
+#include <random>
+#include <utility>
+#include <algorithm>
+
+
+namespace {
+	/**
+	 * @brief Draws a number in [0, bound). Unlike the standard distributions the result is the same with every standard library,
+	 *        so a seed reproduces the same board on every platform.
+	 *
+	 * @param[in] engine The random engine.
+	 * @param[in] bound The upper bound, must be larger than 0.
+	 *
+	 * @return The number.
+	 */
+	std::uint64_t draw(std::mt19937_64& engine, const std::uint64_t bound)
+	{
+		/** Reject the values that would make the lower numbers more likely */
+		const std::uint64_t limit = std::numeric_limits<std::uint64_t>::max() - std::numeric_limits<std::uint64_t>::max() % bound;
+		std::uint64_t value = engine();
+		while ( value >= limit ) {
+			value = engine();
+		}
+		return value % bound;
+	}
+}
+
+
+MusicQuiz::util::SpecialTileAssigner::Assignment MusicQuiz::util::SpecialTileAssigner::assign(const std::vector<size_t>& categorySizes, const size_t numberOfDoubles,
+	const size_t numberOfTriples, const Constraints& constraints, const std::uint64_t seed)
+{
+	Assignment assignment;
+	assignment.seed = seed;
+
+	/** Category and row of each entry */
+	std::vector<size_t> categories, rows;
+	size_t numberOfRows = 0;
+	for ( size_t i = 0; i < categorySizes.size(); ++i ) {
+		for ( size_t j = 0; j < categorySizes[i]; ++j ) {
+			categories.push_back(i);
+			rows.push_back(j);
+		}
+		numberOfRows = std::max(numberOfRows, categorySizes[i]);
+	}
+	const size_t numberOfEntries = categories.size();
+	assignment.tiles.assign(numberOfEntries, Tile::NONE);
+
+	/** Halves, only meaningful with more than one category */
+	const size_t halfSize = (categorySizes.size() + 1) / 2;
+	const bool useHalves = constraints.bothHalves && categorySizes.size() > 1;
+	bool halfCovered[2] = { false, false };
+
+	/** Used categories and rows */
+	std::vector<bool> categoryUsed(categorySizes.size(), false);
+	std::vector<bool> rowUsed(numberOfRows, false);
+
+	/** Partial Fisher-Yates shuffle, a drawn entry that breaks a constraint is skipped */
+	std::mt19937_64 engine(seed);
+	std::vector<size_t> indices(numberOfEntries);
+	for ( size_t i = 0; i < numberOfEntries; ++i ) {
+		indices[i] = i;
+	}
+
+	const size_t numberOfTiles = numberOfDoubles + numberOfTriples;
+	size_t placed = 0;
+	for ( size_t i = 0; i < numberOfEntries && placed < numberOfTiles; ++i ) {
+		std::swap(indices[i], indices[i + static_cast<size_t>(draw(engine, numberOfEntries - i))]);
+		const size_t entry = indices[i];
+		const size_t category = categories[entry];
+		const size_t row = rows[entry];
+
+		if ( constraints.onePerCategory && categoryUsed[category] ) {
+			continue;
+		}
+		if ( constraints.onePerRow && rowUsed[row] ) {
+			continue;
+		}
+
+		/** Keep the last tiles for the halves that are still empty */
+		const size_t half = category < halfSize ? 0 : 1;
+		if ( useHalves ) {
+			const size_t uncovered = (halfCovered[0] ? 0 : 1) + (halfCovered[1] ? 0 : 1);
+			if ( halfCovered[half] && numberOfTiles - placed <= uncovered ) {
+				continue;
+			}
+			halfCovered[half] = true;
+		}
+
+		categoryUsed[category] = true;
+		rowUsed[row] = true;
+		assignment.tiles[entry] = placed < numberOfDoubles ? Tile::DOUBLE : Tile::TRIPLE;
+		++placed;
+	}
+
+	assignment.numberOfDoubles = std::min(placed, numberOfDoubles);
+	assignment.numberOfTriples = placed - assignment.numberOfDoubles;
+	return assignment;
+}
+
+std::uint64_t MusicQuiz::util::SpecialTileAssigner::createSeed()
+{
+	std::random_device device;
+	std::uint64_t seed = 0;
+	while ( seed == 0 ) {
+		seed = (static_cast<std::uint64_t>(device()) << 32) | device();
+	}
+	return seed;
+}
\ No newline at end of file
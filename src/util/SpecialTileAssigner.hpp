@@ -0,0 +1,74 @@
+#pragma once
+
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+
+
+namespace MusicQuiz {
+	namespace util {
+		/**
+		 * @brief Places the daily double and daily triple tiles on a quiz board.
+		 *
+		 * The tiles are drawn with a partial Fisher-Yates shuffle from a seeded random engine, so a board is
+		 * reproduced exactly from its seed. The entries are numbered category by category, row by row.
+		 */
+		class SpecialTileAssigner
+		{
+		public:
+			enum class Tile : std::uint8_t
+			{
+				NONE, DOUBLE, TRIPLE
+			};
+
+			struct Constraints
+			{
+				/** At most one special tile per category */
+				bool onePerCategory = false;
+
+				/** At most one special tile per row */
+				bool onePerRow = false;
+
+				/** At least one special tile in the left and in the right half of the categories */
+				bool bothHalves = false;
+			};
+
+			struct Assignment
+			{
+				std::uint64_t seed = 0;
+
+				/** Tile per entry */
+				std::vector<Tile> tiles;
+
+				size_t numberOfDoubles = 0;
+				size_t numberOfTriples = 0;
+			};
+
+			/**
+			 * @brief Deleted constructor and destructor.
+			 */
+			SpecialTileAssigner() = delete;
+			~SpecialTileAssigner() = delete;
+
+			/**
+			 * @brief Places the special tiles. If the constraints do not leave room for all tiles, as many as possible are placed.
+			 *
+			 * @param[in] categorySizes The number of entries in each category.
+			 * @param[in] numberOfDoubles The number of daily double tiles.
+			 * @param[in] numberOfTriples The number of daily triple tiles.
+			 * @param[in] constraints The placement constraints.
+			 * @param[in] seed The seed of the random engine.
+			 *
+			 * @return The tile of each entry.
+			 */
+			static Assignment assign(const std::vector<size_t>& categorySizes, size_t numberOfDoubles, size_t numberOfTriples, const Constraints& constraints, std::uint64_t seed);
+
+			/**
+			 * @brief Creates a seed from the random device. Never returns 0.
+			 *
+			 * @return The seed.
+			 */
+			static std::uint64_t createSeed();
+		};
+	}
+}
\ No newline at end of file
@@ -0,0 +1,46 @@
+#include "StringArena.hpp"
+
+#include <cstring>
+
+
+MusicQuiz::util::StringArena::StringArena(const size_t blockSize) :
+	_blockSize(blockSize)
+{
+}
+
+std::string_view MusicQuiz::util::StringArena::store(const std::string_view str)
+{
+	if ( str.empty() ) {
+		return std::string_view();
+	}
+
+	char* data = allocate(str.size());
+	std::memcpy(data, str.data(), str.size());
+	return std::string_view(data, str.size());
+}
+
+char* MusicQuiz::util::StringArena::allocate(const size_t size)
+{
+	_size += size;
+
+	/** Large allocations get a block of their own, so the current block can still be filled */
+	if ( size > _blockSize / 4 ) {
+		_largeBlocks.push_back(std::unique_ptr<char[]>(new char[size]));
+		return _largeBlocks.back().get();
+	}
+
+	/** Start a new block if the current one is full */
+	if ( _blocks.empty() || _blockUsed + size > _blockSize ) {
+		_blocks.push_back(std::unique_ptr<char[]>(new char[_blockSize]));
+		_blockUsed = 0;
+	}
+
+	char* data = _blocks.back().get() + _blockUsed;
+	_blockUsed += size;
+	return data;
+}
+
+size_t MusicQuiz::util::StringArena::getSize() const
+{
+	return _size;
+}
\ No newline at end of file
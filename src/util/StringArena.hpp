@@ -0,0 +1,72 @@
+#pragma once
+
+#include <memory>
+#include <vector>
+#include <cstddef>
+#include <string_view>
+
+
+namespace MusicQuiz {
+	namespace util {
+		/**
+		 * @brief Append-only storage for strings.
+		 *
+		 * Strings are copied into large blocks, so storing many small strings costs a few allocations in total.
+		 * The returned views stay valid for the lifetime of the arena.
+		 */
+		class StringArena
+		{
+		public:
+			/**
+			 * @brief Constructor
+			 *
+			 * @param[in] blockSize The size of the blocks allocated by the arena.
+			 */
+			explicit StringArena(size_t blockSize = 64 * 1024);
+
+			/**
+			 * @brief Default destructor
+			 */
+			virtual ~StringArena() = default;
+
+			/**
+			 * @brief Deleted the copy and assignment constructor.
+			 */
+			StringArena(const StringArena&) = delete;
+			StringArena& operator=(const StringArena&) = delete;
+
+			/**
+			 * @brief Copies a string into the arena.
+			 *
+			 * @param[in] str The string to store.
+			 *
+			 * @return A view of the stored string.
+			 */
+			std::string_view store(std::string_view str);
+
+			/**
+			 * @brief Allocates uninitialized memory in the arena.
+			 *
+			 * @param[in] size The number of bytes to allocate.
+			 *
+			 * @return Pointer to the allocated memory.
+			 */
+			char* allocate(size_t size);
+
+			/**
+			 * @brief Returns the number of bytes stored in the arena.
+			 *
+			 * @return The number of bytes.
+			 */
+			size_t getSize() const;
+
+		protected:
+			/** Variables */
+			const size_t _blockSize;
+			size_t _blockUsed = 0;
+			size_t _size = 0;
+			std::vector< std::unique_ptr<char[]> > _blocks;
+			std::vector< std::unique_ptr<char[]> > _largeBlocks;
+		};
+	}
+}
\ No newline at end of file
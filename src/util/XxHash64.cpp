@@ -0,0 +1,152 @@
+#include "XxHash64.hpp"
+
+#include <cstring>
+#include <algorithm>
+
+
+namespace {
+	constexpr std::uint64_t PRIME_1 = 0x9E3779B185EBCA87ULL;
+	constexpr std::uint64_t PRIME_2 = 0xC2B2AE3D27D4EB4FULL;
+	constexpr std::uint64_t PRIME_3 = 0x165667B19E3779F9ULL;
+	constexpr std::uint64_t PRIME_4 = 0x85EBCA77C2B2AE63ULL;
+	constexpr std::uint64_t PRIME_5 = 0x27D4EB2F165667C5ULL;
+
+	inline std::uint64_t rotateLeft(const std::uint64_t value, const int bits)
+	{
+		return (value << bits) | (value >> (64 - bits));
+	}
+
+	/** The input is read as little endian, which matches the hosts the quiz runs on */
+	inline std::uint64_t read64(const unsigned char* data)
+	{
+		std::uint64_t value;
+		std::memcpy(&value, data, sizeof(value));
+		return value;
+	}
+
+	inline std::uint32_t read32(const unsigned char* data)
+	{
+		std::uint32_t value;
+		std::memcpy(&value, data, sizeof(value));
+		return value;
+	}
+
+	inline std::uint64_t round(std::uint64_t accumulator, const std::uint64_t input)
+	{
+		accumulator += input * PRIME_2;
+		accumulator = rotateLeft(accumulator, 31);
+		return accumulator * PRIME_1;
+	}
+
+	inline std::uint64_t mergeRound(std::uint64_t accumulator, const std::uint64_t value)
+	{
+		accumulator ^= round(0, value);
+		return accumulator * PRIME_1 + PRIME_4;
+	}
+}
+
+
+MusicQuiz::util::XxHash64::XxHash64(const std::uint64_t seed) :
+	_seed(seed)
+{
+	_accumulators[0] = seed + PRIME_1 + PRIME_2;
+	_accumulators[1] = seed + PRIME_2;
+	_accumulators[2] = seed;
+	_accumulators[3] = seed - PRIME_1;
+}
+
+void MusicQuiz::util::XxHash64::update(const void* data, size_t size)
+{
+	const unsigned char* input = static_cast<const unsigned char*>(data);
+	_totalSize += size;
+
+	/** Fill the buffered stripe first */
+	if ( _bufferSize > 0 ) {
+		const size_t count = std::min(size, sizeof(_buffer) - _bufferSize);
+		std::memcpy(_buffer + _bufferSize, input, count);
+		_bufferSize += count;
+		input += count;
+		size -= count;
+
+		if ( _bufferSize < sizeof(_buffer) ) {
+			return;
+		}
+
+		for ( size_t i = 0; i < 4; ++i ) {
+			_accumulators[i] = round(_accumulators[i], read64(_buffer + 8 * i));
+		}
+		_bufferSize = 0;
+	}
+
+	/** Whole stripes */
+	std::uint64_t v1 = _accumulators[0], v2 = _accumulators[1], v3 = _accumulators[2], v4 = _accumulators[3];
+	while ( size >= 32 ) {
+		v1 = round(v1, read64(input));
+		v2 = round(v2, read64(input + 8));
+		v3 = round(v3, read64(input + 16));
+		v4 = round(v4, read64(input + 24));
+		input += 32;
+		size -= 32;
+	}
+	_accumulators[0] = v1;
+	_accumulators[1] = v2;
+	_accumulators[2] = v3;
+	_accumulators[3] = v4;
+
+	/** Keep the rest for the next call */
+	std::memcpy(_buffer, input, size);
+	_bufferSize = size;
+}
+
+std::uint64_t MusicQuiz::util::XxHash64::digest() const
+{
+	std::uint64_t hash;
+	if ( _totalSize >= 32 ) {
+		hash = rotateLeft(_accumulators[0], 1) + rotateLeft(_accumulators[1], 7) + rotateLeft(_accumulators[2], 12) + rotateLeft(_accumulators[3], 18);
+		for ( size_t i = 0; i < 4; ++i ) {
+			hash = mergeRound(hash, _accumulators[i]);
+		}
+	} else {
+		hash = _seed + PRIME_5;
+	}
+	hash += _totalSize;
+
+	/** Remaining bytes */
+	const unsigned char* input = _buffer;
+	size_t size = _bufferSize;
+	while ( size >= 8 ) {
+		hash ^= round(0, read64(input));
+		hash = rotateLeft(hash, 27) * PRIME_1 + PRIME_4;
+		input += 8;
+		size -= 8;
+	}
+
+	if ( size >= 4 ) {
+		hash ^= static_cast<std::uint64_t>(read32(input)) * PRIME_1;
+		hash = rotateLeft(hash, 23) * PRIME_2 + PRIME_3;
+		input += 4;
+		size -= 4;
+	}
+
+	while ( size > 0 ) {
+		hash ^= static_cast<std::uint64_t>(*input) * PRIME_5;
+		hash = rotateLeft(hash, 11) * PRIME_1;
+		++input;
+		--size;
+	}
+
+	/** Avalanche */
+	hash ^= hash >> 33;
+	hash *= PRIME_2;
+	hash ^= hash >> 29;
+	hash *= PRIME_3;
+	hash ^= hash >> 32;
+	return hash;
+}
+
+std::uint64_t MusicQuiz::util::XxHash64::hash(const void* data, const size_t size, const std::uint64_t seed)
+{
+	XxHash64 state(seed);
+	state.update(data, size);
+	return state.digest();
+}
\ No newline at end of file
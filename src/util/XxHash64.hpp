@@ -0,0 +1,67 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+
+namespace MusicQuiz {
+	namespace util {
+		/**
+		 * @brief The 64-bit xxHash of a stream of bytes.
+		 *
+		 * Data can be added in pieces of any size, the result is the same as hashing all data at once.
+		 * The hash is fast enough that hashing a media file costs about as much as reading it.
+		 */
+		class XxHash64
+		{
+		public:
+			/**
+			 * @brief Constructor
+			 *
+			 * @param[in] seed The seed of the hash.
+			 */
+			explicit XxHash64(std::uint64_t seed = 0);
+
+			/**
+			 * @brief Default destructor
+			 */
+			virtual ~XxHash64() = default;
+
+			/**
+			 * @brief Adds data to the hash.
+			 *
+			 * @param[in] data The data.
+			 * @param[in] size The number of bytes.
+			 */
+			void update(const void* data, size_t size);
+
+			/**
+			 * @brief Returns the hash of the data added so far.
+			 *
+			 * @return The hash.
+			 */
+			std::uint64_t digest() const;
+
+			/**
+			 * @brief Hashes a block of data.
+			 *
+			 * @param[in] data The data.
+			 * @param[in] size The number of bytes.
+			 * @param[in] seed The seed of the hash.
+			 *
+			 * @return The hash.
+			 */
+			static std::uint64_t hash(const void* data, size_t size, std::uint64_t seed = 0);
+
+		protected:
+			/** Variables */
+			const std::uint64_t _seed;
+			std::uint64_t _accumulators[4];
+			std::uint64_t _totalSize = 0;
+
+			/** Bytes that do not fill a stripe yet */
+			unsigned char _buffer[32];
+			size_t _bufferSize = 0;
+		};
+	}
+}
\ No newline at end of file